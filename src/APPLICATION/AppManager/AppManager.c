@@ -25,6 +25,7 @@
 /* INCLUDE FILES                                                                                                      */
 /**********************************************************************************************************************/
 
+#include <string.h>
 #include "AppManager.h"
 #include "GPIO.h"
 #include "MCP9700.h"
@@ -32,6 +33,16 @@
 #include "TIMER.h"
 #include "LCD.h"
 #include "SERP.h"
+#include "I2CM.h"
+#include "Filter.h"
+#include "History.h"
+#include "Aggregate.h"
+#include "Alarm.h"
+#include "Sampling.h"
+#include "Report.h"
+#include "NVLog.h"
+#include "Telemetry.h"
+#include "Download.h"
 #include "Common.h"
 
 /**********************************************************************************************************************/
@@ -40,6 +51,38 @@
 
 #define TIMER_PERIOD_IN_MS 250
 
+// Nombre de records de trace I2C par message SERP (1 octet de compteur + records <= SERP_MAX_MSG_DATA_SIZE)
+#define I2C_TRACE_RECORDS_PER_MSG ((SERP_MAX_MSG_DATA_SIZE - 1) / I2CM_TRACE_RECORD_SIZE)
+
+// Historique de temperature affiche en barres sur les lignes 3 et 4 de l'ecran
+#define TEMPERATURE_GRAPH_ROW 3
+#define TEMPERATURE_GRAPH_HEIGHT 2
+#define TEMPERATURE_GRAPH_MIN_DEG_C 10
+#define TEMPERATURE_GRAPH_MAX_DEG_C 40
+
+// Nombre de decimales affichees (la mesure est en 0.01 degre)
+#define TEMPERATURE_DISPLAY_DECIMALS 2
+
+// Nombre de buckets de l'historique agrege par message SERP (3 octets d'entete + records <= SERP_MAX_MSG_DATA_SIZE)
+#define HISTORY_QUERY_RECORDS_PER_MSG ((SERP_MAX_MSG_DATA_SIZE - 3) / AGG_RECORD_SIZE)
+
+// Statistiques de la fenetre affichees sur la ligne 2 (la mesure est en 0.01 degre) : min et max en degres, moyenne et
+// ecart type avec 1 decimale
+#define STATISTICS_DISPLAY_ROW 2
+#define STATISTICS_DISPLAY_BOUND_DECIMALS 0
+#define STATISTICS_DISPLAY_DECIMALS 1
+
+// Longueur maximale de la ligne des statistiques sur la plage du capteur (-40 a 125 degres, ecart type <= 82.5) :
+// "-40<-40.0<125 s82.5"
+#define STATISTICS_DISPLAY_MAX_LENGTH 19
+
+#if (STATISTICS_DISPLAY_MAX_LENGTH > LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS)
+#error "[APPM] Error: The statistics row does not fit in LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS"
+#endif
+
+// Variation de temperature (en dixiemes de degre) qui reveille l'application en mode detection de changement
+#define TEMPERATURE_CHANGE_DELTA_TENTH_DEG_C 5
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -54,7 +97,8 @@ typedef enum
 {
     APPM_EVENT_NONE,
     APPM_EVENT_TIMER,
-    APPM_EVENT_BUTTON_PRESSED
+    APPM_EVENT_BUTTON_PRESSED,
+    APPM_EVENT_ALARM
 } AppManager_event;
 
 /**********************************************************************************************************************/
@@ -63,6 +107,40 @@ typedef enum
 
 static AppManager_state currentState = APPM_STATE_SUSPENDED;
 static AppManager_event pendingEvent = APPM_EVENT_NONE;
+static volatile bool i2cTraceRequested = false;
+static volatile bool temperatureChanged = false;
+static volatile bool filterSettingsRequested = false;
+static volatile uint16_t filterSettingsLength = 0;
+static uint8_t filterSettingsRecord[FLT_SETTINGS_RECORD_SIZE];
+static volatile bool historyStatsRequested = false;
+static volatile uint16_t historyStatsLength = 0;
+static volatile uint8_t historyWindowLength = 0;
+static volatile bool historyQueryRequested = false;
+static volatile uint8_t historyQueryLevel = 0;
+static volatile uint8_t historyQueryAge = 0;
+static volatile bool hostMessageReceived = false;
+static volatile bool telemetryLinkRequested = false;
+static volatile uint16_t telemetryLinkLength = 0;
+static volatile uint32_t telemetryAckIndex = 0;
+static volatile bool alarmStatusRequested = false;
+static volatile bool alarmSettingsRequested = false;
+static volatile uint16_t alarmSettingsLength = 0;
+static uint8_t alarmSettingsRecord[ALM_SETTINGS_RECORD_SIZE];
+static bool alarmEventPending = false;
+static volatile bool samplingSettingsRequested = false;
+static volatile uint16_t samplingSettingsLength = 0;
+static uint8_t samplingSettingsRecord[SMP_SETTINGS_RECORD_SIZE];
+static volatile bool reportSettingsRequested = false;
+static volatile uint16_t reportSettingsLength = 0;
+static uint8_t reportSettingsRecord[RPT_SETTINGS_RECORD_SIZE];
+static volatile bool reportStatusRequested = false;
+static volatile bool logReadRequested = false;
+static volatile uint16_t logReadLength = 0;
+static uint8_t logReadRequest[DWL_REQUEST_SIZE];
+static LCD_tstrTrendGraph temperatureGraph;
+
+// Symbole degre (glyphe CGRAM)
+static const uint8_t degreeGlyph[LCD_GLYPH_HEIGHT] = { 0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00, 0x00 };
 
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTION PROTOTYPES                                                                                        */
@@ -70,8 +148,35 @@ static AppManager_event pendingEvent = APPM_EVENT_NONE;
 
 static bool AppManager_handleInterrupt(ISR_tenuPeripheral peripheralId);
 static void AppManager_timerCallback(void);
-static void AppManager_handleEvent(void);
+static void AppManager_handleEvent(AppManager_event event);
 static void AppManager_displayWelcomeMessage(void);
+static void AppManager_enterRunning(void);
+static void AppManager_sendI2cTrace(void);
+static void AppManager_handleSensorSample(const MCP9700_tenuSensorId sensorId, const int16_t temperature);
+static void AppManager_sendSensorSample(const MCP9700_tenuSensorId sensorId, const int16_t temperature);
+static void AppManager_displayTemperature(const int16_t temperature);
+static void AppManager_sendTemperature(const int16_t temperature);
+static void AppManager_applyFilterSettings(void);
+static void AppManager_displayStatistics(void);
+static int32_t AppManager_roundTemperature(const int32_t temperature, const uint8_t decimals);
+static uint8_t AppManager_appendDecimal(char *row, uint8_t length, const int32_t temperature, const uint8_t decimals);
+static uint8_t AppManager_appendText(char *row, uint8_t length, const char *text);
+static void AppManager_sendHistoryStatistics(void);
+static void AppManager_sendHistoryBuckets(void);
+static void AppManager_sendTelemetryStatus(void);
+static void AppManager_startLogDownload(void);
+static void AppManager_handleAlarmChange(const uint8_t changedMask);
+static void AppManager_sendAlarmStatus(void);
+static void AppManager_applyAlarmSettings(void);
+static void AppManager_signalAlarms(void);
+static void AppManager_applySamplePeriod(const uint16_t periodMs);
+static void AppManager_applySamplingSettings(void);
+static void AppManager_applyReportSettings(void);
+static void AppManager_sendReportStatus(void);
+
+#if (ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+static void AppManager_temperatureChangedCallback(const uint16_t adcValue);
+#endif
 
 static void AppManager_handleReceivedMessage(SERP_tenuMsgId msgId, const uint8_t *data, uint16_t dataLength);
 
@@ -82,11 +187,11 @@ static void AppManager_handleReceivedMessage(SERP_tenuMsgId msgId, const uint8_t
 static void AppManager_timerCallback(void)
 {
     pendingEvent = APPM_EVENT_TIMER;
-    CMN_systemPrintf("Timer triggered!\r\n");
+    CMN_systemLogText("Timer triggered!\r\n");
 
     if (SERP_enuSendMessage(SERP_MSG_ID_LIVE_SIGN, NULL, 0) != SERP_STATUS_OK)
     {
-        CMN_systemPrintf("Error: Unable to send message\r\n");
+        CMN_systemLogText("Error: Unable to send message\r\n");
     }
 }
 
@@ -95,7 +200,7 @@ static bool AppManager_handleInterrupt(ISR_tenuPeripheral peripheralId)
     if (peripheralId == ISR_ePERIPHERAL_INPUT_GPIO)
     {
         pendingEvent = APPM_EVENT_BUTTON_PRESSED;
-        CMN_systemPrintf("Button pressed!\r\n");
+        CMN_systemLogText("Button pressed!\r\n");
         return true;
     }
     return false;
@@ -109,38 +214,440 @@ static void AppManager_displayWelcomeMessage(void)
     LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, "Welcome!");
 }
 
-static void AppManager_handleEvent(void)
+static void AppManager_enterRunning(void)
+{
+    currentState = APPM_STATE_RUNNING;
+    CMN_systemLogText("State changed to RUNNING\r\n");
+
+    // Premiere mesure sans attendre un changement de temperature, affichee et envoyee quelle que soit sa variation
+    // (l'ecran d'accueil est remplace meme si la valeur est dans la bande morte)
+    temperatureChanged = true;
+    RPT_vidForceReport(RPT_eCHANNEL_DISPLAY);
+    RPT_vidForceReport(RPT_eCHANNEL_SERP);
+
+    LCD_enuClearAll(LCD_eDEVICE_ID_DISPLAY);
+    LCD_enuSetCursor(LCD_eDEVICE_ID_DISPLAY, 1, 1);
+    LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, "State: RUNNING");
+}
+
+static void AppManager_sendI2cTrace(void)
+{
+#if (I2CM_CONFIG_ENABLE_TRACE == true)
+    uint8_t message[1 + (I2C_TRACE_RECORDS_PER_MSG * I2CM_TRACE_RECORD_SIZE)];
+    uint16_t size;
+
+    // Vidage de la trace par paquets, le dernier message peut etre vide
+    do
+    {
+        size = I2CM_u16ExportTrace(&message[1], sizeof(message) - 1);
+        message[0] = (uint8_t)(size / I2CM_TRACE_RECORD_SIZE);
+
+        if (SERP_enuSendMessage(SERP_MSG_ID_I2C_TRACE, message, size + 1) != SERP_STATUS_OK)
+        {
+            CMN_systemLogText("Error: Unable to send I2C trace\r\n");
+            return;
+        }
+    } while (message[0] == I2C_TRACE_RECORDS_PER_MSG);
+
+    size = I2CM_u16ExportBusUsage(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_I2C_BUS_USAGE, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send I2C bus usage\r\n");
+    }
+#endif
+}
+
+static void AppManager_handleSensorSample(const MCP9700_tenuSensorId sensorId, const int16_t temperature)
+{
+    // Le capteur principal alimente le filtre, la valeur filtree est transmise aux abonnes (afficheur, historique,
+    // journal et IHM)
+    if (sensorId == MCP9700_CONFIG_PRIMARY_SENSOR_ID)
+    {
+        // L'ecart de la mesure brute a la tendance signale un transitoire avant le retard du filtre
+        SMP_vidPushRawSample(temperature);
+        (void)FLT_s16PushSample(temperature);
+    }
+
+    // Chaque mesure brute est envoyee a l'IHM avec l'identifiant de son capteur
+    AppManager_sendSensorSample(sensorId, temperature);
+}
+
+static void AppManager_sendSensorSample(const MCP9700_tenuSensorId sensorId, const int16_t temperature)
+{
+    // [capteur][temperature sur 2 octets, little-endian, en 0.01 degre]
+    const uint8_t sampleMessage[3] = { (uint8_t)sensorId, (uint8_t)temperature, (uint8_t)((uint16_t)temperature >> 8) };
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_SENSOR_SAMPLE, sampleMessage, sizeof(sampleMessage)) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send sensor sample to IHM\r\n");
+    }
+}
+
+static void AppManager_displayTemperature(const int16_t temperature)
+{
+    // Pas de rafraichissement du texte dans la bande morte, sauf a la fin du silence maximal
+    if (RPT_bIsReportNeeded(RPT_eCHANNEL_DISPLAY, temperature))
+    {
+        // Seule la ligne de texte est effacee, le graphe des lignes 3-4 reste affiche
+        LCD_enuClearRow(LCD_eDEVICE_ID_DISPLAY, 1);
+        LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, "Temp: ");
+        LCD_enuWriteDecimal(LCD_eDEVICE_ID_DISPLAY, temperature, TEMPERATURE_DISPLAY_DECIMALS);
+        LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, " ");
+        LCD_enuWriteGlyph(LCD_eDEVICE_ID_DISPLAY, degreeGlyph);
+        LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, "C");
+
+        // Les alarmes sont evaluees avant l'affichage (ordre des abonnes du filtre)
+        if (ALM_u8GetActiveMask() != 0)
+        {
+            LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, " ALM");
+        }
+    }
+
+    // Le graphe et les statistiques suivent chaque valeur filtree, bande morte ou non
+    LCD_enuTrendGraphPush(&temperatureGraph, temperature);
+
+    AppManager_displayStatistics();
+}
+
+static void AppManager_displayStatistics(void)
+{
+    HIS_tstrStatistics statistics;
+    char row[LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS + 1];
+    uint8_t length = 0;
+
+    if (HIS_enuGetStatistics(&statistics) != HIS_eSTATUS_OK)
+    {
+        return;
+    }
+
+    // Format "min<moyenne<max sEcartType", tronque a la largeur de la ligne pour ne pas deborder sur le graphe
+    length = AppManager_appendDecimal(row, length, statistics.s16Min, STATISTICS_DISPLAY_BOUND_DECIMALS);
+    length = AppManager_appendText(row, length, "<");
+    length = AppManager_appendDecimal(row, length, statistics.s16Mean, STATISTICS_DISPLAY_DECIMALS);
+    length = AppManager_appendText(row, length, "<");
+    length = AppManager_appendDecimal(row, length, statistics.s16Max, STATISTICS_DISPLAY_BOUND_DECIMALS);
+    length = AppManager_appendText(row, length, " s");
+    length = AppManager_appendDecimal(row, length, statistics.u16StdDev, STATISTICS_DISPLAY_DECIMALS);
+    row[length] = '\0';
+
+    LCD_enuClearRow(LCD_eDEVICE_ID_DISPLAY, STATISTICS_DISPLAY_ROW);
+    LCD_enuWriteText(LCD_eDEVICE_ID_DISPLAY, row);
+}
+
+static int32_t AppManager_roundTemperature(const int32_t temperature, const uint8_t decimals)
+{
+    // Passage de 0.01 degre a la resolution affichee, arrondi au plus proche et symetrique autour de 0
+    const int32_t divisor = (decimals == 0) ? 100 : ((decimals == 1) ? 10 : 1);
+
+    return (temperature >= 0) ? ((temperature + (divisor / 2)) / divisor) : ((temperature - (divisor / 2)) / divisor);
+}
+
+static uint8_t AppManager_appendDecimal(char *row, uint8_t length, const int32_t temperature, const uint8_t decimals)
+{
+    char text[CMN_FMT_BUFFER_SIZE];
+
+    (void)CMN_u8FormatDecimal(text, sizeof(text), AppManager_roundTemperature(temperature, decimals), decimals);
+
+    return AppManager_appendText(row, length, text);
+}
+
+static uint8_t AppManager_appendText(char *row, uint8_t length, const char *text)
+{
+    // Les caracteres au-dela de la largeur de la ligne sont ignores
+    while ((*text != '\0') && (length < LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS))
+    {
+        row[length] = *text;
+        length++;
+        text++;
+    }
+
+    return length;
+}
+
+static void AppManager_sendTemperature(const int16_t temperature)
+{
+    // Envoi sur 2 octets, little-endian, en 0.01 degre
+    const uint8_t temperatureMessage[2] = { (uint8_t)temperature, (uint8_t)((uint16_t)temperature >> 8) };
+
+    // Pas d'envoi dans la bande morte, sauf a la fin du silence maximal
+    if (!RPT_bIsReportNeeded(RPT_eCHANNEL_SERP, temperature))
+    {
+        return;
+    }
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_TEMPERATURE, temperatureMessage, sizeof(temperatureMessage)) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send temperature to IHM\r\n");
+    }
+}
+
+static void AppManager_applyFilterSettings(void)
+{
+    uint8_t message[FLT_SETTINGS_RECORD_SIZE];
+    uint8_t size;
+
+    // Un message vide est une simple lecture des reglages
+    if ((filterSettingsLength != 0) &&
+        (FLT_enuImportSettings(filterSettingsRecord, filterSettingsLength) != FLT_eSTATUS_OK))
+    {
+        CMN_systemLogText("Error: Invalid filter settings\r\n");
+    }
+
+    // Reponse avec les reglages appliques (inchanges en cas d'erreur)
+    size = FLT_u8ExportSettings(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_FILTER_SETTINGS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send filter settings\r\n");
+    }
+}
+
+static void AppManager_sendHistoryStatistics(void)
+{
+    uint8_t message[HIS_STATISTICS_RECORD_SIZE];
+    uint8_t size;
+
+    // Un message vide est une simple lecture, un octet change la fenetre des statistiques
+    if ((historyStatsLength != 0) &&
+        ((historyStatsLength != 1) || !HIS_bSetWindowLength(historyWindowLength)))
+    {
+        CMN_systemLogText("Error: Invalid history window\r\n");
+    }
+
+    size = HIS_u8ExportStatistics(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_HISTORY_STATS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send history statistics\r\n");
+    }
+}
+
+static void AppManager_sendHistoryBuckets(void)
+{
+    uint8_t message[3 + (HISTORY_QUERY_RECORDS_PER_MSG * AGG_RECORD_SIZE)];
+    uint8_t size;
+
+    // Reponse vide de records si le niveau est invalide ou s'il n'y a plus de bucket a cet age
+    size = AGG_u8ExportBuckets((AGG_tenuLevel)historyQueryLevel, historyQueryAge, &message[3], sizeof(message) - 3);
+    message[0] = historyQueryLevel;
+    message[1] = historyQueryAge;
+    message[2] = size / AGG_RECORD_SIZE;
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_HISTORY_QUERY, message, size + 3) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send history buckets\r\n");
+    }
+}
+
+static void AppManager_sendTelemetryStatus(void)
+{
+    uint8_t message[TLM_STATUS_RECORD_SIZE];
+    uint8_t size;
+    bool interruptsEnabled = INTCONbits.GIE;
+    uint16_t linkLength;
+    uint32_t ackIndex;
+
+    // Copie atomique : l'index sur 32 bits est ecrit octet par octet dans l'interruption de reception, une lecture
+    // interrompue donnerait un index dechire (et des echantillons jamais rattrapes)
+    INTCONbits.GIE = false;
+    linkLength = telemetryLinkLength;
+    ackIndex = telemetryAckIndex;
+    INTCONbits.GIE = interruptsEnabled;
+
+    // Un message vide est un simple signe de vie, 4 octets acquittent les echantillons recus par l'IHM
+    if (linkLength == 4)
+    {
+        TLM_vidAcknowledge(ackIndex);
+    }
+    else if (linkLength != 0)
+    {
+        CMN_systemLogText("Error: Invalid telemetry acknowledgement\r\n");
+    }
+
+    size = TLM_u8ExportStatus(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_TELEMETRY_LINK, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send telemetry status\r\n");
+    }
+}
+
+static void AppManager_startLogDownload(void)
 {
-    static int16_t temperature = 0;
-    MCP9700_status mcpStatus;
+    uint8_t message[DWL_RANGE_RECORD_SIZE];
+    uint8_t size;
+
+    if (DWL_enuImportRequest(logReadRequest, logReadLength) != DWL_eSTATUS_OK)
+    {
+        CMN_systemLogText("Error: Invalid log read request\r\n");
+    }
+
+    // Reponse avec la plage servie (bornee au contenu du journal), les chunks suivent dans la boucle principale
+    size = DWL_u8ExportRange(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_LOG_READ, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send log range\r\n");
+    }
+}
 
+static void AppManager_handleAlarmChange(const uint8_t changedMask)
+{
+    (void)changedMask;
+
+    // L'indication ALM de l'afficheur est mise a jour avec cet echantillon, meme dans la bande morte
+    RPT_vidForceReport(RPT_eCHANNEL_DISPLAY);
+
+    // Envoi immediat a l'IHM, sans attendre le rapport de la temperature (les abonnes suivants du filtre)
+    AppManager_sendAlarmStatus();
+
+    // La LED est mise a jour par l'evenement APPM_EVENT_ALARM de la machine d'etat
+    alarmEventPending = true;
+}
+
+static void AppManager_sendAlarmStatus(void)
+{
+    uint8_t message[ALM_STATUS_RECORD_SIZE];
+    uint8_t size;
+
+    size = ALM_u8ExportStatus(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_ALARM, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send alarm status\r\n");
+    }
+}
+
+static void AppManager_applyAlarmSettings(void)
+{
+    uint8_t message[ALM_SETTINGS_RECORD_SIZE];
+    uint8_t size;
+
+    // Un message vide est une simple lecture des reglages
+    if ((alarmSettingsLength != 0) &&
+        (ALM_enuImportSettings(alarmSettingsRecord, alarmSettingsLength) != ALM_eSTATUS_OK))
+    {
+        CMN_systemLogText("Error: Invalid alarm settings\r\n");
+    }
+
+    // Reponse avec les reglages appliques (inchanges en cas d'erreur)
+    size = ALM_u8ExportSettings(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_ALARM_SETTINGS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send alarm settings\r\n");
+    }
+}
+
+static void AppManager_signalAlarms(void)
+{
+    bool active = (ALM_u8GetActiveMask() != 0);
+
+    GPIO_setAlarmLed(active);
+    CMN_systemLogText(active ? "Alarm active\r\n" : "Alarms cleared\r\n");
+}
+
+static void AppManager_applySamplePeriod(const uint16_t periodMs)
+{
+    // Refuse pour un capteur mesure sur demande (mode detection de changement) : il reste mesure a chaque variation
+    (void)MCP9700_setSamplePeriod(MCP9700_CONFIG_PRIMARY_SENSOR_ID, periodMs);
+}
+
+static void AppManager_applySamplingSettings(void)
+{
+    uint8_t message[SMP_SETTINGS_RECORD_SIZE];
+    uint8_t size;
+
+    // Un message vide est une simple lecture des reglages
+    if ((samplingSettingsLength != 0) &&
+        (SMP_enuImportSettings(samplingSettingsRecord, samplingSettingsLength) != SMP_eSTATUS_OK))
+    {
+        CMN_systemLogText("Error: Invalid sampling settings\r\n");
+    }
+
+    // Reponse avec les reglages appliques (inchanges en cas d'erreur)
+    size = SMP_u8ExportSettings(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_SAMPLING_SETTINGS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send sampling settings\r\n");
+    }
+}
+
+static void AppManager_applyReportSettings(void)
+{
+    uint8_t message[RPT_SETTINGS_RECORD_SIZE];
+    uint8_t size;
+
+    // Un message vide est une simple lecture des reglages
+    if ((reportSettingsLength != 0) &&
+        (RPT_enuImportSettings(reportSettingsRecord, reportSettingsLength) != RPT_eSTATUS_OK))
+    {
+        CMN_systemLogText("Error: Invalid report settings\r\n");
+    }
+
+    // Reponse avec les reglages appliques (inchanges en cas d'erreur)
+    size = RPT_u8ExportSettings(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_REPORT_SETTINGS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send report settings\r\n");
+    }
+}
+
+static void AppManager_sendReportStatus(void)
+{
+    uint8_t message[RPT_STATUS_RECORD_SIZE];
+    uint8_t size;
+
+    // Valeurs envoyees et supprimees de chaque sortie, depuis le demarrage
+    size = RPT_u8ExportStatus(message, sizeof(message));
+
+    if (SERP_enuSendMessage(SERP_MSG_ID_REPORT_STATUS, message, size) != SERP_STATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to send report status\r\n");
+    }
+}
+
+#if (ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+static void AppManager_temperatureChangedCallback(const uint16_t adcValue)
+{
+    (void)adcValue;
+
+    // Appele depuis l'interruption de l'ADC : la mesure est traitee dans la boucle principale
+    temperatureChanged = true;
+}
+#endif
+
+static void AppManager_handleEvent(AppManager_event event)
+{
     switch (currentState)
     {
         case APPM_STATE_SUSPENDED:
 
-            if (pendingEvent == APPM_EVENT_TIMER)
+            if (event == APPM_EVENT_TIMER)
             {
                 if (SERP_enuSendMessage(SERP_MSG_ID_LIVE_SIGN, NULL, 0) != SERP_STATUS_OK)
                 {
-                    CMN_systemPrintf("Error: Unable to send heartbeat message in SUSPENDED state\r\n");
+                    CMN_systemLogText("Error: Unable to send heartbeat message in SUSPENDED state\r\n");
                 }
             }
             
-            else if (pendingEvent == APPM_EVENT_BUTTON_PRESSED)
+            else if (event == APPM_EVENT_BUTTON_PRESSED)
             {
-                currentState = APPM_STATE_RUNNING;
-                CMN_systemPrintf("State changed to RUNNING\r\n");
-
-                LCD_enuClearAll(LCD_eDEVICE_ID_DISPLAY);
-                LCD_enuSetCursor(LCD_eDEVICE_ID_DISPLAY, 1, 1);
-                LCD_enuPrintf(LCD_eDEVICE_ID_DISPLAY, "State: RUNNING");
+                AppManager_enterRunning();
 
                 const uint8_t helloworld[] = "Hello World";
                 if (SERP_enuSendMessage(SERP_MSG_ID_CUSTOM, helloworld, sizeof(helloworld)) != SERP_STATUS_OK)
                 {
-                    CMN_systemPrintf("Error: Unable to send Hello World\r\n");
+                    CMN_systemLogText("Error: Unable to send Hello World\r\n");
                 }
             }
+            else if (event == APPM_EVENT_ALARM)
+            {
+                AppManager_signalAlarms();
+            }
             else
             {
                 AppManager_displayWelcomeMessage();
@@ -148,73 +655,178 @@ static void AppManager_handleEvent(void)
             break;
 
         case APPM_STATE_RUNNING:
-            if (pendingEvent == APPM_EVENT_TIMER)
+            if (event == APPM_EVENT_TIMER)
             {
-                int8_t temperature = 0;
-                MCP9700_status mcpStatus;
-
-                mcpStatus = MCP9700_getTemperature(&temperature);
-
-                if (mcpStatus == MCP9700_OK)
-                {
-                    LCD_enuClearAll(LCD_eDEVICE_ID_DISPLAY);
-                    LCD_enuSetCursor(LCD_eDEVICE_ID_DISPLAY, 1, 1);
-                    LCD_enuPrintf(LCD_eDEVICE_ID_DISPLAY, "Temp: %d deg C", temperature);
-
-                    if (SERP_enuSendMessage(SERP_MSG_ID_TEMPERATURE, (uint8_t *)&temperature, 1) != SERP_STATUS_OK)
-                    {
-                        CMN_systemPrintf("Error: Unable to send temperature to IHM\r\n");
-                    }
-
-                }
-                else
-                {
-                    LCD_enuClearAll(LCD_eDEVICE_ID_DISPLAY);
-                    LCD_enuSetCursor(LCD_eDEVICE_ID_DISPLAY, 1, 1);
-                    LCD_enuPrintf(LCD_eDEVICE_ID_DISPLAY, "Temp: Error");
-                }
-
+                // Les capteurs sont mesures par l'ordonnanceur de MCP9700_process, selon leur periode
                 GPIO_toggleGpio();
-                CMN_systemPrintf("Performing periodic action in RUNNING state\r\n");
+                CMN_systemLogText("Performing periodic action in RUNNING state\r\n");
             }
-            else if (pendingEvent == APPM_EVENT_BUTTON_PRESSED)
+            else if (event == APPM_EVENT_BUTTON_PRESSED)
             {
                 currentState = APPM_STATE_SUSPENDED;
-                CMN_systemPrintf("State changed to SUSPENDED\r\n");
+                CMN_systemLogText("State changed to SUSPENDED\r\n");
 
                 AppManager_displayWelcomeMessage();
             }
+            else if (event == APPM_EVENT_ALARM)
+            {
+                AppManager_signalAlarms();
+            }
             break;
 
         default:
-            CMN_systemPrintf("Unknown state\r\n");
+            CMN_systemLogText("Unknown state\r\n");
             break;
     }
-
-    pendingEvent = APPM_EVENT_NONE;
 }
 
 static void AppManager_handleReceivedMessage(SERP_tenuMsgId msgId, const uint8_t *data, uint16_t dataLength)
 {
-    CMN_systemPrintf("AppManager received message ID=%d, Length=%d\r\n", msgId, dataLength);
+    CMN_systemLogText("AppManager received message ID=");
+    CMN_systemLogInteger(msgId);
+    CMN_systemLogText(", Length=");
+    CMN_systemLogInteger(dataLength);
+    CMN_systemLogText("\r\n");
+
+    // Tout message de l'IHM est un signe de vie du lien (voir Telemetry.h)
+    hostMessageReceived = true;
 
     switch (msgId)
     {
         case SERP_MSG_ID_START_MEASURE:
-            CMN_systemPrintf("START command received\r\n");
+            CMN_systemLogText("START command received\r\n");
             // Ajouter ici le traitement pour le démarrage de la mesure
-            currentState = APPM_STATE_RUNNING;
+            AppManager_enterRunning();
             break;
 
         case SERP_MSG_ID_STOP_MEASURE:
-            CMN_systemPrintf("STOP command received\r\n");
+            CMN_systemLogText("STOP command received\r\n");
             // Ajouter ici le traitement pour l'arrêt de la mesure
             currentState = APPM_STATE_SUSPENDED;
             AppManager_displayWelcomeMessage();
             break;
 
+        case SERP_MSG_ID_I2C_TRACE_REQUEST:
+            // L'export est fait dans la boucle principale, hors interruption et entre deux transactions I2C
+            i2cTraceRequested = true;
+            break;
+
+        case SERP_MSG_ID_FILTER_SETTINGS:
+            // Les reglages sont appliques dans la boucle principale, entre deux echantillons
+            filterSettingsLength = dataLength;
+
+            if (dataLength == sizeof(filterSettingsRecord))
+            {
+                memcpy(filterSettingsRecord, data, sizeof(filterSettingsRecord));
+            }
+
+            filterSettingsRequested = true;
+            break;
+
+        case SERP_MSG_ID_HISTORY_STATS:
+            // La fenetre est changee dans la boucle principale, entre deux echantillons
+            historyStatsLength = dataLength;
+
+            if (dataLength == 1)
+            {
+                historyWindowLength = data[0];
+            }
+
+            historyStatsRequested = true;
+            break;
+
+        case SERP_MSG_ID_HISTORY_QUERY:
+            if (dataLength == 2)
+            {
+                historyQueryLevel = data[0];
+                historyQueryAge = data[1];
+                historyQueryRequested = true;
+            }
+            break;
+
+        case SERP_MSG_ID_TELEMETRY_LINK:
+            // L'acquittement est pris en compte dans la boucle principale, entre deux echantillons
+            telemetryLinkLength = dataLength;
+
+            if (dataLength == 4)
+            {
+                telemetryAckIndex = (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                                    ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+            }
+
+            telemetryLinkRequested = true;
+            break;
+
+        case SERP_MSG_ID_ALARM:
+            // L'etat des alarmes est envoye depuis la boucle principale
+            alarmStatusRequested = true;
+            break;
+
+        case SERP_MSG_ID_ALARM_SETTINGS:
+            // Les reglages sont appliques dans la boucle principale, entre deux echantillons
+            alarmSettingsLength = dataLength;
+
+            if (dataLength == sizeof(alarmSettingsRecord))
+            {
+                memcpy(alarmSettingsRecord, data, sizeof(alarmSettingsRecord));
+            }
+
+            alarmSettingsRequested = true;
+            break;
+
+        case SERP_MSG_ID_SAMPLING_SETTINGS:
+            // Les reglages sont appliques dans la boucle principale, entre deux echantillons
+            samplingSettingsLength = dataLength;
+
+            if (dataLength == sizeof(samplingSettingsRecord))
+            {
+                memcpy(samplingSettingsRecord, data, sizeof(samplingSettingsRecord));
+            }
+
+            samplingSettingsRequested = true;
+            break;
+
+        case SERP_MSG_ID_REPORT_SETTINGS:
+            // Les reglages sont appliques dans la boucle principale, entre deux echantillons
+            reportSettingsLength = dataLength;
+
+            if (dataLength == sizeof(reportSettingsRecord))
+            {
+                memcpy(reportSettingsRecord, data, sizeof(reportSettingsRecord));
+            }
+
+            reportSettingsRequested = true;
+            break;
+
+        case SERP_MSG_ID_REPORT_STATUS:
+            // Les compteurs sont envoyes depuis la boucle principale
+            reportStatusRequested = true;
+            break;
+
+        case SERP_MSG_ID_LOG_READ:
+            // La lecture demarre dans la boucle principale, entre deux echantillons
+            logReadLength = dataLength;
+
+            if (dataLength == sizeof(logReadRequest))
+            {
+                memcpy(logReadRequest, data, sizeof(logReadRequest));
+            }
+
+            logReadRequested = true;
+            break;
+
+        case SERP_MSG_ID_LOG_ACK:
+            // Acquittement traite directement (un octet) : la fenetre avance pendant l'envoi des chunks
+            if (dataLength == 1)
+            {
+                DWL_vidAcknowledge(data[0]);
+            }
+            break;
+
         default:
-            CMN_systemPrintf("Unknown message ID: %d\r\n", msgId);
+            CMN_systemLogText("Unknown message ID: ");
+            CMN_systemLogInteger(msgId);
+            CMN_systemLogText("\r\n");
             break;
     }
 }
@@ -233,7 +845,7 @@ AppManager_status AppManager_init(void)
     // Enregistrer le callback pour recevoir les messages
     if (SERP_enuRegisterAppManagerCallback(AppManager_handleReceivedMessage) != SERP_STATUS_OK)
     {
-        CMN_systemPrintf("Error: Unable to register AppManager callback with SERP\r\n");
+        CMN_systemLogText("Error: Unable to register AppManager callback with SERP\r\n");
         return APPMANAGER_NOK;
     }
 
@@ -243,7 +855,7 @@ AppManager_status AppManager_init(void)
 
     if (!success)
     {
-        CMN_systemPrintf("Error: Unable to register TIMER callback\r\n");
+        CMN_systemLogText("Error: Unable to register TIMER callback\r\n");
         return APPMANAGER_NOK;
     }
 
@@ -254,14 +866,82 @@ AppManager_status AppManager_init(void)
 
     if (!success)
     {
-        CMN_systemPrintf("Error: Unable to start TIMER\r\n");
+        CMN_systemLogText("Error: Unable to start TIMER\r\n");
+        return APPMANAGER_NOK;
+    }
+
+#if (ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+    if (!ADC_bRegisterChangeCbk(AppManager_temperatureChangedCallback) ||
+        (MCP9700_setChangeDelta(TEMPERATURE_CHANGE_DELTA_TENTH_DEG_C) != MCP9700_OK))
+    {
+        CMN_systemLogText("Error: Unable to configure the temperature change detection\r\n");
+        return APPMANAGER_NOK;
+    }
+#endif
+
+    if (MCP9700_registerSampleCallback(AppManager_handleSensorSample) != MCP9700_OK)
+    {
+        CMN_systemLogText("Error: Unable to register the sensor sample callback\r\n");
+        return APPMANAGER_NOK;
+    }
+
+    FLT_vidInitialize();
+    HIS_vidInitialize();
+    AGG_vidInitialize();
+    ALM_vidInitialize();
+
+    if (!ALM_bRegisterEventCbk(AppManager_handleAlarmChange))
+    {
+        CMN_systemLogText("Error: Unable to register the alarm callback\r\n");
+        return APPMANAGER_NOK;
+    }
+
+    // Bande morte de l'envoi de la temperature et de l'affichage
+    RPT_vidInitialize();
+
+    // La periode du capteur principal suit celle de la politique d'echantillonnage adaptatif
+    SMP_vidInitialize();
+
+    if (!SMP_bRegisterPeriodCbk(AppManager_applySamplePeriod))
+    {
+        CMN_systemLogText("Error: Unable to register the sampling period callback\r\n");
+        return APPMANAGER_NOK;
+    }
+
+    AppManager_applySamplePeriod(SMP_u16GetPeriodMs());
+
+    // Les abonnes sont appeles dans l'ordre d'enregistrement : l'historique est mis a jour avant l'affichage des
+    // statistiques et le calcul de la pente des alarmes. La telemetrie ajoute l'echantillon au journal en EEPROM (son
+    // numero de sequence) et l'envoie a l'IHM
+    if (!FLT_bSubscribe(HIS_vidPushSample) ||
+        !FLT_bSubscribe(AGG_vidPushSample) ||
+        !FLT_bSubscribe(ALM_vidPushSample) ||
+        !FLT_bSubscribe(SMP_vidPushSample) ||
+        !FLT_bSubscribe(TLM_vidPushSample) ||
+        !FLT_bSubscribe(AppManager_displayTemperature) ||
+        !FLT_bSubscribe(AppManager_sendTemperature))
+    {
+        CMN_systemLogText("Error: Unable to subscribe to the filtered temperature\r\n");
         return APPMANAGER_NOK;
     }
 
     LCD_vidInitialize();
     AppManager_displayWelcomeMessage();
 
-    CMN_systemPrintf("LCD initialized successfully.\r\n");
+    if (LCD_enuTrendGraphInit(&temperatureGraph,
+                              LCD_eDEVICE_ID_DISPLAY,
+                              1,
+                              TEMPERATURE_GRAPH_ROW,
+                              LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS,
+                              TEMPERATURE_GRAPH_HEIGHT,
+                              TEMPERATURE_GRAPH_MIN_DEG_C * MCP9700_TEMPERATURE_SCALE,
+                              TEMPERATURE_GRAPH_MAX_DEG_C * MCP9700_TEMPERATURE_SCALE) != LCD_eSTATUS_OK)
+    {
+        CMN_systemLogText("Error: Unable to initialize the temperature graph\r\n");
+        return APPMANAGER_NOK;
+    }
+
+    CMN_systemLogText("LCD initialized successfully.\r\n");
 
     return APPMANAGER_OK;
 }
@@ -272,9 +952,126 @@ void APPM_vidStart(void)
     {
         if (pendingEvent != APPM_EVENT_NONE)
         {
-            AppManager_handleEvent();
+            AppManager_event event = pendingEvent;
+            pendingEvent = APPM_EVENT_NONE;
+            AppManager_handleEvent(event);
+        }
+
+        // Les alarmes sont levees depuis la boucle principale : leur evenement n'ecrase pas celui d'une interruption
+        if (alarmEventPending)
+        {
+            alarmEventPending = false;
+            AppManager_handleEvent(APPM_EVENT_ALARM);
+        }
+
+        if (i2cTraceRequested)
+        {
+            i2cTraceRequested = false;
+            AppManager_sendI2cTrace();
+        }
+
+        if (filterSettingsRequested)
+        {
+            filterSettingsRequested = false;
+            AppManager_applyFilterSettings();
+        }
+
+        if (historyStatsRequested)
+        {
+            historyStatsRequested = false;
+            AppManager_sendHistoryStatistics();
+        }
+
+        if (historyQueryRequested)
+        {
+            historyQueryRequested = false;
+            AppManager_sendHistoryBuckets();
+        }
+
+        if (hostMessageReceived)
+        {
+            hostMessageReceived = false;
+            TLM_vidNotifyHostMessage();
+        }
+
+        if (telemetryLinkRequested)
+        {
+            telemetryLinkRequested = false;
+            AppManager_sendTelemetryStatus();
+        }
+
+        if (alarmStatusRequested)
+        {
+            alarmStatusRequested = false;
+            AppManager_sendAlarmStatus();
+        }
+
+        if (alarmSettingsRequested)
+        {
+            alarmSettingsRequested = false;
+            AppManager_applyAlarmSettings();
+        }
+
+        if (samplingSettingsRequested)
+        {
+            samplingSettingsRequested = false;
+            AppManager_applySamplingSettings();
+        }
+
+        if (reportSettingsRequested)
+        {
+            reportSettingsRequested = false;
+            AppManager_applyReportSettings();
         }
 
+        if (reportStatusRequested)
+        {
+            reportStatusRequested = false;
+            AppManager_sendReportStatus();
+        }
+
+        if (logReadRequested)
+        {
+            logReadRequested = false;
+            AppManager_startLogDownload();
+        }
+
+        // Cloture des minutes ecoulees de l'historique agrege, meme sans echantillon
+        AGG_vidProcess();
+
+        // Alarmes dont la duree de maintien s'acheve sans nouvel echantillon (mode detection de changement)
+        ALM_vidProcess();
+
+        // Surveillance du lien et rattrapage limite en debit, avant l'ecriture du journal qui occupe l'EEPROM
+        TLM_vidProcess();
+
+        // Envoi des chunks du journal autorises par la fenetre, avant l'ecriture du journal qui occupe l'EEPROM
+        DWL_vidProcess();
+
+        // Ecriture non bloquante du journal en EEPROM, un octet par tour quand l'EEPROM est libre
+        NVL_vidProcess();
+
+        // Variation de la voie principale (ou entree dans l'etat RUNNING) : tous les capteurs sont mesures sans attendre
+        // leur periode
+        if (temperatureChanged)
+        {
+            temperatureChanged = false;
+
+            if (currentState == APPM_STATE_RUNNING)
+            {
+                MCP9700_requestSample();
+            }
+        }
+
+        // Un seul scan de l'ADC pour les capteurs a mesurer, les mesures arrivent dans AppManager_handleSensorSample
+        if (currentState == APPM_STATE_RUNNING)
+        {
+            MCP9700_process();
+        }
+
+        // Envoi des ecritures differees de l'afficheur, par tranches de LCD_CONFIG_RENDER_SLICE_US
+        LCD_vidProcess();
+
         __delay_ms(10);
     }
 }
@@ -0,0 +1,56 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Download_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Download Driver conf part
+ * @details   Module in charge of the bulk download of the persistent log over SERP
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef DOWNLOAD_CFG_H_
+#define DOWNLOAD_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the maximal number of chunks sent and not acknowledged (1 to 127), the window requested by the host
+ *        is limited to it
+ * @remark A chunk takes about 5 ms at 115200 bauds: 8 chunks hide an acknowledgement delay of 40 ms
+ */
+#define DWL_CONFIG_MAX_WINDOW                               8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the maximal number of chunks sent by a call of DWL_vidProcess (at least 1): the sending is blocking,
+ *        this bounds the time taken from the main loop
+ */
+#define DWL_CONFIG_CHUNKS_PER_CALL                          8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* DOWNLOAD_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
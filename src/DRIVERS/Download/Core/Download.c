@@ -0,0 +1,394 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Download.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Download Driver core part
+ * @details   Module in charge of the bulk download of the persistent log over SERP (chunks and sliding window)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "SERP.h"
+#include "NVLog.h"
+#include "Download.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((DWL_CONFIG_MAX_WINDOW < 1) || (DWL_CONFIG_MAX_WINDOW > 127))
+#  error "[DWL ] Error: The setting DWL_CONFIG_MAX_WINDOW must be between 1 and 127"
+#endif
+
+#if(DWL_CONFIG_CHUNKS_PER_CALL < 1)
+#  error "[DWL ] Error: The setting DWL_CONFIG_CHUNKS_PER_CALL must be at least 1"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the samples of a chunk and maximal number of samples of a chunk for each encoding (a delta encoded
+ *        chunk holds its first sample on 2 bytes and the others on 1 byte at best)
+ */
+#define DWL_CHUNK_PAYLOAD_SIZE                              (SERP_MAX_MSG_DATA_SIZE - DWL_CHUNK_HEADER_SIZE)
+#define DWL_RAW_MAX_SAMPLES                                 (DWL_CHUNK_PAYLOAD_SIZE / 2)
+#define DWL_DELTA_MAX_SAMPLES                               (DWL_CHUNK_PAYLOAD_SIZE - 1)
+
+#if(DWL_CHUNK_PAYLOAD_SIZE < 3)
+#  error "[DWL ] Error: SERP_MAX_MSG_DATA_SIZE is too small for a chunk"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Escape byte of the delta encoding, followed by the sample on 2 bytes
+ */
+#define DWL_DELTA_ESCAPE                                    0x80
+#define DWL_DELTA_MAX                                       127
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Range of the download: the served range (see DWL_u8ExportRange), the next sample to send and the end of the
+ *        range (excluded)
+ */
+static bool             DWL_bIsRunning                      = false;
+static uint32_t         DWL_u32FirstIndex                   = 0;
+static uint32_t         DWL_u32Count                        = 0;
+static uint32_t         DWL_u32NextIndex                    = 0;
+static uint32_t         DWL_u32EndIndex                     = 0;
+static DWL_tenuEncoding DWL_enuEncoding                     = DWL_eENCODING_RAW;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Sliding window: number of the first chunk of the download, of the next chunk to send and of the next chunk
+ *        expected by the host (written by the reception interrupt). The numbers keep running from a download to the
+ *        next one, an acknowledgement of a previous download is thus ignored
+ */
+static uint8_t          DWL_u8Window                        = DWL_CONFIG_MAX_WINDOW;
+static uint8_t          DWL_u8FirstChunk                    = 0;
+static uint8_t          DWL_u8NextChunk                     = 0;
+static volatile uint8_t DWL_u8AckedChunk                    = 0;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to read the next samples and to send them in a chunk (the last chunk has no sample)
+ * @return Return "true" if the download went forward, return "false" otherwise (EEPROM busy or sending failed)
+ */
+static bool bSendChunk(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to encode as many samples as possible in the payload of a chunk
+ * @return The number of encoded samples, their size is written in kpu8Size
+ */
+static uint8_t u8EncodeChunk(int16_t const * const kpks16Samples,
+                             const uint8_t ku8Count,
+                             uint8_t * const kpu8Payload,
+                             uint8_t * const kpu8Size);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bSendChunk(void)
+{
+  uint8_t        au8Message[DWL_CHUNK_HEADER_SIZE + DWL_CHUNK_PAYLOAD_SIZE];
+  int16_t        as16Samples[DWL_DELTA_MAX_SAMPLES];
+  uint8_t        u8MaxCount      = DWL_RAW_MAX_SAMPLES;
+  uint8_t        u8ReadCount     = 0;
+  uint8_t        u8Count         = 0;
+  uint8_t        u8Size          = 0;
+  bool           bStatus         = false;
+  bool           bSend           = true;
+  const uint32_t ku32OldestIndex = NVL_u32GetOldestIndex();
+  NVL_tenuStatus enuStatus       = NVL_eSTATUS_OK;
+
+  // The samples overwritten during the download are skipped:
+  if(DWL_u32NextIndex < ku32OldestIndex)
+  {
+    DWL_u32NextIndex = ku32OldestIndex;
+  }
+
+  if(DWL_u32NextIndex < DWL_u32EndIndex)
+  {
+    if(DWL_enuEncoding == DWL_eENCODING_DELTA)
+    {
+      u8MaxCount = DWL_DELTA_MAX_SAMPLES;
+    }
+
+    if((DWL_u32EndIndex - DWL_u32NextIndex) < u8MaxCount)
+    {
+      u8MaxCount = (uint8_t)(DWL_u32EndIndex - DWL_u32NextIndex);
+    }
+
+    enuStatus = NVL_enuReadSamples(DWL_u32NextIndex, as16Samples, u8MaxCount, &u8ReadCount);
+    bSend     = false;
+
+    if(enuStatus == NVL_eSTATUS_OK)
+    {
+      u8Count = u8EncodeChunk(as16Samples, u8ReadCount, &au8Message[DWL_CHUNK_HEADER_SIZE], &u8Size);
+      bSend   = true;
+    }
+    else if(enuStatus == NVL_eSTATUS_NO_SAMPLE)
+    {
+      // Index skipped at a mount: the next chunk starts after it
+      DWL_u32NextIndex++;
+      bStatus = true;
+    }
+    else
+    {
+      // The EEPROM is being written: retry at the next call
+    }
+  }
+
+  if(bSend == true)
+  {
+    au8Message[0] = (uint8_t)DWL_u32NextIndex;
+    au8Message[1] = (uint8_t)(DWL_u32NextIndex >> 8);
+    au8Message[2] = (uint8_t)(DWL_u32NextIndex >> 16);
+    au8Message[3] = (uint8_t)(DWL_u32NextIndex >> 24);
+    au8Message[4] = DWL_u8NextChunk;
+    au8Message[5] = u8Count;
+
+    if(SERP_enuSendMessage(SERP_MSG_ID_LOG_DATA,
+                           au8Message,
+                           (uint16_t)DWL_CHUNK_HEADER_SIZE + u8Size) == SERP_STATUS_OK)
+    {
+      // The chunk without sample ends the download:
+      DWL_bIsRunning    = (u8Count > 0);
+      DWL_u32NextIndex += u8Count;
+      DWL_u8NextChunk++;
+      bStatus           = true;
+    }
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8EncodeChunk(int16_t const * const kpks16Samples,
+                             const uint8_t ku8Count,
+                             uint8_t * const kpu8Payload,
+                             uint8_t * const kpu8Size)
+{
+  uint8_t u8Encoded = 0;
+  uint8_t u8Size    = 0;
+  int32_t s32Delta  = 0;
+  bool    bFits     = true;
+
+  while((u8Encoded < ku8Count) && (bFits == true))
+  {
+    if(u8Encoded > 0)
+    {
+      s32Delta = (int32_t)kpks16Samples[u8Encoded] - kpks16Samples[u8Encoded - 1];
+    }
+
+    if((DWL_enuEncoding == DWL_eENCODING_DELTA) && (u8Encoded > 0) &&
+       (s32Delta >= -DWL_DELTA_MAX) && (s32Delta <= DWL_DELTA_MAX))
+    {
+      bFits = ((u8Size + 1) <= DWL_CHUNK_PAYLOAD_SIZE);
+
+      if(bFits == true)
+      {
+        kpu8Payload[u8Size++] = (uint8_t)(int8_t)s32Delta;
+      }
+    }
+    else
+    {
+      // Raw sample, first sample of a delta chunk or delta out of range (escaped):
+      if((DWL_enuEncoding == DWL_eENCODING_DELTA) && (u8Encoded > 0))
+      {
+        bFits = ((u8Size + 3) <= DWL_CHUNK_PAYLOAD_SIZE);
+
+        if(bFits == true)
+        {
+          kpu8Payload[u8Size++] = DWL_DELTA_ESCAPE;
+        }
+      }
+      else
+      {
+        bFits = ((u8Size + 2) <= DWL_CHUNK_PAYLOAD_SIZE);
+      }
+
+      if(bFits == true)
+      {
+        kpu8Payload[u8Size++] = (uint8_t)kpks16Samples[u8Encoded];
+        kpu8Payload[u8Size++] = (uint8_t)((uint16_t)kpks16Samples[u8Encoded] >> 8);
+      }
+    }
+
+    if(bFits == true)
+    {
+      u8Encoded++;
+    }
+  }
+
+  *kpu8Size = u8Size;
+
+  return u8Encoded;
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void DWL_vidInitialize(void)
+{
+  DWL_bIsRunning    = false;
+  DWL_u32FirstIndex = 0;
+  DWL_u32Count      = 0;
+  DWL_u32NextIndex  = 0;
+  DWL_u32EndIndex   = 0;
+  DWL_enuEncoding   = DWL_eENCODING_RAW;
+  DWL_u8Window      = DWL_CONFIG_MAX_WINDOW;
+  DWL_u8FirstChunk  = 0;
+  DWL_u8NextChunk   = 0;
+  DWL_u8AckedChunk  = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+DWL_tenuStatus DWL_enuImportRequest(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize)
+{
+  DWL_tenuStatus enuStatus = DWL_eSTATUS_OK;
+  uint32_t       u32First  = 0;
+  uint32_t       u32Count  = 0;
+  uint32_t       u32Oldest = 0;
+  uint32_t       u32Next   = 0;
+
+  if(kpku8Buffer == NULL)
+  {
+    enuStatus = DWL_eSTATUS_NULL_POINTER;
+  }
+  else if((ku16BufferSize != DWL_REQUEST_SIZE) || (kpku8Buffer[9] >= (uint8_t)DWL_eENCODING_END))
+  {
+    enuStatus = DWL_eSTATUS_INVALID_REQUEST;
+  }
+  else
+  {
+    u32First  = (uint32_t)kpku8Buffer[0]         | ((uint32_t)kpku8Buffer[1] << 8) |
+                ((uint32_t)kpku8Buffer[2] << 16) | ((uint32_t)kpku8Buffer[3] << 24);
+    u32Count  = (uint32_t)kpku8Buffer[4]         | ((uint32_t)kpku8Buffer[5] << 8) |
+                ((uint32_t)kpku8Buffer[6] << 16) | ((uint32_t)kpku8Buffer[7] << 24);
+    u32Oldest = NVL_u32GetOldestIndex();
+    u32Next   = NVL_u32GetNextIndex();
+
+    if(u32First < u32Oldest)
+    {
+      u32First = u32Oldest;
+    }
+    else if(u32First > u32Next)
+    {
+      u32First = u32Next;
+    }
+
+    if(u32Count > (u32Next - u32First))
+    {
+      u32Count = u32Next - u32First;
+    }
+
+    DWL_u32FirstIndex = u32First;
+    DWL_u32Count      = u32Count;
+    DWL_u32NextIndex  = u32First;
+    DWL_u32EndIndex   = u32First + u32Count;
+    DWL_enuEncoding   = (DWL_tenuEncoding)kpku8Buffer[9];
+    DWL_u8Window      = ((kpku8Buffer[8] == 0) || (kpku8Buffer[8] > DWL_CONFIG_MAX_WINDOW)) ? DWL_CONFIG_MAX_WINDOW :
+                                                                                               kpku8Buffer[8];
+    DWL_u8FirstChunk  = DWL_u8NextChunk;
+    DWL_u8AckedChunk  = DWL_u8NextChunk;
+    DWL_bIsRunning    = (u32Count > 0);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t DWL_u8ExportRange(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t        u8Size     = 0;
+  const uint32_t ku32Oldest = NVL_u32GetOldestIndex();
+  const uint32_t ku32Next   = NVL_u32GetNextIndex();
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= DWL_RANGE_RECORD_SIZE))
+  {
+    kpu8Buffer[0]  = (uint8_t)ku32Oldest;
+    kpu8Buffer[1]  = (uint8_t)(ku32Oldest >> 8);
+    kpu8Buffer[2]  = (uint8_t)(ku32Oldest >> 16);
+    kpu8Buffer[3]  = (uint8_t)(ku32Oldest >> 24);
+    kpu8Buffer[4]  = (uint8_t)ku32Next;
+    kpu8Buffer[5]  = (uint8_t)(ku32Next >> 8);
+    kpu8Buffer[6]  = (uint8_t)(ku32Next >> 16);
+    kpu8Buffer[7]  = (uint8_t)(ku32Next >> 24);
+    kpu8Buffer[8]  = (uint8_t)DWL_u32FirstIndex;
+    kpu8Buffer[9]  = (uint8_t)(DWL_u32FirstIndex >> 8);
+    kpu8Buffer[10] = (uint8_t)(DWL_u32FirstIndex >> 16);
+    kpu8Buffer[11] = (uint8_t)(DWL_u32FirstIndex >> 24);
+    kpu8Buffer[12] = (uint8_t)DWL_u32Count;
+    kpu8Buffer[13] = (uint8_t)(DWL_u32Count >> 8);
+    kpu8Buffer[14] = (uint8_t)(DWL_u32Count >> 16);
+    kpu8Buffer[15] = (uint8_t)(DWL_u32Count >> 24);
+    kpu8Buffer[16] = DWL_u8FirstChunk;
+    kpu8Buffer[17] = DWL_u8Window;
+
+    u8Size = DWL_RANGE_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void DWL_vidAcknowledge(const uint8_t ku8NextChunk)
+{
+  const uint8_t ku8Acked = DWL_u8AckedChunk;
+
+  if((uint8_t)(ku8NextChunk - ku8Acked) <= (uint8_t)(DWL_u8NextChunk - ku8Acked))
+  {
+    DWL_u8AckedChunk = ku8NextChunk;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void DWL_vidProcess(void)
+{
+  uint8_t u8Chunks  = 0;
+  bool    bProgress = true;
+
+  while((DWL_bIsRunning == true) && (bProgress == true) && (u8Chunks < DWL_CONFIG_CHUNKS_PER_CALL) &&
+        ((uint8_t)(DWL_u8NextChunk - DWL_u8AckedChunk) < DWL_u8Window))
+  {
+    bProgress = bSendChunk();
+    u8Chunks++;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,160 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Download.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Download Driver core part
+ * @details   Module in charge of the bulk download of a range of indexes of the persistent log (see NVLog.h) over
+ *            SERP. The samples are sent in chunks of the maximal message size, each chunk is numbered and several
+ *            chunks are sent without waiting for their acknowledgement (sliding window):
+ *              - Request (host): see @ref DWL_REQUEST_SIZE, the answer is the served range (see
+ *                @ref DWL_RANGE_RECORD_SIZE)
+ *              - Chunk: [0..3] index of its first sample, [4] chunk number, [5] number of samples, [6..] samples (see
+ *                @ref DWL_tenuEncoding). The indexes between the end of the previous chunk and the first one of a chunk
+ *                are not stored (skipped at a mount or overwritten during the download). The last chunk has no sample
+ *              - Acknowledgement (host): the number of the next expected chunk, the previous ones are received
+ *            A lost chunk is detected by the host with its number: the host sends a new request from the first
+ *            missing index (resume), a new request replaces the running download.
+ *            All the fields are little endian
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef DOWNLOAD_H_
+#define DOWNLOAD_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Download_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of the request imported by @ref DWL_enuImportRequest:
+ *          - [0..3]  Index of the first sample (the oldest stored one if it is older)
+ *          - [4..7]  Number of samples (limited to the end of the log, 0 stops the running download)
+ *          - [8]     Window, number of chunks sent without acknowledgement (0 or greater than
+ *                    @ref DWL_CONFIG_MAX_WINDOW = @ref DWL_CONFIG_MAX_WINDOW)
+ *          - [9]     Encoding of the samples (see @ref DWL_tenuEncoding)
+ */
+#define DWL_REQUEST_SIZE                                    10
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the range record exported by @ref DWL_u8ExportRange:
+ *          - [0..3]    Index of the oldest sample of the log
+ *          - [4..7]    Index of the next sample of the log
+ *          - [8..11]   Index of the first sample of the download
+ *          - [12..15]  Number of samples of the download (0 = no download)
+ *          - [16]      Number of the first chunk
+ *          - [17]      Window
+ */
+#define DWL_RANGE_RECORD_SIZE                               18
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the header of a chunk, before the samples
+ */
+#define DWL_CHUNK_HEADER_SIZE                               6
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum DWL_tenuStatus
+{
+  DWL_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  DWL_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  DWL_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  DWL_eSTATUS_INVALID_REQUEST,                                    //!< The request has a wrong size or encoding
+  DWL_eSTATUS_COUNT                                               //!< The total number of return code
+}DWL_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to list the encodings of the samples of a chunk
+ */
+typedef enum DWL_tenuEncoding
+{
+  DWL_eENCODING_BEGIN                                       = -1,
+  DWL_eENCODING_RAW,                                              //!< 2 bytes per sample
+  DWL_eENCODING_DELTA,                                            //!< First sample on 2 bytes, then its delta to the
+                                                                  //!< previous one on 1 byte (-127 to 127) or 0x80
+                                                                  //!< followed by the sample on 2 bytes
+  DWL_eENCODING_END
+}DWL_tenuEncoding;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the module (no download)
+ */
+void DWL_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to start a download, the running one is stopped
+ * @details See @ref DWL_REQUEST_SIZE for the format of the request
+ * @param[in]   kpku8Buffer: Pointer to the request
+ * @param[in] ku16BufferSize: Size of the request
+ * @return The status of the request, the running download is kept if the request is invalid
+ */
+DWL_tenuStatus DWL_enuImportRequest(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the range of the download, the answer to a request
+ * @details See @ref DWL_RANGE_RECORD_SIZE for the format of the record
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t DWL_u8ExportRange(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to acknowledge the chunks received by the host
+ * @remark The function only writes a byte: it can be called from the reception interrupt, the window then moves
+ *         during @ref DWL_vidProcess
+ * @param[in] ku8NextChunk: The number of the next chunk expected by the host (ignored if it is not sent yet)
+ */
+void DWL_vidAcknowledge(const uint8_t ku8NextChunk);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send the chunks allowed by the window (main loop)
+ * @remark The log is read from the EEPROM: the function is best called just before NVL_vidProcess
+ */
+void DWL_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // DOWNLOAD_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -53,14 +53,16 @@ static const LCD_tstrLcdConfig LCD_kastrLcdConfigList[LCD_eDEVICE_ID_END] =
 {
   [LCD_eDEVICE_ID_DISPLAY]                                  =
   {
-    .bEnable                                                = true,
-    .u8I2cSlaveAddress                                      = 0x27,
-    .enuI2cInstance                                         = I2CM_I2C_ID0,
-    .u8NumberOfColums                                       = 20,
-    .u8NumberOfRows                                         = 4,
-    .u8EnableBacklight                                      = true,
-    .u8EnableBlink                                          = false,
-    .u8EnableCursor                                         = false,
+    .bEnable                                                = LCD_CONFIG_DISPLAY_ENABLE,
+    .u8I2cSlaveAddress                                      = LCD_CONFIG_DISPLAY_I2C_SLAVE_ADDRESS,
+    .enuI2cInstance                                         = LCD_CONFIG_DISPLAY_I2C_INSTANCE,
+    .u8NumberOfColums                                       = LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS,
+    .u8NumberOfRows                                         = LCD_CONFIG_DISPLAY_NUMBER_OF_ROWS,
+    .u8EnableBacklight                                      = LCD_CONFIG_DISPLAY_ENABLE_BACKLIGHT,
+    .u8EnableBlink                                          = LCD_CONFIG_DISPLAY_ENABLE_BLINK,
+    .u8EnableCursor                                         = LCD_CONFIG_DISPLAY_ENABLE_CURSOR,
+    .bDeferredRendering                                     = LCD_CONFIG_DISPLAY_DEFERRED_RENDERING,
+    .u16RefreshPeriodMs                                     = LCD_CONFIG_DISPLAY_REFRESH_PERIOD_MS,
   },
 };
 
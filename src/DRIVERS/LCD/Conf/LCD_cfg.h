@@ -36,6 +36,69 @@
 /**********************************************************************************************************************/
 /* MACROS, CONFIGURATIONS                                                                                             */
 /**********************************************************************************************************************/
+/**
+ * @brief Settings of the display @ref LCD_eDEVICE_ID_DISPLAY (see @ref LCD_tstrLcdConfig)
+ */
+#define LCD_CONFIG_DISPLAY_ENABLE                           true
+#define LCD_CONFIG_DISPLAY_I2C_INSTANCE                     I2CM_I2C_ID0
+#define LCD_CONFIG_DISPLAY_I2C_SLAVE_ADDRESS                0x27
+#define LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS                20
+#define LCD_CONFIG_DISPLAY_NUMBER_OF_ROWS                   4
+#define LCD_CONFIG_DISPLAY_ENABLE_BACKLIGHT                 true
+#define LCD_CONFIG_DISPLAY_ENABLE_BLINK                     false
+#define LCD_CONFIG_DISPLAY_ENABLE_CURSOR                    false
+#define LCD_CONFIG_DISPLAY_DEFERRED_RENDERING               true
+#define LCD_CONFIG_DISPLAY_REFRESH_PERIOD_MS                100
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines whether the driver is specialized for the only display @ref LCD_eDEVICE_ID_DISPLAY or not
+ * @details When set to "true", the settings LCD_CONFIG_DISPLAY_xxx are used as constants by the driver instead of the
+ *          configuration table (no lookup per call nor per I2C byte). Set it to "false" when several displays are
+ *          declared in @ref LCD_tenuDeviceId.
+ */
+#define LCD_CONFIG_SINGLE_DISPLAY_BUILD                     true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Number of displays declared in @ref LCD_tenuDeviceId
+ * @details Shall be kept equal to @ref LCD_eDEVICE_ID_END: the preprocessor cannot evaluate the enumeration, this value
+ *          is used to check the configuration at compile time.
+ */
+#define LCD_CONFIG_NUMBER_OF_DISPLAYS                       1
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Largest geometry among all the displays declared in the configuration
+ * @details Used to size the static buffers of the driver at compile time, thus no heap is needed
+ */
+#define LCD_CONFIG_MAX_NUMBER_OF_COLUMNS                    LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS
+#define LCD_CONFIG_MAX_NUMBER_OF_ROWS                       LCD_CONFIG_DISPLAY_NUMBER_OF_ROWS
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define LCD_RENDER_SCHEDULER_ROUND_ROBIN                    0  //!< @attention Don't change this macro definition >
+#define LCD_RENDER_SCHEDULER_DEADLINE                       1  //!< @attention Don't change this macro definition >
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines how @ref LCD_vidProcess chooses the display to render among the deferred ones
+ * @details - @ref LCD_RENDER_SCHEDULER_ROUND_ROBIN: the displays with a pending frame are served in turn
+ *          - @ref LCD_RENDER_SCHEDULER_DEADLINE: the display whose frame deadline is the closest is served first
+ */
+#define LCD_CONFIG_RENDER_SCHEDULER                         LCD_RENDER_SCHEDULER_DEADLINE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the time (in us) that a call of @ref LCD_vidProcess may spend on the I2C bus
+ * @details A frame which does not fit is continued at the next call, at least one cell is sent per call
+ */
+#define LCD_CONFIG_RENDER_SLICE_US                          5000UL
 
 
 
@@ -44,6 +107,7 @@
 /**********************************************************************************************************************/
 /**
  * @brief Enumeration used to declare each LCD to handle them through the publics APIs of the driver.
+ * @note Update @ref LCD_CONFIG_NUMBER_OF_DISPLAYS when adding or removing a display.
  */
 typedef enum LCD_tenuDeviceId
 {
@@ -73,6 +137,8 @@ typedef struct LCD_tstrLcdConfig
   uint8_t                                                   u8EnableBacklight;  //!< Is the backlight has to be enabled at the startup
   uint8_t                                                   u8EnableBlink;      //!< Is the cursor blink has to be enabled at the startup
   uint8_t                                                   u8EnableCursor;     //!< Is the cursor has to be enabled at the startup
+  bool                                                      bDeferredRendering; //!< If the writes are only buffered and sent by @ref LCD_vidProcess
+  uint16_t                                                  u16RefreshPeriodMs; //!< The minimal period between 2 frames of a deferred display
 }LCD_tstrLcdConfig;
 
 
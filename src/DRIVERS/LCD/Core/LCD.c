@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include "I2CM.h"
+#include "TIMER.h"
 #include "LCD.h"
 
 
@@ -98,6 +99,95 @@
 #define LCD_RS                                              0b00000001  // Register select bit
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+// Character codes of the display ROM (A00) and of the CGRAM:
+#define LCD_u8CHAR_BLANK                                    ' '
+#define LCD_u8CHAR_FULL_BLOCK                               0xFF
+#define LCD_u8GLYPH_LINE_MASK                               0x1F  //!< Only the 5 right Bits of a glyph line are used
+#define LCD_u8GLYPH_ADDRESS_SHIFT                           3     //!< CGRAM address of a slot: (slot << 3)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Value of a shadow DDRAM cell whose content is unknown (a write has failed), it never matches a wanted content
+ */
+#define LCD_u8CHAR_UNKNOWN                                  0xFE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// DDRAM organization in 2 lines mode (the rows 3 and 4 of a 4 rows display are the continuation of the lines 1 and 2):
+#define LCD_u8DDRAM_LINE_LENGTH                             40
+#define LCD_u8DDRAM_LINE_2_ADDRESS                          0x40
+#define LCD_DDRAM_SIZE                                      (2 * LCD_u8DDRAM_LINE_LENGTH)
+#define LCD_u8DDRAM_ADDRESS_UNKNOWN                         0xFF  //!< The address of the display is unknown (after a CGRAM write)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Checks the value of the setting LCD_CONFIG_RENDER_SCHEDULER
+ */
+#if((LCD_CONFIG_RENDER_SCHEDULER != LCD_RENDER_SCHEDULER_ROUND_ROBIN) && (LCD_CONFIG_RENDER_SCHEDULER != LCD_RENDER_SCHEDULER_DEADLINE))
+#error "[LCD ] Error: LCD_CONFIG_RENDER_SCHEDULER shall be LCD_RENDER_SCHEDULER_ROUND_ROBIN or LCD_RENDER_SCHEDULER_DEADLINE"
+#endif //LCD_CONFIG_RENDER_SCHEDULER
+
+#if((LCD_CONFIG_SINGLE_DISPLAY_BUILD == true) && (LCD_CONFIG_NUMBER_OF_DISPLAYS != 1))
+#error "[LCD ] Error: LCD_CONFIG_SINGLE_DISPLAY_BUILD shall be false when several displays are declared"
+#endif //LCD_CONFIG_SINGLE_DISPLAY_BUILD
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Accesses to the configuration and to the dynamic database of a display
+ * @details In the single display build, the settings of @ref LCD_eDEVICE_ID_DISPLAY are folded as constants in the
+ *          code: no lookup of the configuration table and no index computation, the branches of the unused rendering
+ *          mode are removed by the compiler. The device ID is still consumed (cast to void) so the callers do not raise
+ *          unused parameter warnings.
+ */
+#if(LCD_CONFIG_SINGLE_DISPLAY_BUILD == true)
+#define LCD_mCONFIG(_ID_, _FIELD_)                          ((void)(_ID_), LCD_SINGLE_##_FIELD_)
+#define LCD_mDATA(_ID_)                                     (*((void)(_ID_), &LCD_astrDisplayData[0]))
+#define LCD_mIS_DEVICE_ID_VALID(_ID_)                       ((_ID_) == LCD_eDEVICE_ID_DISPLAY)
+
+#define LCD_SINGLE_bEnable                                  LCD_CONFIG_DISPLAY_ENABLE
+#define LCD_SINGLE_enuI2cInstance                           LCD_CONFIG_DISPLAY_I2C_INSTANCE
+#define LCD_SINGLE_u8I2cSlaveAddress                        LCD_CONFIG_DISPLAY_I2C_SLAVE_ADDRESS
+#define LCD_SINGLE_u8NumberOfColums                         LCD_CONFIG_DISPLAY_NUMBER_OF_COLUMNS
+#define LCD_SINGLE_u8NumberOfRows                           LCD_CONFIG_DISPLAY_NUMBER_OF_ROWS
+#define LCD_SINGLE_u8EnableBacklight                        LCD_CONFIG_DISPLAY_ENABLE_BACKLIGHT
+#define LCD_SINGLE_u8EnableBlink                            LCD_CONFIG_DISPLAY_ENABLE_BLINK
+#define LCD_SINGLE_u8EnableCursor                           LCD_CONFIG_DISPLAY_ENABLE_CURSOR
+#define LCD_SINGLE_bDeferredRendering                       LCD_CONFIG_DISPLAY_DEFERRED_RENDERING
+#define LCD_SINGLE_u16RefreshPeriodMs                       LCD_CONFIG_DISPLAY_REFRESH_PERIOD_MS
+#else
+#define LCD_mCONFIG(_ID_, _FIELD_)                          (LCD_kpkstrGetLcdConfig(_ID_)->_FIELD_)
+#define LCD_mDATA(_ID_)                                     (LCD_astrDisplayData[(_ID_)])
+#define LCD_mIS_DEVICE_ID_VALID(_ID_)                       bIsDeviceIdValid(_ID_)
+#endif //LCD_CONFIG_SINGLE_DISPLAY_BUILD
+
+#define LCD_mIS_DEFERRED(_ID_)                              LCD_mCONFIG((_ID_), bDeferredRendering)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the buffer used to format the data before a print: the whole largest display plus the '\0' ending
+ *        vsnprintf
+ */
+#define LCD_FORMAT_BUFFER_SIZE                              ((LCD_CONFIG_MAX_NUMBER_OF_ROWS * LCD_CONFIG_MAX_NUMBER_OF_COLUMNS) + 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Checks the values of the settings LCD_CONFIG_MAX_NUMBER_OF_xxx
+ */
+#if((LCD_CONFIG_MAX_NUMBER_OF_ROWS == 0) || (LCD_CONFIG_MAX_NUMBER_OF_ROWS > 4))
+#error "[LCD ] Error: LCD_CONFIG_MAX_NUMBER_OF_ROWS shall be in the range [1 ; 4]"
+#endif //LCD_CONFIG_MAX_NUMBER_OF_ROWS
+
+#if((LCD_CONFIG_MAX_NUMBER_OF_COLUMNS == 0) || (LCD_CONFIG_MAX_NUMBER_OF_COLUMNS > 40))
+#error "[LCD ] Error: LCD_CONFIG_MAX_NUMBER_OF_COLUMNS shall be in the range [1 ; 40]"
+#endif //LCD_CONFIG_MAX_NUMBER_OF_COLUMNS
+
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -110,10 +200,25 @@ typedef struct tstrDisplayData
   uint8_t                                                   u8DisplayMode;      //!< The current mode of the display.
   uint8_t                                                   u8BacklightLevel;   //!< Is the display has its backlight enabled or not.
   uint8_t                                                   u8DisplayFunction;  //!< The current functions of the display.
-  uint8_t                                                   u8CurrentColumnPos; //!< The current column position of the display.
-  uint8_t                                                   u8CurrentRowPos;    //!< The current row position of the display.
-  uint8_t*                                                  pau8DataBuffer;     //!< Pointer to the data buffer used to format the data before a print
-  uint16_t                                                  u16DataSize;        //!< The size of the data buffer
+  uint8_t                                                   u8DdramAddress;     //!< The current DDRAM address (cursor position) of the display.
+  uint8_t                                                   au8DdramShadow[LCD_DDRAM_SIZE]; //!< Copy of the DDRAM content of the display
+  uint8_t                                                   aau8GlyphBitmaps[LCD_GLYPH_SLOT_COUNT][LCD_GLYPH_HEIGHT]; //!< The glyphs loaded in the CGRAM
+  uint8_t                                                   au8GlyphLruOrder[LCD_GLYPH_SLOT_COUNT]; //!< The CGRAM slots, the most recently used first
+  uint8_t                                                   u8GlyphSlotsUsed;   //!< The number of CGRAM slots loaded (from the slot 0)
+  uint8_t                                                   au8Frame[LCD_DDRAM_SIZE]; //!< The wanted DDRAM content of a deferred display
+  uint8_t                                                   u8FrameAddress;     //!< The cursor position in the frame of a deferred display
+  uint8_t                                                   u8GlyphsToLoad;     //!< The CGRAM slots to be sent by the next frame (1 Bit per slot)
+  bool                                                      bClearRequested;    //!< If the next frame starts with the "Clear display" command
+  bool                                                      bFrameDirty;        //!< If the frame has been written since the start of the last rendering
+  bool                                                      bFrameInProgress;   //!< If a rendering is interrupted at the end of its time slice
+  uint8_t                                                   u8RenderColumn;     //!< The next cell to be compared by the rendering
+  uint8_t                                                   u8RenderRow;        //!< The next cell to be compared by the rendering
+  uint32_t                                                  u32DirtySinceUs;    //!< The time of the first write after the start of the last rendering
+  uint32_t                                                  u32FrameStartUs;    //!< The start time of the last rendering
+  uint32_t                                                  u32DeadlineUs;      //!< The deadline of the rendering in progress
+  uint32_t                                                  u32FrameBusUs;      //!< The bus time spent by the rendering in progress
+  uint16_t                                                  u16FrameCells;      //!< The cells sent by the rendering in progress
+  LCD_tstrFrameStatistics                                   strStatistics;      //!< The statistics of the completed renderings
 }tstrDisplayData;
 
 
@@ -126,9 +231,25 @@ typedef struct tstrDisplayData
 static tstrDisplayData LCD_astrDisplayData[LCD_eDEVICE_ID_END] = { 0 };
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The buffer used to format the data before a print, shared by all the displays since it is only used during
+ *        a call of @ref LCD_enuPrintf
+ */
+static char LCD_as8FormatBuffer[LCD_FORMAT_BUFFER_SIZE];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The last display served by @ref LCD_vidProcess, the search of the next one starts after it
+ */
+static LCD_tenuDeviceId LCD_enuLastRenderedId = LCD_eDEVICE_ID_BEGIN;
+
+
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
 /**********************************************************************************************************************/
+#if(LCD_CONFIG_SINGLE_DISPLAY_BUILD == false)
 /**
  * @brief Function used to check if a LCD device ID is in a valid range or not
  * @param[in] kenuDeviceId The LCD device ID to be checked
@@ -136,6 +257,7 @@ static tstrDisplayData LCD_astrDisplayData[LCD_eDEVICE_ID_END] = { 0 };
  *         otherwise
 */
 static bool bIsDeviceIdValid(const LCD_tenuDeviceId kenuDeviceId);
+#endif //LCD_CONFIG_SINGLE_DISPLAY_BUILD
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -211,6 +333,160 @@ static bool bSendData(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Data
 static bool bWriteText(const LCD_tenuDeviceId kenuDeviceId, const char *kps8Text, const uint16_t ku16TextLength);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send a character to the LCD at the current position, the position is updated.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]      ku8Char The character code to be printed
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bWriteChar(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Char);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send a character at the current DDRAM address of the display.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]      ku8Char The character code to be sent.
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bSendChar(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Char);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the DDRAM address following an address, as the display does after a data write.
+ * @param[in] ku8Address The DDRAM address.
+ * @return The next DDRAM address.
+ */
+static uint8_t u8GetNextAddress(const uint8_t ku8Address);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the content that the writes have to be compared with: the frame of a deferred display,
+ *        the copy of the DDRAM otherwise.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @return The content indexed as the DDRAM (see @ref u8GetShadowIndex).
+ */
+static uint8_t *pu8GetContent(const LCD_tenuDeviceId kenuDeviceId);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to mark the frame of a deferred display as to be rendered.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ */
+static void vidMarkFrameDirty(const LCD_tenuDeviceId kenuDeviceId);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to move the write position, the command is sent only if the display is not already there.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]   ku8Address The DDRAM address to be set.
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bMoveCursor(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Address);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to set the DDRAM address of the display, the command is sent only if it is not already there.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]   ku8Address The DDRAM address to be set.
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bSetDdramAddress(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Address);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send a glyph of the CGRAM cache to the display.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]       ku8Slot The CGRAM slot to be sent.
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bUploadGlyph(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Slot);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to check if a deferred display has a frame to be rendered now.
+ * @param[in]   kenuDeviceId The ID of the LCD.
+ * @param[in]        ku32NowUs The current time.
+ * @param[out] kpu32DeadlineUs The deadline of the frame.
+ * @return Return "true" if the display has to be rendered, return "false" otherwise.
+ */
+static bool bIsRenderDue(const LCD_tenuDeviceId kenuDeviceId, const uint32_t ku32NowUs, uint32_t * const kpu32DeadlineUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to render a time slice of the frame of a deferred display.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ */
+static void vidRenderSlice(const LCD_tenuDeviceId kenuDeviceId);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the DDRAM address of a cell of the display.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ku8Column The column of the cell (from 0).
+ * @param[in]       ku8Row The row of the cell (from 0).
+ * @return The DDRAM address of the cell.
+ */
+static uint8_t u8GetDdramAddress(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Column, const uint8_t ku8Row);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the index in the shadow DDRAM of a DDRAM address.
+ * @param[in] ku8Address The DDRAM address.
+ * @return The index in @ref tstrDisplayData.au8DdramShadow.
+ */
+static uint8_t u8GetShadowIndex(const uint8_t ku8Address);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to blank a region of the display, only the cells which are not already blank are written.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ku8Column The left column of the region (from 0).
+ * @param[in]       ku8Row The top row of the region (from 0).
+ * @param[in]     ku8Width The number of columns of the region.
+ * @param[in]    ku8Height The number of rows of the region.
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bClearRegion(const LCD_tenuDeviceId kenuDeviceId,
+                         const uint8_t ku8Column,
+                         const uint8_t ku8Row,
+                         const uint8_t ku8Width,
+                         const uint8_t ku8Height);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the CGRAM slot of a glyph, the glyph is loaded in the least recently used slot if it is
+ *        not already in the CGRAM.
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]  kpku8Bitmap The pixel lines of the glyph
+ * @param[out]   pu8Slot The slot holding the glyph (which is also its character code)
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bGetGlyphSlot(const LCD_tenuDeviceId kenuDeviceId, uint8_t const * const kpku8Bitmap, uint8_t * const pu8Slot);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to draw the cells of a trend graph whose content has changed.
+ * @param[in,out] kpstrGraph The graph to be drawn
+ * @return Return "true" if the function ran successfully, return "false" in the other cases.
+ */
+static bool bDrawTrendGraph(LCD_tstrTrendGraph * const kpstrGraph);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
  * @brief Set the display ON or OFF.
@@ -263,6 +539,7 @@ static bool bEnableBackLight(const LCD_tenuDeviceId kenuDeviceId, const bool kbE
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTION DEFINITIONS                                                                                       */
 /**********************************************************************************************************************/
+#if(LCD_CONFIG_SINGLE_DISPLAY_BUILD == false)
 static bool bIsDeviceIdValid(const LCD_tenuDeviceId kenuDeviceId)
 {
   bool bIsValid = false;
@@ -274,16 +551,16 @@ static bool bIsDeviceIdValid(const LCD_tenuDeviceId kenuDeviceId)
 
   return bIsValid;
 }
+#endif //LCD_CONFIG_SINGLE_DISPLAY_BUILD
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 static bool bSendToI2c(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Data)
 {
-  bool                    bStatus          = false;
-  uint8_t                 u8Message        = (ku8Data | LCD_astrDisplayData[kenuDeviceId].u8BacklightLevel);
-  LCD_tstrLcdConfig const *pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
+  bool    bStatus   = false;
+  uint8_t u8Message = (ku8Data | LCD_mDATA(kenuDeviceId).u8BacklightLevel);
 
-  if(I2CM_enuWriteBuffer(pkstrThisConfig->enuI2cInstance, pkstrThisConfig->u8I2cSlaveAddress, &u8Message, sizeof(u8Message)) == I2CM_eSTATUS_OK)
+  if(I2CM_enuWriteBuffer(LCD_mCONFIG(kenuDeviceId, enuI2cInstance), LCD_mCONFIG(kenuDeviceId, u8I2cSlaveAddress), &u8Message, sizeof(u8Message)) == I2CM_eSTATUS_OK)
   {
     bStatus = true;
   }
@@ -356,11 +633,14 @@ static bool bWriteText(const LCD_tenuDeviceId kenuDeviceId, const char *kps8Text
   uint8_t u16TextIndex = 0;
   bool    bExitLoop    = false;
 
-  CMN_vidDelayMs(CMN_1_MS);
+  if(!LCD_mIS_DEFERRED(kenuDeviceId))
+  {
+    CMN_vidDelayMs(CMN_1_MS);
+  }
 
   for(u16TextIndex = 0, bExitLoop = false; ((u16TextIndex < ku16TextLength) && (bExitLoop == false)); u16TextIndex++)
   {
-    bReturnCode = bSendData(kenuDeviceId, kps8Text[u16TextIndex]);
+    bReturnCode = bWriteChar(kenuDeviceId, (uint8_t)kps8Text[u16TextIndex]);
 
     if(!bReturnCode)
     {
@@ -373,73 +653,98 @@ static bool bWriteText(const LCD_tenuDeviceId kenuDeviceId, const char *kps8Text
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-static bool bSetDisplayOn(const LCD_tenuDeviceId kenuDeviceId, const bool bSetToOn)
+static bool bWriteChar(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Char)
 {
-  bool bReturnCode = false;
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+  bool            bReturnCode   = true;
 
-  if(bSetToOn)
+  if(LCD_mIS_DEFERRED(kenuDeviceId))
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl |= LCD_u8DISPLAY_ON;
+    pstrThisData->au8Frame[u8GetShadowIndex(pstrThisData->u8FrameAddress)] = ku8Char;
+    pstrThisData->u8FrameAddress = u8GetNextAddress(pstrThisData->u8FrameAddress);
+
+    vidMarkFrameDirty(kenuDeviceId);
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl &= ~LCD_u8DISPLAY_ON;
+    bReturnCode = bSendChar(kenuDeviceId, ku8Char);
   }
 
-  bReturnCode  = bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl));
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bSendChar(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Char)
+{
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+  bool            bReturnCode   = bSendData(kenuDeviceId, ku8Char);
+
+  pstrThisData->au8DdramShadow[u8GetShadowIndex(pstrThisData->u8DdramAddress)] = bReturnCode ? ku8Char : LCD_u8CHAR_UNKNOWN;
+  pstrThisData->u8DdramAddress = u8GetNextAddress(pstrThisData->u8DdramAddress);
 
   return bReturnCode;
 }
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-static bool bSetCursor(const LCD_tenuDeviceId kenuDeviceId, uint8_t u8Column, uint8_t u8Row)
+static uint8_t u8GetNextAddress(const uint8_t ku8Address)
 {
-  LCD_tstrLcdConfig const *pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
-  const uint8_t           kau8RowOffset[]  = { 0x00, 0x40, 0x14, 0x54 };
+  /* The DDRAM address is incremented by the display after each data write, from the end of a line to the next one */
+  uint8_t u8NextIdx = (uint8_t)((u8GetShadowIndex(ku8Address) + 1) % LCD_DDRAM_SIZE);
 
-  if(u8Column != 0)
-  {
-    u8Column--;
-  }
+  return (u8NextIdx < LCD_u8DDRAM_LINE_LENGTH) ?
+         u8NextIdx : (uint8_t)(LCD_u8DDRAM_LINE_2_ADDRESS + (u8NextIdx - LCD_u8DDRAM_LINE_LENGTH));
+}
 
-  if(u8Row != 0)
-  {
-    u8Row--;
-  }
 
-  if(u8Column > pkstrThisConfig->u8NumberOfColums)
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t *pu8GetContent(const LCD_tenuDeviceId kenuDeviceId)
+{
+  return LCD_mIS_DEFERRED(kenuDeviceId) ? LCD_mDATA(kenuDeviceId).au8Frame : LCD_mDATA(kenuDeviceId).au8DdramShadow;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidMarkFrameDirty(const LCD_tenuDeviceId kenuDeviceId)
+{
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+
+  if(!pstrThisData->bFrameDirty)
   {
-    u8Column = pkstrThisConfig->u8NumberOfColums;
+    pstrThisData->bFrameDirty     = true;
+    pstrThisData->u32DirtySinceUs = TIM1_u32GetTimestampUs();
   }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bMoveCursor(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Address)
+{
+  bool bReturnCode = true;
 
-  if(u8Row > pkstrThisConfig->u8NumberOfRows)
+  if(LCD_mIS_DEFERRED(kenuDeviceId))
   {
-    u8Row = pkstrThisConfig->u8NumberOfRows;
+    LCD_mDATA(kenuDeviceId).u8FrameAddress = ku8Address;
   }
-
-  if(u8Row >= sizeof(kau8RowOffset))
+  else
   {
-    u8Row = (sizeof(kau8RowOffset) - 1);
+    bReturnCode = bSetDdramAddress(kenuDeviceId, ku8Address);
   }
 
-  LCD_astrDisplayData[kenuDeviceId].u8CurrentColumnPos = u8Column;
-  LCD_astrDisplayData[kenuDeviceId].u8CurrentRowPos    = u8Row;
-
-  return bSendCommand(kenuDeviceId, (LCD_u8SET_DDRAM_ADDR | (u8Column + kau8RowOffset[u8Row])));
+  return bReturnCode;
 }
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-static bool bClearDisplay(const LCD_tenuDeviceId kenuDeviceId)
+static bool bSetDdramAddress(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Address)
 {
-  bool bReturnCode  = false;
+  bool bReturnCode = true;
 
-  if(bSendCommand(kenuDeviceId, LCD_u8CLEAR_DISPLAY))
+  if(LCD_mDATA(kenuDeviceId).u8DdramAddress != ku8Address)
   {
-    CMN_vidDelayMs(CMN_2_MS);
-
-    bReturnCode = bSetCursor(kenuDeviceId, 0, 0);
+    bReturnCode = bSendCommand(kenuDeviceId, (LCD_u8SET_DDRAM_ADDR | ku8Address));
+    LCD_mDATA(kenuDeviceId).u8DdramAddress = bReturnCode ? ku8Address : LCD_u8DDRAM_ADDRESS_UNKNOWN;
   }
 
   return bReturnCode;
@@ -447,126 +752,659 @@ static bool bClearDisplay(const LCD_tenuDeviceId kenuDeviceId)
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-static bool bReturnHome(const LCD_tenuDeviceId kenuDeviceId)
+static uint8_t u8GetDdramAddress(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Column, const uint8_t ku8Row)
 {
-  return bSendCommand(kenuDeviceId, LCD_u8RETURN_HOME);
+  const uint8_t kau8RowOffset[] =
+  {
+    0x00,
+    LCD_u8DDRAM_LINE_2_ADDRESS,
+    LCD_mCONFIG(kenuDeviceId, u8NumberOfColums),
+    (uint8_t)(LCD_u8DDRAM_LINE_2_ADDRESS + LCD_mCONFIG(kenuDeviceId, u8NumberOfColums))
+  };
+
+  return (uint8_t)(kau8RowOffset[ku8Row % sizeof(kau8RowOffset)] + ku8Column);
 }
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-static bool bEnableBackLight(const LCD_tenuDeviceId kenuDeviceId, const bool kbEnable)
+static uint8_t u8GetShadowIndex(const uint8_t ku8Address)
 {
-  if(kbEnable)
-  {
-    LCD_astrDisplayData[kenuDeviceId].u8BacklightLevel = LCD_u8BACKLIGHT;
-  }
-  else
+  uint8_t u8Index = (uint8_t)(ku8Address & ~LCD_u8DDRAM_LINE_2_ADDRESS);
+
+  if(ku8Address & LCD_u8DDRAM_LINE_2_ADDRESS)
   {
-    LCD_astrDisplayData[kenuDeviceId].u8BacklightLevel = LCD_u8NO_BACKLIGHT;
+    u8Index += LCD_u8DDRAM_LINE_LENGTH;
   }
 
-  return bSendToI2c(kenuDeviceId, 0);
+  return (uint8_t)(u8Index % LCD_DDRAM_SIZE);
 }
 
 
-/**********************************************************************************************************************/
-/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
-/**********************************************************************************************************************/
-void LCD_vidInitialize(void)
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bClearRegion(const LCD_tenuDeviceId kenuDeviceId,
+                         const uint8_t ku8Column,
+                         const uint8_t ku8Row,
+                         const uint8_t ku8Width,
+                         const uint8_t ku8Height)
 {
-  bool                    bCommandStatus   = false;
-  LCD_tenuDeviceId        enuLcdId         = 0;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
-  tstrDisplayData         *pstrThisData    = NULL;
-
-  CMN_vidDelayMs(CMN_50_MS);
+  uint8_t const *pu8Content   = pu8GetContent(kenuDeviceId);
+  bool          bReturnCode   = true;
+  uint8_t       u8RowIdx      = 0;
+  uint8_t       u8ColumnIdx   = 0;
+  uint8_t       u8Address     = 0;
 
-  for(enuLcdId = 0; enuLcdId < LCD_eDEVICE_ID_END; enuLcdId++)
+  for(u8RowIdx = ku8Row; ((u8RowIdx < (ku8Row + ku8Height)) && bReturnCode); u8RowIdx++)
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(enuLcdId);
-    CMN_assert(pkstrThisConfig != NULL);
-
-    if(pkstrThisConfig->bEnable)
+    for(u8ColumnIdx = ku8Column; ((u8ColumnIdx < (ku8Column + ku8Width)) && bReturnCode); u8ColumnIdx++)
     {
-      pstrThisData = &LCD_astrDisplayData[enuLcdId];
-      CMN_assert(pstrThisData != NULL);
+      u8Address = u8GetDdramAddress(kenuDeviceId, u8ColumnIdx, u8RowIdx);
 
-      pstrThisData->u8DisplayMode = (LCD_u8ENTRY_LEFT | LCD_u8ENTRY_SHIFT_DECREMENT);
-
-      if(pkstrThisConfig->u8EnableBacklight)
-      {
-        pstrThisData->u8BacklightLevel = LCD_u8BACKLIGHT;
-      }
-      else
+      if(pu8Content[u8GetShadowIndex(u8Address)] != LCD_u8CHAR_BLANK)
       {
-        pstrThisData->u8BacklightLevel = LCD_u8NO_BACKLIGHT;
+        /* The cursor is moved only if the cell does not follow the last written one */
+        bReturnCode = (bMoveCursor(kenuDeviceId, u8Address) && bWriteChar(kenuDeviceId, LCD_u8CHAR_BLANK));
       }
-
-      bCommandStatus = bSendToI2c(enuLcdId, 0);
-      CMN_assert(bCommandStatus == true);
-
-      pstrThisData->u8DisplayControl  |= (pkstrThisConfig->u8EnableBlink ? LCD_u8BLINK_ON : LCD_u8BLINK_OFF);
-      pstrThisData->u8DisplayControl  |= (pkstrThisConfig->u8EnableCursor ? LCD_u8CURSOR_ON : LCD_u8CURSOR_OFF);
-      pstrThisData->u8DisplayFunction |= (LCD_u82LINE | LCD_u84BIT_MODE | LCD_u85x8_DOTS);
-
-      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
-      CMN_assert(bCommandStatus == true);
-      CMN_vidDelayMs(CMN_5_MS);
-      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
-      CMN_assert(bCommandStatus == true);
-      CMN_vidDelayMs(CMN_5_MS);
-      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
-      CMN_assert(bCommandStatus == true);
-      CMN_vidDelayMs(CMN_5_MS);
-      bCommandStatus = bWrite4Bits(enuLcdId, 0x02 << 4);
-      CMN_assert(bCommandStatus == true);
-      CMN_vidDelayMs(CMN_5_MS);
-      bCommandStatus = bSendCommand(enuLcdId, (pstrThisData->u8DisplayFunction | LCD_u8FUNCTION_SET));
-      CMN_assert(bCommandStatus == true);
-      bCommandStatus = bSendCommand(enuLcdId, (LCD_u8DISPLAY_CONTROL | pstrThisData->u8DisplayControl));
-      bCommandStatus = bSetDisplayOn(enuLcdId, true);
-      CMN_assert(bCommandStatus == true);
-      bCommandStatus = bClearDisplay(enuLcdId);
-      CMN_assert(bCommandStatus == true);
-      bCommandStatus = bSendCommand(enuLcdId, (pstrThisData->u8DisplayMode | LCD_u8ENTRY_MODE_SET));
-      CMN_assert(bCommandStatus == true);
-      bCommandStatus = bReturnHome(enuLcdId);
-      CMN_assert(bCommandStatus == true);
-
-      pstrThisData->u16DataSize    = (pkstrThisConfig->u8NumberOfRows * pkstrThisConfig->u8NumberOfColums);
-      pstrThisData->pau8DataBuffer = malloc(pstrThisData->u16DataSize * sizeof(uint8_t));
-      CMN_assert(pstrThisData->pau8DataBuffer != NULL);
-
-      memset(pstrThisData->pau8DataBuffer, 0, pstrThisData->u16DataSize);
     }
   }
-}
 
+  /* The cursor is left at the top left cell of the region */
+  if(bReturnCode)
+  {
+    bReturnCode = bMoveCursor(kenuDeviceId, u8GetDdramAddress(kenuDeviceId, ku8Column, ku8Row));
+  }
 
-/*--------------------------------------------------------------------------------------------------------------------*/
-bool LCD_bIsDeviceIdValid(const LCD_tenuDeviceId kenuDeviceId)
-{
-  return bIsDeviceIdValid(kenuDeviceId);
+  return bReturnCode;
 }
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
-LCD_tenuStatus LCD_enuSetBacklightOn(const LCD_tenuDeviceId kenuDeviceId)
+static bool bGetGlyphSlot(const LCD_tenuDeviceId kenuDeviceId, uint8_t const * const kpku8Bitmap, uint8_t * const pu8Slot)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
-
-  if(!bIsDeviceIdValid(kenuDeviceId))
-  {
-    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
-  }
-  else
+  bool            bReturnCode  = true;
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+  uint8_t         u8Slot       = LCD_GLYPH_SLOT_COUNT;
+  uint8_t         u8SlotIdx    = 0;
+  uint8_t         u8OrderIdx   = 0;
+  uint8_t         u8LineIdx    = 0;
+  uint8_t         u8Address    = 0;
+  bool            bIsSame      = false;
+
+  /* Is the glyph already in the CGRAM? The stored lines only keep the pixels of the glyph */
+  for(u8SlotIdx = 0; ((u8SlotIdx < pstrThisData->u8GlyphSlotsUsed) && (u8Slot == LCD_GLYPH_SLOT_COUNT)); u8SlotIdx++)
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
+    bIsSame = true;
 
-    if(!pkstrThisConfig->bEnable)
+    for(u8LineIdx = 0; ((u8LineIdx < LCD_GLYPH_HEIGHT) && bIsSame); u8LineIdx++)
     {
-      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+      bIsSame = (pstrThisData->aau8GlyphBitmaps[u8SlotIdx][u8LineIdx] == (kpku8Bitmap[u8LineIdx] & LCD_u8GLYPH_LINE_MASK));
+    }
+
+    if(bIsSame)
+    {
+      u8Slot = u8SlotIdx;
+    }
+  }
+
+  if(u8Slot == LCD_GLYPH_SLOT_COUNT)
+  {
+    /* Loaded in a free slot if any, in the least recently used one otherwise */
+    if(pstrThisData->u8GlyphSlotsUsed < LCD_GLYPH_SLOT_COUNT)
+    {
+      u8Slot = pstrThisData->u8GlyphSlotsUsed;
+      pstrThisData->u8GlyphSlotsUsed++;
+    }
+    else
+    {
+      u8Slot = pstrThisData->au8GlyphLruOrder[LCD_GLYPH_SLOT_COUNT - 1];
+    }
+
+    for(u8LineIdx = 0; u8LineIdx < LCD_GLYPH_HEIGHT; u8LineIdx++)
+    {
+      pstrThisData->aau8GlyphBitmaps[u8Slot][u8LineIdx] = (kpku8Bitmap[u8LineIdx] & LCD_u8GLYPH_LINE_MASK);
+    }
+
+    if(LCD_mIS_DEFERRED(kenuDeviceId))
+    {
+      /* Sent at the start of the next frame */
+      pstrThisData->u8GlyphsToLoad |= (uint8_t)(1U << u8Slot);
+      vidMarkFrameDirty(kenuDeviceId);
+    }
+    else
+    {
+      u8Address   = pstrThisData->u8DdramAddress;
+      bReturnCode = bUploadGlyph(kenuDeviceId, u8Slot);
+
+      if(u8Address != LCD_u8DDRAM_ADDRESS_UNKNOWN)
+      {
+        /* Back to the DDRAM at the current position */
+        bReturnCode = (bSetDdramAddress(kenuDeviceId, u8Address) && bReturnCode);
+      }
+      else
+      {
+        /* The position was already lost: back to the DDRAM at the top left cell, so that the next character is not
+           written in the CGRAM, and the write of the glyph fails */
+        (void)bSetDdramAddress(kenuDeviceId, u8GetDdramAddress(kenuDeviceId, 0, 0));
+        bReturnCode = false;
+      }
+    }
+  }
+
+  /* The slot becomes the most recently used one */
+  for(u8OrderIdx = 0; ((u8OrderIdx < (LCD_GLYPH_SLOT_COUNT - 1)) && (pstrThisData->au8GlyphLruOrder[u8OrderIdx] != u8Slot)); u8OrderIdx++);
+
+  for(; u8OrderIdx > 0; u8OrderIdx--)
+  {
+    pstrThisData->au8GlyphLruOrder[u8OrderIdx] = pstrThisData->au8GlyphLruOrder[u8OrderIdx - 1];
+  }
+
+  pstrThisData->au8GlyphLruOrder[0] = u8Slot;
+
+  *pu8Slot = u8Slot;
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bUploadGlyph(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Slot)
+{
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+  bool            bReturnCode   = bSendCommand(kenuDeviceId, (LCD_u8SET_CG_RAMADDR | (ku8Slot << LCD_u8GLYPH_ADDRESS_SHIFT)));
+  uint8_t         u8LineIdx     = 0;
+
+  for(u8LineIdx = 0; ((u8LineIdx < LCD_GLYPH_HEIGHT) && bReturnCode); u8LineIdx++)
+  {
+    bReturnCode = bSendData(kenuDeviceId, pstrThisData->aau8GlyphBitmaps[ku8Slot][u8LineIdx]);
+  }
+
+  if(!bReturnCode)
+  {
+    /* The content of the slot is unknown: it can't be matched anymore */
+    memset(pstrThisData->aau8GlyphBitmaps[ku8Slot], CMN_8_BITMASK_FULL, LCD_GLYPH_HEIGHT);
+  }
+
+  /* The display is now writing in the CGRAM */
+  pstrThisData->u8DdramAddress = LCD_u8DDRAM_ADDRESS_UNKNOWN;
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bIsRenderDue(const LCD_tenuDeviceId kenuDeviceId, const uint32_t ku32NowUs, uint32_t * const kpu32DeadlineUs)
+{
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kenuDeviceId);
+  const uint32_t  ku32PeriodUs  = ((uint32_t)LCD_mCONFIG(kenuDeviceId, u16RefreshPeriodMs) * 1000UL);
+  uint32_t        u32ReleaseUs  = 0;
+  bool            bIsDue        = false;
+
+  if(pstrThisData->bFrameInProgress)
+  {
+    *kpu32DeadlineUs = pstrThisData->u32DeadlineUs;
+    bIsDue           = true;
+  }
+  else if(pstrThisData->bFrameDirty)
+  {
+    /* A frame may start one period after the previous one, and not before its first write */
+    u32ReleaseUs = (pstrThisData->u32FrameStartUs + ku32PeriodUs);
+
+    if((int32_t)(pstrThisData->u32DirtySinceUs - u32ReleaseUs) > 0)
+    {
+      u32ReleaseUs = pstrThisData->u32DirtySinceUs;
+    }
+
+    *kpu32DeadlineUs = (u32ReleaseUs + ku32PeriodUs);
+    bIsDue           = ((int32_t)(ku32NowUs - u32ReleaseUs) >= 0);
+  }
+
+  return bIsDue;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidRenderSlice(const LCD_tenuDeviceId kenuDeviceId)
+{
+  tstrDisplayData         *pstrThisData    = &LCD_mDATA(kenuDeviceId);
+  LCD_tstrFrameStatistics *pstrStatistics  = &pstrThisData->strStatistics;
+  const uint32_t          ku32SliceStartUs = TIM1_u32GetTimestampUs();
+  uint32_t                u32NowUs         = ku32SliceStartUs;
+  bool                    bReturnCode      = true;
+  uint8_t                 u8SlotIdx        = 0;
+  uint8_t                 u8Address        = 0;
+  uint8_t                 u8ShadowIdx      = 0;
+
+  if(!pstrThisData->bFrameInProgress)
+  {
+    /* The writes done from now are for the next frame */
+    pstrThisData->bFrameInProgress = true;
+    pstrThisData->bFrameDirty      = false;
+    pstrThisData->u32FrameStartUs  = ku32SliceStartUs;
+    pstrThisData->u32FrameBusUs    = 0;
+    pstrThisData->u16FrameCells    = 0;
+    pstrThisData->u8RenderColumn   = 0;
+    pstrThisData->u8RenderRow      = 0;
+  }
+
+  if(pstrThisData->bClearRequested)
+  {
+    pstrThisData->bClearRequested = false;
+    bReturnCode = bClearDisplay(kenuDeviceId);
+    u32NowUs    = TIM1_u32GetTimestampUs();
+  }
+
+  /* The glyphs first since the cells of the frame may use them, one glyph is sent at least */
+  for(u8SlotIdx = 0; ((u8SlotIdx < LCD_GLYPH_SLOT_COUNT) && ((u32NowUs - ku32SliceStartUs) < LCD_CONFIG_RENDER_SLICE_US)); u8SlotIdx++)
+  {
+    if(pstrThisData->u8GlyphsToLoad & (1U << u8SlotIdx))
+    {
+      pstrThisData->u8GlyphsToLoad &= (uint8_t)~(1U << u8SlotIdx);
+      bReturnCode = (bUploadGlyph(kenuDeviceId, u8SlotIdx) && bReturnCode);
+      u32NowUs    = TIM1_u32GetTimestampUs();
+    }
+  }
+
+  /* Then only the cells which differ from the display are sent, until the end of the time slice */
+  while((pstrThisData->u8GlyphsToLoad == 0) &&
+        (pstrThisData->u8RenderRow < LCD_mCONFIG(kenuDeviceId, u8NumberOfRows)) &&
+        ((u32NowUs - ku32SliceStartUs) < LCD_CONFIG_RENDER_SLICE_US))
+  {
+    u8Address   = u8GetDdramAddress(kenuDeviceId, pstrThisData->u8RenderColumn, pstrThisData->u8RenderRow);
+    u8ShadowIdx = u8GetShadowIndex(u8Address);
+
+    if(pstrThisData->au8Frame[u8ShadowIdx] != pstrThisData->au8DdramShadow[u8ShadowIdx])
+    {
+      bReturnCode = (bSetDdramAddress(kenuDeviceId, u8Address) && bSendChar(kenuDeviceId, pstrThisData->au8Frame[u8ShadowIdx]) && bReturnCode);
+      pstrThisData->u16FrameCells++;
+      u32NowUs = TIM1_u32GetTimestampUs();
+    }
+
+    pstrThisData->u8RenderColumn++;
+
+    if(pstrThisData->u8RenderColumn >= LCD_mCONFIG(kenuDeviceId, u8NumberOfColums))
+    {
+      pstrThisData->u8RenderColumn = 0;
+      pstrThisData->u8RenderRow++;
+    }
+  }
+
+  u32NowUs = TIM1_u32GetTimestampUs();
+  pstrThisData->u32FrameBusUs += (u32NowUs - ku32SliceStartUs);
+
+  if(!bReturnCode)
+  {
+    /* The failed cells differ from the display: they are sent again by the next frame */
+    vidMarkFrameDirty(kenuDeviceId);
+  }
+
+  if(pstrThisData->u8RenderRow >= LCD_mCONFIG(kenuDeviceId, u8NumberOfRows))
+  {
+    pstrThisData->bFrameInProgress = false;
+
+    pstrStatistics->u32FrameCount++;
+    pstrStatistics->u32LastFrameTimeUs = (u32NowUs - pstrThisData->u32FrameStartUs);
+    pstrStatistics->u32LastBusTimeUs   = pstrThisData->u32FrameBusUs;
+    pstrStatistics->u16LastFrameCells  = pstrThisData->u16FrameCells;
+
+    if(pstrStatistics->u32LastFrameTimeUs > pstrStatistics->u32MaxFrameTimeUs)
+    {
+      pstrStatistics->u32MaxFrameTimeUs = pstrStatistics->u32LastFrameTimeUs;
+    }
+
+    if(pstrStatistics->u32LastBusTimeUs > pstrStatistics->u32MaxBusTimeUs)
+    {
+      pstrStatistics->u32MaxBusTimeUs = pstrStatistics->u32LastBusTimeUs;
+    }
+
+    if((int32_t)(u32NowUs - pstrThisData->u32DeadlineUs) > 0)
+    {
+      pstrStatistics->u16DeadlineMissCount++;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bDrawTrendGraph(LCD_tstrTrendGraph * const kpstrGraph)
+{
+  tstrDisplayData *pstrThisData = &LCD_mDATA(kpstrGraph->enuDeviceId);
+  uint8_t const   *pu8Content   = pu8GetContent(kpstrGraph->enuDeviceId);
+  bool            bReturnCode   = true;
+  uint8_t         au8Bitmap[LCD_GLYPH_HEIGHT];
+  uint8_t         u8RowIdx      = 0;
+  uint8_t         u8ColumnIdx   = 0;
+  uint8_t         u8LineIdx     = 0;
+  uint8_t         u8CellBase    = 0;
+  uint8_t         u8Fill        = 0;
+  uint8_t         u8Address     = 0;
+  uint8_t         u8Shown       = 0;
+  uint8_t         u8Char        = 0;
+  bool            bIsUpToDate   = false;
+
+  /* Row by row, so that the consecutive changed cells don't need to move the cursor */
+  for(u8RowIdx = 0; ((u8RowIdx < kpstrGraph->u8Height) && bReturnCode); u8RowIdx++)
+  {
+    u8CellBase = (uint8_t)((kpstrGraph->u8Height - 1 - u8RowIdx) * LCD_GLYPH_HEIGHT);
+
+    for(u8ColumnIdx = 0; ((u8ColumnIdx < kpstrGraph->u8Width) && bReturnCode); u8ColumnIdx++)
+    {
+      /* Number of filled pixel lines of the cell, from the bottom */
+      u8Fill = (kpstrGraph->au8Levels[u8ColumnIdx] <= u8CellBase) ? 0 : (kpstrGraph->au8Levels[u8ColumnIdx] - u8CellBase);
+      u8Fill = (u8Fill > LCD_GLYPH_HEIGHT) ? LCD_GLYPH_HEIGHT : u8Fill;
+
+      for(u8LineIdx = 0; u8LineIdx < LCD_GLYPH_HEIGHT; u8LineIdx++)
+      {
+        au8Bitmap[u8LineIdx] = (u8LineIdx >= (LCD_GLYPH_HEIGHT - u8Fill)) ? LCD_u8GLYPH_LINE_MASK : 0;
+      }
+
+      /* Compared with the content of the display: a cell erased by a clear or a replaced glyph is redrawn */
+      u8Address = u8GetDdramAddress(kpstrGraph->enuDeviceId, (kpstrGraph->u8Column - 1 + u8ColumnIdx), (kpstrGraph->u8Row - 1 + u8RowIdx));
+      u8Shown   = pu8Content[u8GetShadowIndex(u8Address)];
+
+      if(u8Fill == 0)
+      {
+        bIsUpToDate = (u8Shown == LCD_u8CHAR_BLANK);
+        u8Char      = LCD_u8CHAR_BLANK;
+      }
+      else if(u8Fill == LCD_GLYPH_HEIGHT)
+      {
+        bIsUpToDate = (u8Shown == LCD_u8CHAR_FULL_BLOCK);
+        u8Char      = LCD_u8CHAR_FULL_BLOCK;
+      }
+      else
+      {
+        bIsUpToDate = ((u8Shown < pstrThisData->u8GlyphSlotsUsed) &&
+                       (memcmp(pstrThisData->aau8GlyphBitmaps[u8Shown], au8Bitmap, LCD_GLYPH_HEIGHT) == 0));
+
+        if(!bIsUpToDate)
+        {
+          bReturnCode = bGetGlyphSlot(kpstrGraph->enuDeviceId, au8Bitmap, &u8Char);
+        }
+      }
+
+      if(!bIsUpToDate && bReturnCode)
+      {
+        /* The cursor is moved only if the cell does not follow the last written one */
+        bReturnCode = (bMoveCursor(kpstrGraph->enuDeviceId, u8Address) && bWriteChar(kpstrGraph->enuDeviceId, u8Char));
+      }
+    }
+  }
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bSetDisplayOn(const LCD_tenuDeviceId kenuDeviceId, const bool bSetToOn)
+{
+  bool bReturnCode = false;
+
+  if(bSetToOn)
+  {
+    LCD_mDATA(kenuDeviceId).u8DisplayControl |= LCD_u8DISPLAY_ON;
+  }
+  else
+  {
+    LCD_mDATA(kenuDeviceId).u8DisplayControl &= ~LCD_u8DISPLAY_ON;
+  }
+
+  bReturnCode  = bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl));
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bSetCursor(const LCD_tenuDeviceId kenuDeviceId, uint8_t u8Column, uint8_t u8Row)
+{
+  bool bReturnCode = false;
+
+  if(u8Column != 0)
+  {
+    u8Column--;
+  }
+
+  if(u8Row != 0)
+  {
+    u8Row--;
+  }
+
+  if(u8Column > LCD_mCONFIG(kenuDeviceId, u8NumberOfColums))
+  {
+    u8Column = LCD_mCONFIG(kenuDeviceId, u8NumberOfColums);
+  }
+
+  if(u8Row >= LCD_mCONFIG(kenuDeviceId, u8NumberOfRows))
+  {
+    u8Row = (LCD_mCONFIG(kenuDeviceId, u8NumberOfRows) - 1);
+  }
+
+  if(LCD_mIS_DEFERRED(kenuDeviceId))
+  {
+    LCD_mDATA(kenuDeviceId).u8FrameAddress = u8GetDdramAddress(kenuDeviceId, u8Column, u8Row);
+    bReturnCode = true;
+  }
+  else
+  {
+    LCD_mDATA(kenuDeviceId).u8DdramAddress = u8GetDdramAddress(kenuDeviceId, u8Column, u8Row);
+    bReturnCode = bSendCommand(kenuDeviceId, (LCD_u8SET_DDRAM_ADDR | LCD_mDATA(kenuDeviceId).u8DdramAddress));
+  }
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bClearDisplay(const LCD_tenuDeviceId kenuDeviceId)
+{
+  bool bReturnCode  = false;
+
+  /* A single command blanks the whole DDRAM and sets the address to 0 */
+  if(bSendCommand(kenuDeviceId, LCD_u8CLEAR_DISPLAY))
+  {
+    CMN_vidDelayMs(CMN_2_MS);
+
+    bReturnCode = true;
+  }
+
+  memset(LCD_mDATA(kenuDeviceId).au8DdramShadow,
+         (bReturnCode ? LCD_u8CHAR_BLANK : LCD_u8CHAR_UNKNOWN),
+         LCD_DDRAM_SIZE);
+  LCD_mDATA(kenuDeviceId).u8DdramAddress = 0;
+
+  return bReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bReturnHome(const LCD_tenuDeviceId kenuDeviceId)
+{
+  LCD_mDATA(kenuDeviceId).u8DdramAddress = 0;
+  LCD_mDATA(kenuDeviceId).u8FrameAddress = 0;
+
+  return bSendCommand(kenuDeviceId, LCD_u8RETURN_HOME);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bEnableBackLight(const LCD_tenuDeviceId kenuDeviceId, const bool kbEnable)
+{
+  if(kbEnable)
+  {
+    LCD_mDATA(kenuDeviceId).u8BacklightLevel = LCD_u8BACKLIGHT;
+  }
+  else
+  {
+    LCD_mDATA(kenuDeviceId).u8BacklightLevel = LCD_u8NO_BACKLIGHT;
+  }
+
+  return bSendToI2c(kenuDeviceId, 0);
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void LCD_vidInitialize(void)
+{
+  bool             bCommandStatus = false;
+  LCD_tenuDeviceId enuLcdId       = 0;
+  tstrDisplayData  *pstrThisData  = NULL;
+  uint8_t          u8SlotIdx      = 0;
+
+  CMN_vidDelayMs(CMN_50_MS);
+
+  for(enuLcdId = 0; enuLcdId < LCD_eDEVICE_ID_END; enuLcdId++)
+  {
+    if(LCD_mCONFIG(enuLcdId, bEnable))
+    {
+      CMN_assert(LCD_mCONFIG(enuLcdId, u8NumberOfRows) <= LCD_CONFIG_MAX_NUMBER_OF_ROWS);
+      CMN_assert(LCD_mCONFIG(enuLcdId, u8NumberOfColums) <= LCD_CONFIG_MAX_NUMBER_OF_COLUMNS);
+
+      pstrThisData = &LCD_mDATA(enuLcdId);
+      CMN_assert(pstrThisData != NULL);
+
+      pstrThisData->u8DisplayMode = (LCD_u8ENTRY_LEFT | LCD_u8ENTRY_SHIFT_DECREMENT);
+
+      /* The CGRAM content is unknown after a reset */
+      for(u8SlotIdx = 0; u8SlotIdx < LCD_GLYPH_SLOT_COUNT; u8SlotIdx++)
+      {
+        pstrThisData->au8GlyphLruOrder[u8SlotIdx] = u8SlotIdx;
+      }
+
+      pstrThisData->u8GlyphSlotsUsed = 0;
+      pstrThisData->u8GlyphsToLoad   = 0;
+
+      /* The frame matches the display once cleared below */
+      memset(pstrThisData->au8Frame, LCD_u8CHAR_BLANK, LCD_DDRAM_SIZE);
+
+      if(LCD_mCONFIG(enuLcdId, u8EnableBacklight))
+      {
+        pstrThisData->u8BacklightLevel = LCD_u8BACKLIGHT;
+      }
+      else
+      {
+        pstrThisData->u8BacklightLevel = LCD_u8NO_BACKLIGHT;
+      }
+
+      bCommandStatus = bSendToI2c(enuLcdId, 0);
+      CMN_assert(bCommandStatus == true);
+
+      pstrThisData->u8DisplayControl  |= (LCD_mCONFIG(enuLcdId, u8EnableBlink) ? LCD_u8BLINK_ON : LCD_u8BLINK_OFF);
+      pstrThisData->u8DisplayControl  |= (LCD_mCONFIG(enuLcdId, u8EnableCursor) ? LCD_u8CURSOR_ON : LCD_u8CURSOR_OFF);
+      pstrThisData->u8DisplayFunction |= (LCD_u82LINE | LCD_u84BIT_MODE | LCD_u85x8_DOTS);
+
+      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
+      CMN_assert(bCommandStatus == true);
+      CMN_vidDelayMs(CMN_5_MS);
+      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
+      CMN_assert(bCommandStatus == true);
+      CMN_vidDelayMs(CMN_5_MS);
+      bCommandStatus = bWrite4Bits(enuLcdId, 0x03 << 4);
+      CMN_assert(bCommandStatus == true);
+      CMN_vidDelayMs(CMN_5_MS);
+      bCommandStatus = bWrite4Bits(enuLcdId, 0x02 << 4);
+      CMN_assert(bCommandStatus == true);
+      CMN_vidDelayMs(CMN_5_MS);
+      bCommandStatus = bSendCommand(enuLcdId, (pstrThisData->u8DisplayFunction | LCD_u8FUNCTION_SET));
+      CMN_assert(bCommandStatus == true);
+      bCommandStatus = bSendCommand(enuLcdId, (LCD_u8DISPLAY_CONTROL | pstrThisData->u8DisplayControl));
+      bCommandStatus = bSetDisplayOn(enuLcdId, true);
+      CMN_assert(bCommandStatus == true);
+      bCommandStatus = bClearDisplay(enuLcdId);
+      CMN_assert(bCommandStatus == true);
+      bCommandStatus = bSendCommand(enuLcdId, (pstrThisData->u8DisplayMode | LCD_u8ENTRY_MODE_SET));
+      CMN_assert(bCommandStatus == true);
+      bCommandStatus = bReturnHome(enuLcdId);
+      CMN_assert(bCommandStatus == true);
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void LCD_vidProcess(void)
+{
+  const uint32_t   ku32NowUs             = TIM1_u32GetTimestampUs();
+  LCD_tenuDeviceId enuLcdId              = 0;
+  LCD_tenuDeviceId enuSelectedId         = LCD_eDEVICE_ID_END;
+  uint32_t         u32DeadlineUs         = 0;
+  uint32_t         u32SelectedDeadlineUs = 0;
+  uint8_t          u8Count               = 0;
+
+  /* The search starts after the last served display, thus the equal deadlines are served in turn */
+  for(u8Count = 0; u8Count < (uint8_t)LCD_eDEVICE_ID_END; u8Count++)
+  {
+    enuLcdId        = (LCD_tenuDeviceId)((LCD_enuLastRenderedId + 1 + u8Count) % LCD_eDEVICE_ID_END);
+
+    if(LCD_mCONFIG(enuLcdId, bEnable) && LCD_mCONFIG(enuLcdId, bDeferredRendering) && bIsRenderDue(enuLcdId, ku32NowUs, &u32DeadlineUs))
+    {
+#if(LCD_CONFIG_RENDER_SCHEDULER == LCD_RENDER_SCHEDULER_DEADLINE)
+      if((enuSelectedId == LCD_eDEVICE_ID_END) || ((int32_t)(u32DeadlineUs - u32SelectedDeadlineUs) < 0))
+#else
+      if(enuSelectedId == LCD_eDEVICE_ID_END)
+#endif //LCD_CONFIG_RENDER_SCHEDULER
+      {
+        enuSelectedId         = enuLcdId;
+        u32SelectedDeadlineUs = u32DeadlineUs;
+      }
+    }
+  }
+
+  if(enuSelectedId != LCD_eDEVICE_ID_END)
+  {
+    LCD_mDATA(enuSelectedId).u32DeadlineUs = u32SelectedDeadlineUs;
+    LCD_enuLastRenderedId                  = enuSelectedId;
+
+    vidRenderSlice(enuSelectedId);
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuGetFrameStatistics(const LCD_tenuDeviceId kenuDeviceId,
+                                         LCD_tstrFrameStatistics * const kpstrStatistics)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else if(kpstrStatistics == NULL)
+  {
+    enuReturnCode = LCD_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrStatistics = LCD_mDATA(kenuDeviceId).strStatistics;
+    enuReturnCode    = LCD_eSTATUS_OK;
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool LCD_bIsDeviceIdValid(const LCD_tenuDeviceId kenuDeviceId)
+{
+  return LCD_mIS_DEVICE_ID_VALID(kenuDeviceId);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuSetBacklightOn(const LCD_tenuDeviceId kenuDeviceId)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else
+  {
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
     }
     else if(!bEnableBackLight(kenuDeviceId, true))
     {
@@ -585,18 +1423,15 @@ LCD_tenuStatus LCD_enuSetBacklightOn(const LCD_tenuDeviceId kenuDeviceId)
 /*--------------------------------------------------------------------------------------------------------------------*/
 LCD_tenuStatus LCD_enuSetBacklightOff(const LCD_tenuDeviceId kenuDeviceId)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
-
-    if(!pkstrThisConfig->bEnable)
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
     {
       enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
     }
@@ -617,31 +1452,28 @@ LCD_tenuStatus LCD_enuSetBacklightOff(const LCD_tenuDeviceId kenuDeviceId)
 /*--------------------------------------------------------------------------------------------------------------------*/
 LCD_tenuStatus LCD_enuSetCursor(const LCD_tenuDeviceId kenuDeviceId, uint8_t u8Column, uint8_t u8Row)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
-
-    if(!pkstrThisConfig->bEnable)
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
     {
       enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
     }
     else
     {
-      if(u8Column > pkstrThisConfig->u8NumberOfColums)
+      if(u8Column > LCD_mCONFIG(kenuDeviceId, u8NumberOfColums))
       {
-        u8Column = pkstrThisConfig->u8NumberOfColums;
+        u8Column = LCD_mCONFIG(kenuDeviceId, u8NumberOfColums);
       }
 
-      if(u8Row > pkstrThisConfig->u8NumberOfRows)
+      if(u8Row > LCD_mCONFIG(kenuDeviceId, u8NumberOfRows))
       {
-        u8Row = pkstrThisConfig->u8NumberOfRows;
+        u8Row = LCD_mCONFIG(kenuDeviceId, u8NumberOfRows);
       }
 
       if(bSetCursor(kenuDeviceId, u8Column, u8Row))
@@ -658,18 +1490,15 @@ LCD_tenuStatus LCD_enuSetCursor(const LCD_tenuDeviceId kenuDeviceId, uint8_t u8C
 /*--------------------------------------------------------------------------------------------------------------------*/
 LCD_tenuStatus LCD_enuWriteText(const LCD_tenuDeviceId kenuDeviceId, const char *kps8Text)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
-
-    if(!pkstrThisConfig->bEnable)
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
     {
       enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
     }
@@ -690,13 +1519,12 @@ LCD_tenuStatus LCD_enuWriteText(const LCD_tenuDeviceId kenuDeviceId, const char
 /*--------------------------------------------------------------------------------------------------------------------*/
 LCD_tenuStatus LCD_enuPrintf(const LCD_tenuDeviceId kenuDeviceId, char const * const kpks8Format, ...)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
-  tstrDisplayData         *pstrThisData    = NULL;
-  int16_t                 s16WrittenData   = 0;
-  va_list                 args;
+  LCD_tenuStatus enuReturnCode  = LCD_eSTATUS_NO_OK;
+  uint16_t       u16BufferSize  = 0;
+  int16_t        s16WrittenData = 0;
+  va_list        args;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
@@ -706,28 +1534,28 @@ LCD_tenuStatus LCD_enuPrintf(const LCD_tenuDeviceId kenuDeviceId, char const * c
   }
   else
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
-    pstrThisData    = &LCD_astrDisplayData[kenuDeviceId];
+    u16BufferSize = (uint16_t)((LCD_mCONFIG(kenuDeviceId, u8NumberOfRows) * LCD_mCONFIG(kenuDeviceId, u8NumberOfColums)) + 1);
 
-    if(!pkstrThisConfig->bEnable)
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
     {
       enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
     }
     else
     {
       va_start(args, kpks8Format);
-      s16WrittenData = vsnprintf((char *)pstrThisData->pau8DataBuffer, pstrThisData->u16DataSize, kpks8Format, args);
+      s16WrittenData = vsnprintf(LCD_as8FormatBuffer, u16BufferSize, kpks8Format, args);
       va_end(args);
 
+      /* vsnprintf returns the length of the whole formatted text: it has been truncated when it does not fit the display */
       if(s16WrittenData < 0)
       {
         enuReturnCode = LCD_eSTATUS_PRINTF_ERROR;
       }
-      else if(strlen((char *)pstrThisData->pau8DataBuffer) != s16WrittenData)
+      else if((uint16_t)s16WrittenData >= u16BufferSize)
       {
         enuReturnCode = LCD_eSTATUS_INVALID_DIGITS_NUMBER;
       }
-      else if(!bWriteText(kenuDeviceId, (char *)pstrThisData->pau8DataBuffer, (uint16_t)s16WrittenData))
+      else if(!bWriteText(kenuDeviceId, LCD_as8FormatBuffer, (uint16_t)s16WrittenData))
       {
         enuReturnCode = LCD_eSTATUS_NO_OK;
       }
@@ -742,41 +1570,272 @@ LCD_tenuStatus LCD_enuPrintf(const LCD_tenuDeviceId kenuDeviceId, char const * c
 }
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuWriteInteger(const LCD_tenuDeviceId kenuDeviceId, const int32_t ks32Value)
+{
+  return LCD_enuWriteDecimal(kenuDeviceId, ks32Value, 0);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuWriteDecimal(const LCD_tenuDeviceId kenuDeviceId, const int32_t ks32Value, const uint8_t ku8Decimals)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+  char           as8Text[CMN_FMT_BUFFER_SIZE];
+  uint8_t        u8TextLength  = 0;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else
+  {
+    u8TextLength = CMN_u8FormatDecimal(as8Text, sizeof(as8Text), ks32Value, ku8Decimals);
+
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+    }
+    else if(u8TextLength == 0)
+    {
+      enuReturnCode = LCD_eSTATUS_INVALID_DIGITS_NUMBER;
+    }
+    else if(bWriteText(kenuDeviceId, as8Text, u8TextLength))
+    {
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuGetGlyphCode(const LCD_tenuDeviceId kenuDeviceId,
+                                   uint8_t const * const kpku8Bitmap,
+                                   uint8_t * const kpu8CharCode)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else if((kpku8Bitmap == NULL) || (kpu8CharCode == NULL))
+  {
+    enuReturnCode = LCD_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+    }
+    else if(bGetGlyphSlot(kenuDeviceId, kpku8Bitmap, kpu8CharCode))
+    {
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuWriteGlyph(const LCD_tenuDeviceId kenuDeviceId, uint8_t const * const kpku8Bitmap)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+  uint8_t        u8CharCode    = 0;
+
+  enuReturnCode = LCD_enuGetGlyphCode(kenuDeviceId, kpku8Bitmap, &u8CharCode);
+
+  if((enuReturnCode == LCD_eSTATUS_OK) && !bWriteChar(kenuDeviceId, u8CharCode))
+  {
+    enuReturnCode = LCD_eSTATUS_NO_OK;
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuTrendGraphInit(LCD_tstrTrendGraph * const kpstrGraph,
+                                     const LCD_tenuDeviceId kenuDeviceId,
+                                     const uint8_t ku8Column,
+                                     const uint8_t ku8Row,
+                                     const uint8_t ku8Width,
+                                     const uint8_t ku8Height,
+                                     const int16_t ks16MinValue,
+                                     const int16_t ks16MaxValue)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else if(kpstrGraph == NULL)
+  {
+    enuReturnCode = LCD_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+    }
+    else if((ku8Column == 0) || (ku8Row == 0) || (ku8Width == 0) || (ku8Height == 0) ||
+            ((ku8Column + ku8Width - 1) > LCD_mCONFIG(kenuDeviceId, u8NumberOfColums)) ||
+            ((ku8Row + ku8Height - 1) > LCD_mCONFIG(kenuDeviceId, u8NumberOfRows))     ||
+            (ks16MinValue >= ks16MaxValue))
+    {
+      enuReturnCode = LCD_eSTATUS_INVALID_GEOMETRY;
+    }
+    else
+    {
+      kpstrGraph->enuDeviceId = kenuDeviceId;
+      kpstrGraph->u8Column    = ku8Column;
+      kpstrGraph->u8Row       = ku8Row;
+      kpstrGraph->u8Width     = ku8Width;
+      kpstrGraph->u8Height    = ku8Height;
+      kpstrGraph->s16MinValue = ks16MinValue;
+      kpstrGraph->s16MaxValue = ks16MaxValue;
+
+      memset(kpstrGraph->au8Levels, 0, sizeof(kpstrGraph->au8Levels));
+
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuTrendGraphPush(LCD_tstrTrendGraph * const kpstrGraph, const int16_t ks16Value)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+  const uint8_t  ku8MaxLevel   = (kpstrGraph != NULL) ? (uint8_t)(kpstrGraph->u8Height * LCD_GLYPH_HEIGHT) : 0;
+  uint8_t        u8Level       = 0;
+
+  if(kpstrGraph == NULL)
+  {
+    enuReturnCode = LCD_eSTATUS_NULL_POINTER;
+  }
+  else if(!LCD_mIS_DEVICE_ID_VALID(kpstrGraph->enuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else
+  {
+    if(ks16Value <= kpstrGraph->s16MinValue)
+    {
+      u8Level = 0;
+    }
+    else if(ks16Value >= kpstrGraph->s16MaxValue)
+    {
+      u8Level = ku8MaxLevel;
+    }
+    else
+    {
+      u8Level = (uint8_t)((((int32_t)ks16Value - kpstrGraph->s16MinValue) * ku8MaxLevel) /
+                          ((int32_t)kpstrGraph->s16MaxValue - kpstrGraph->s16MinValue));
+    }
+
+    memmove(&kpstrGraph->au8Levels[0], &kpstrGraph->au8Levels[1], (kpstrGraph->u8Width - 1));
+    kpstrGraph->au8Levels[kpstrGraph->u8Width - 1] = u8Level;
+
+    if(bDrawTrendGraph(kpstrGraph))
+    {
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+  }
+
+  return enuReturnCode;
+}
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 LCD_tenuStatus LCD_enuClearAll(const LCD_tenuDeviceId kenuDeviceId)
 {
-  LCD_tenuStatus          enuReturnCode    = LCD_eSTATUS_NO_OK;
-  LCD_tstrLcdConfig const *pkstrThisConfig = NULL;
-  uint8_t                 u8DigitIdx       = 0;
-  bool                    bStatus          = false;
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    pkstrThisConfig = LCD_kpkstrGetLcdConfig(kenuDeviceId);
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+    }
+    else if(LCD_mIS_DEFERRED(kenuDeviceId))
+    {
+      /* The command is sent at the start of the next frame */
+      memset(LCD_mDATA(kenuDeviceId).au8Frame, LCD_u8CHAR_BLANK, LCD_DDRAM_SIZE);
+      LCD_mDATA(kenuDeviceId).u8FrameAddress  = 0;
+      LCD_mDATA(kenuDeviceId).bClearRequested = true;
+      vidMarkFrameDirty(kenuDeviceId);
 
-    if(bSetCursor(kenuDeviceId, 1, 1))
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+    else if(bClearDisplay(kenuDeviceId))
     {
-      for(u8DigitIdx = 0, bStatus = true; ((u8DigitIdx < pkstrThisConfig->u8NumberOfColums) && (bStatus == true)); u8DigitIdx++)
-      {
-        bStatus = bSendData(kenuDeviceId, ' ');
-      }
+      enuReturnCode = LCD_eSTATUS_OK;
+    }
+  }
 
-      if(bStatus && bSetCursor(kenuDeviceId, 1, 2))
-      {
-        for(u8DigitIdx = 0, bStatus = true; ((u8DigitIdx < pkstrThisConfig->u8NumberOfColums) && (bStatus == true)); u8DigitIdx++)
-        {
-          bStatus = bSendData(kenuDeviceId, ' ');
-        }
-      }
+  return enuReturnCode;
+}
 
-      if(bStatus)
-      {
-        enuReturnCode = LCD_eSTATUS_OK;
-      }
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuClearRow(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Row)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else
+  {
+    enuReturnCode = LCD_enuClearRegion(kenuDeviceId, 1, ku8Row, LCD_mCONFIG(kenuDeviceId, u8NumberOfColums), 1);
+  }
+
+  return enuReturnCode;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+LCD_tenuStatus LCD_enuClearRegion(const LCD_tenuDeviceId kenuDeviceId,
+                                  const uint8_t ku8Column,
+                                  const uint8_t ku8Row,
+                                  const uint8_t ku8Width,
+                                  const uint8_t ku8Height)
+{
+  LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
+
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
+  {
+    enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
+  }
+  else
+  {
+    if(!LCD_mCONFIG(kenuDeviceId, bEnable))
+    {
+      enuReturnCode = LCD_eSTATUS_DEVICE_IS_NOT_ENABLED;
+    }
+    else if((ku8Column == 0) || (ku8Row == 0) || (ku8Width == 0) || (ku8Height == 0) ||
+            ((ku8Column + ku8Width - 1) > LCD_mCONFIG(kenuDeviceId, u8NumberOfColums)) ||
+            ((ku8Row + ku8Height - 1) > LCD_mCONFIG(kenuDeviceId, u8NumberOfRows)))
+    {
+      enuReturnCode = LCD_eSTATUS_INVALID_GEOMETRY;
+    }
+    else if(bClearRegion(kenuDeviceId, (ku8Column - 1), (ku8Row - 1), ku8Width, ku8Height))
+    {
+      enuReturnCode = LCD_eSTATUS_OK;
     }
   }
 
@@ -789,15 +1848,15 @@ LCD_tenuStatus LCD_enuBlinkOn(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl |= LCD_u8BLINK_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl |= LCD_u8BLINK_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
       enuReturnCode = LCD_eSTATUS_OK;
     }
@@ -812,15 +1871,15 @@ LCD_tenuStatus LCD_enuBlinkOff(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl &= ~LCD_u8BLINK_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl &= ~LCD_u8BLINK_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
       enuReturnCode = LCD_eSTATUS_OK;
     }
@@ -835,15 +1894,15 @@ LCD_tenuStatus LCD_enuCursorOn(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl |= LCD_u8CURSOR_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl |= LCD_u8CURSOR_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
         enuReturnCode = LCD_eSTATUS_OK;
     }
@@ -858,15 +1917,15 @@ LCD_tenuStatus LCD_enuCursorOff(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl &= ~LCD_u8CURSOR_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl &= ~LCD_u8CURSOR_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
       enuReturnCode = LCD_eSTATUS_OK;
     }
@@ -881,15 +1940,15 @@ LCD_tenuStatus LCD_enuDisplayOn(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl |= LCD_u8DISPLAY_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl |= LCD_u8DISPLAY_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
       enuReturnCode = LCD_eSTATUS_OK;
     }
@@ -904,15 +1963,15 @@ LCD_tenuStatus LCD_enuDisplayOff(const LCD_tenuDeviceId kenuDeviceId)
 {
   LCD_tenuStatus enuReturnCode = LCD_eSTATUS_NO_OK;
 
-  if(!bIsDeviceIdValid(kenuDeviceId))
+  if(!LCD_mIS_DEVICE_ID_VALID(kenuDeviceId))
   {
     enuReturnCode = LCD_eSTATUS_INVALID_DEVICE_ID;
   }
   else
   {
-    LCD_astrDisplayData[kenuDeviceId].u8DisplayControl &= ~LCD_u8DISPLAY_ON;
+    LCD_mDATA(kenuDeviceId).u8DisplayControl &= ~LCD_u8DISPLAY_ON;
 
-    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_astrDisplayData[kenuDeviceId].u8DisplayControl)))
+    if(bSendCommand(kenuDeviceId, (LCD_u8DISPLAY_CONTROL | LCD_mDATA(kenuDeviceId).u8DisplayControl)))
     {
       enuReturnCode = LCD_eSTATUS_OK;
     }
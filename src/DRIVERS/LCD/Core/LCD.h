@@ -38,6 +38,8 @@
 /**********************************************************************************************************************/
 /* CONSTANTS, MACROS                                                                                                  */
 /**********************************************************************************************************************/
+#define LCD_GLYPH_HEIGHT                                    8     //!< Number of pixel lines of a custom glyph (5x8 font)
+#define LCD_GLYPH_SLOT_COUNT                                8     //!< Number of custom glyphs held by the CGRAM
 
 
 
@@ -57,10 +59,48 @@ typedef enum LCD_tenuStatus
   LCD_eSTATUS_DEVICE_IS_NOT_ENABLED,                              //!< The handled device is not enabled
   LCD_eSTATUS_NULL_POINTER,                                       //!< The pointer passed as an argument is NULL
   LCD_eSTATUS_PRINTF_ERROR,                                       //!< The printf function has failed to format the data
+  LCD_eSTATUS_INVALID_GEOMETRY,                                   //!< The widget does not fit the display
   LCD_eSTATUS_COUNT                                               //!< The total return code available
 }LCD_tenuStatus;
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Type used to handle a rolling bar graph drawn with the custom glyphs
+ * @details Each column of the graph has (8 * u8Height) levels, the newest value is drawn on the right. Only the cells
+ *          whose content differs from the display are sent (a cell erased by a clear is redrawn at the next push).
+ * @remark The fields are managed by the LCD_enuTrendGraphxxx functions, they shall not be written directly
+ */
+typedef struct LCD_tstrTrendGraph
+{
+  LCD_tenuDeviceId                                          enuDeviceId;        //!< The display where the graph is drawn
+  uint8_t                                                   u8Column;           //!< The left column of the graph (from 1)
+  uint8_t                                                   u8Row;              //!< The top row of the graph (from 1)
+  uint8_t                                                   u8Width;            //!< The number of columns of the graph
+  uint8_t                                                   u8Height;           //!< The number of rows of the graph
+  int16_t                                                   s16MinValue;        //!< The value drawn as an empty column
+  int16_t                                                   s16MaxValue;        //!< The value drawn as a full column
+  uint8_t                                                   au8Levels[LCD_CONFIG_MAX_NUMBER_OF_COLUMNS]; //!< The levels to be drawn, the oldest first
+}LCD_tstrTrendGraph;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Type used to report the rendering statistics of a deferred display (see @ref LCD_vidProcess)
+ * @remark The times are measured with the TIM1 timebase
+ */
+typedef struct LCD_tstrFrameStatistics
+{
+  uint32_t                                                  u32FrameCount;      //!< The number of rendered frames
+  uint32_t                                                  u32LastFrameTimeUs; //!< Time from the start to the end of the last frame
+  uint32_t                                                  u32MaxFrameTimeUs;  //!< Longest frame time since the startup
+  uint32_t                                                  u32LastBusTimeUs;   //!< Time spent on the I2C bus by the last frame
+  uint32_t                                                  u32MaxBusTimeUs;    //!< Longest bus time of a frame since the startup
+  uint16_t                                                  u16LastFrameCells;  //!< Number of cells sent by the last frame
+  uint16_t                                                  u16DeadlineMissCount; //!< Number of frames ended after their deadline
+}LCD_tstrFrameStatistics;
+
+
 /**********************************************************************************************************************/
 /* PUBLIC FUNCTION PROTOTYPES                                                                                         */
 /**********************************************************************************************************************/
@@ -70,6 +110,28 @@ typedef enum LCD_tenuStatus
 void LCD_vidInitialize(void);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to render the displays configured with the deferred rendering, to be called from the main loop
+ * @details The writes on a deferred display only update its frame buffer. At each call, one display with a pending
+ *          frame is chosen according to @ref LCD_CONFIG_RENDER_SCHEDULER and only its cells which differ from the
+ *          display are sent, during @ref LCD_CONFIG_RENDER_SLICE_US at most. A display is not rendered more often than
+ *          its refresh period, the deadline of a frame is one refresh period after its start is allowed.
+ */
+void LCD_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the rendering statistics of a deferred display
+ * @param[in]  kenuDeviceId The ID of the LCD.
+ * @param[out] kpstrStatistics The statistics of the display
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuGetFrameStatistics(const LCD_tenuDeviceId kenuDeviceId,
+                                         LCD_tstrFrameStatistics * const kpstrStatistics);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
  * @brief Function used to check if a LCD device ID is in a valid range or not
@@ -131,15 +193,126 @@ LCD_tenuStatus LCD_enuWriteText(const LCD_tenuDeviceId kenuDeviceId, char const
 LCD_tenuStatus LCD_enuPrintf(const LCD_tenuDeviceId kenuDeviceId, char const * const kpks8Format, ...);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to print an integer on the LCD, without the cost of the printf formatting
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ks32Value The value to be printed
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuWriteInteger(const LCD_tenuDeviceId kenuDeviceId, const int32_t ks32Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to print a value scaled by a power of ten on the LCD (2345 with 2 decimals prints "23.45")
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ks32Value The scaled value to be printed
+ * @param[in]  ku8Decimals The number of decimals of the value
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuWriteDecimal(const LCD_tenuDeviceId kenuDeviceId, const int32_t ks32Value, const uint8_t ku8Decimals);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the character code of a custom glyph, the glyph is loaded in the CGRAM if needed
+ * @details The CGRAM slots are cached: a glyph already loaded is not sent again, when all the slots are used the least
+ *          recently used one is replaced (the cells of the display still showing it are changed too)
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]  kpku8Bitmap The @ref LCD_GLYPH_HEIGHT pixel lines of the glyph (5 Bits each, the MSB on the left)
+ * @param[out] kpu8CharCode The character code to be written to show the glyph
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuGetGlyphCode(const LCD_tenuDeviceId kenuDeviceId,
+                                   uint8_t const * const kpku8Bitmap,
+                                   uint8_t * const kpu8CharCode);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to print a custom glyph at the current position of the cursor (see @ref LCD_enuGetGlyphCode)
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]  kpku8Bitmap The @ref LCD_GLYPH_HEIGHT pixel lines of the glyph
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuWriteGlyph(const LCD_tenuDeviceId kenuDeviceId, uint8_t const * const kpku8Bitmap);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to initialize a rolling bar graph, nothing is drawn until the first push
+ * @param[out]  kpstrGraph The graph to be initialized
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ku8Column The left column of the graph (from 1)
+ * @param[in]       ku8Row The top row of the graph (from 1)
+ * @param[in]     ku8Width The number of columns of the graph
+ * @param[in]    ku8Height The number of rows of the graph
+ * @param[in] ks16MinValue The value drawn as an empty column
+ * @param[in] ks16MaxValue The value drawn as a full column
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuTrendGraphInit(LCD_tstrTrendGraph * const kpstrGraph,
+                                     const LCD_tenuDeviceId kenuDeviceId,
+                                     const uint8_t ku8Column,
+                                     const uint8_t ku8Row,
+                                     const uint8_t ku8Width,
+                                     const uint8_t ku8Height,
+                                     const int16_t ks16MinValue,
+                                     const int16_t ks16MaxValue);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to add a value on the right of a rolling bar graph, the other values are shifted on the left
+ * @details Only the cells whose bar level changes are redrawn
+ * @param[in,out] kpstrGraph The graph to be updated
+ * @param[in]      ks16Value The new value
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuTrendGraphPush(LCD_tstrTrendGraph * const kpstrGraph, const int16_t ks16Value);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
  * @brief Function used to clear the LCD display
+ * @details The whole display is blanked with the single "Clear display" command and the cursor is set at the home
+ *          position
  * @param[in] kenuDeviceId The ID of the LCD.
  * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
  */
 LCD_tenuStatus LCD_enuClearAll(const LCD_tenuDeviceId kenuDeviceId);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to clear a row of the LCD display (see @ref LCD_enuClearRegion)
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]       ku8Row The row to be cleared (from 1)
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuClearRow(const LCD_tenuDeviceId kenuDeviceId, const uint8_t ku8Row);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to clear a rectangular region of the LCD display
+ * @details Only the cells which are not already blank are written, the cursor is left at the top left cell of the
+ *          region
+ * @param[in] kenuDeviceId The ID of the LCD.
+ * @param[in]    ku8Column The left column of the region (from 1)
+ * @param[in]       ku8Row The top row of the region (from 1)
+ * @param[in]     ku8Width The number of columns of the region
+ * @param[in]    ku8Height The number of rows of the region
+ * @return Return @ref LCD_eSTATUS_OK if the function ran successfully, return other codes in the other cases.
+ */
+LCD_tenuStatus LCD_enuClearRegion(const LCD_tenuDeviceId kenuDeviceId,
+                                  const uint8_t ku8Column,
+                                  const uint8_t ku8Row,
+                                  const uint8_t ku8Width,
+                                  const uint8_t ku8Height);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
  * @brief Function used to enable the cursor blink of the LCD.
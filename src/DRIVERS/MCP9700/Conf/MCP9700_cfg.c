@@ -0,0 +1,92 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      MCP9700_cfg.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     MCP9700 Driver configuration part
+ * @details   Module in charge of the conversion of the analog temperature sensors (MCP9700 family) wired to the
+ *            channels of the ADC scan table
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "MCP9700_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief The static database of each sensor configuration
+ */
+static const MCP9700_tstrSensorConfig MCP9700_kastrSensorConfigList[MCP9700_eSENSOR_ID_END] =
+{
+  [MCP9700_eSENSOR_ID_AMBIENT]                              =
+  {
+    .bEnable                                                = MCP9700_CONFIG_AMBIENT_ENABLE,
+    .enuAdcChannelId                                        = MCP9700_CONFIG_AMBIENT_ADC_CHANNEL_ID,
+    .u16OffsetMv                                            = MCP9700_CONFIG_AMBIENT_OFFSET_MV,
+    .u16GainUvPerDegC                                       = MCP9700_CONFIG_AMBIENT_GAIN_UV_PER_DEG_C,
+    .s16Calibration                                         = MCP9700_CONFIG_AMBIENT_CALIBRATION,
+    .u16SamplePeriodMs                                      = MCP9700_CONFIG_AMBIENT_SAMPLE_PERIOD_MS,
+  },
+  [MCP9700_eSENSOR_ID_POTENTIOMETER]                        =
+  {
+    .bEnable                                                = MCP9700_CONFIG_POTENTIOMETER_ENABLE,
+    .enuAdcChannelId                                        = MCP9700_CONFIG_POTENTIOMETER_ADC_CHANNEL_ID,
+    .u16OffsetMv                                            = MCP9700_CONFIG_POTENTIOMETER_OFFSET_MV,
+    .u16GainUvPerDegC                                       = MCP9700_CONFIG_POTENTIOMETER_GAIN_UV_PER_DEG_C,
+    .s16Calibration                                         = MCP9700_CONFIG_POTENTIOMETER_CALIBRATION,
+    .u16SamplePeriodMs                                      = MCP9700_CONFIG_POTENTIOMETER_SAMPLE_PERIOD_MS,
+  },
+};
+
+
+/**********************************************************************************************************************/
+/* GETTERS DEFINITIONS                                                                                                */
+/**********************************************************************************************************************/
+MCP9700_tstrSensorConfig const * const MCP9700_kpkstrGetSensorConfig(const MCP9700_tenuSensorId kenuSensorId)
+{
+  MCP9700_tstrSensorConfig const *pkstrThisConfig = NULL;
+
+  if((MCP9700_eSENSOR_ID_BEGIN < kenuSensorId) && (kenuSensorId < MCP9700_eSENSOR_ID_END))
+  {
+    pkstrThisConfig = &MCP9700_kastrSensorConfigList[kenuSensorId];
+  }
+
+  return pkstrThisConfig;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,140 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      MCP9700_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     MCP9700 Driver configuration part
+ * @details   Module in charge of the conversion of the analog temperature sensors (MCP9700 family) wired to the
+ *            channels of the ADC scan table
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef MCP9700_CFG_H_
+#define MCP9700_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+#include "ADC.h"
+
+
+/**********************************************************************************************************************/
+/* MACROS, CONFIGURATIONS                                                                                             */
+/**********************************************************************************************************************/
+/**
+ * @brief Settings of the sensor @ref MCP9700_eSENSOR_ID_AMBIENT, the MCP9700 of the board (see
+ *        @ref MCP9700_tstrSensorConfig)
+ */
+#define MCP9700_CONFIG_AMBIENT_ENABLE                       true
+#define MCP9700_CONFIG_AMBIENT_ADC_CHANNEL_ID               ADC_eCHANNEL_ID_SENSOR
+#define MCP9700_CONFIG_AMBIENT_OFFSET_MV                    500
+#define MCP9700_CONFIG_AMBIENT_GAIN_UV_PER_DEG_C            10000
+#define MCP9700_CONFIG_AMBIENT_CALIBRATION                  0
+#define MCP9700_CONFIG_AMBIENT_SAMPLE_PERIOD_MS             1000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Settings of the sensor @ref MCP9700_eSENSOR_ID_POTENTIOMETER, the potentiometer of the Curiosity board seen
+ *        as a MCP9700 (simulated temperature)
+ * @remark In change-detect mode, the potentiometer is only sampled when its value leaves the window (see
+ *         @ref MCP9700_requestSample)
+ */
+#define MCP9700_CONFIG_POTENTIOMETER_ENABLE                 true
+#define MCP9700_CONFIG_POTENTIOMETER_ADC_CHANNEL_ID         ADC_eCHANNEL_ID_POTENTIOMETER
+#define MCP9700_CONFIG_POTENTIOMETER_OFFSET_MV              500
+#define MCP9700_CONFIG_POTENTIOMETER_GAIN_UV_PER_DEG_C      10000
+#define MCP9700_CONFIG_POTENTIOMETER_CALIBRATION            0
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+#  define MCP9700_CONFIG_POTENTIOMETER_SAMPLE_PERIOD_MS     0
+#else
+#  define MCP9700_CONFIG_POTENTIOMETER_SAMPLE_PERIOD_MS     250
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the maximal time to wait for each conversion of a scan in single-shot mode (in ms)
+ */
+#define MCP9700_CONFIG_SCAN_TIMEOUT_MS                      10
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enumeration used to declare each sensor to handle them through the publics APIs of the driver
+ * @remark A new sensor needs its channel in the ADC scan table (see @ref ADC_tenuChannelId)
+ */
+typedef enum MCP9700_tenuSensorId
+{
+  /*-----[DO NOT EDIT/USE THIS]-----*/
+  MCP9700_eSENSOR_ID_BEGIN = -1, /* */
+  /*--------------------------------*/
+
+  MCP9700_eSENSOR_ID_AMBIENT,
+  MCP9700_eSENSOR_ID_POTENTIOMETER,
+
+  /*-------[DO NOT EDIT THIS]-------*/
+  MCP9700_eSENSOR_ID_END /*---------*/
+  /*--------------------------------*/
+}MCP9700_tenuSensorId;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the sensor wired to the main channel of the ADC, the one which feeds the measurement of the
+ *        application (filter, display, history and log)
+ */
+#if(ADC_CONFIG_USE_POTENTIOMETER == true)
+#  define MCP9700_CONFIG_PRIMARY_SENSOR_ID                  MCP9700_eSENSOR_ID_POTENTIOMETER
+#elif(ADC_CONFIG_USE_POTENTIOMETER == false)
+#  define MCP9700_CONFIG_PRIMARY_SENSOR_ID                  MCP9700_eSENSOR_ID_AMBIENT
+#endif //ADC_CONFIG_USE_POTENTIOMETER
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Type used to set the static configuration of a sensor
+ * @details The temperature is (output voltage - offset) / gain + calibration
+ */
+typedef struct MCP9700_tstrSensorConfig
+{
+  bool                                                      bEnable;                  //!< If this sensor is sampled or not
+  ADC_tenuChannelId                                         enuAdcChannelId;          //!< The channel of the scan table wired to the sensor output
+  uint16_t                                                  u16OffsetMv;              //!< The output at 0 degC (500 mV for the MCP9700, 400 mV for the MCP9701)
+  uint16_t                                                  u16GainUvPerDegC;         //!< The slope of the output (10000 for the MCP9700, 19500 for the MCP9701)
+  int16_t                                                   s16Calibration;           //!< The correction added to each value, in 0.01 degC (one-point calibration)
+  uint16_t                                                  u16SamplePeriodMs;        //!< The period of the samples, 0 to sample only on request
+}MCP9700_tstrSensorConfig;
+
+
+/**********************************************************************************************************************/
+/* GETTERS PROTOTYPES                                                                                                 */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to get the static configuration of a sensor
+ * @return Return the sensor item with its static configuration, NULL if the ID is unknown
+ */
+MCP9700_tstrSensorConfig const * const MCP9700_kpkstrGetSensorConfig(const MCP9700_tenuSensorId kenuSensorId);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* MCP9700_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
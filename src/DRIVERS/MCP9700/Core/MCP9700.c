@@ -0,0 +1,383 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      MCP9700.c
+ *
+ * @author    gpaultre
+ * @date      14/11/2024
+ *
+ * @version   0.0.0
+ *
+ * @brief     <you can add a description of your module here, otherwise please delete this line>
+ * @details   <you can add more details of your module here, otherwise please delete this line>
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+
+#include "MCP9700.h"
+#include "TIMER.h"
+#include "Common.h"
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+
+// Les valeurs compensées sont ramenées à l'alimentation nominale de l'ADC
+#define ADC_REF_VOLTAGE_MV ADC_CONFIG_NOMINAL_VDD_MV
+#define ADC_RESOLUTION ADC_FULL_SCALE
+
+// Plage de mesure du capteur (en 0.01 °C)
+#define TEMP_MIN (-40 * MCP9700_TEMPERATURE_SCALE)
+#define TEMP_MAX (125 * MCP9700_TEMPERATURE_SCALE)
+
+// Une tension en mV multipliée par ce facteur puis divisée par le gain (en µV/°C) donne des 0.01 °C
+#define MCP9700_UV_CENTI_PER_MV (1000UL * MCP9700_TEMPERATURE_SCALE)
+
+// Pente maximale (gain minimal) pour que le produit code ADC * pente tienne sur 32 bits
+#define MCP9700_SLOPE_MAX (UINT32_MAX >> ADC_RESOLUTION_BITS)
+
+#if (ADC_REF_VOLTAGE_MV > (UINT32_MAX / MCP9700_UV_CENTI_PER_MV))
+#error "MCP9700 : la tension de référence dépasse le calcul des coefficients sur 32 bits"
+#endif
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+
+typedef struct
+{
+    bool enabled;          // Capteur configuré avec des coefficients valides
+    bool scheduled;        // Première mesure faite, lastSampleUs est l'échéance de la précédente
+    bool due;              // Mesuré à la fin du scan en cours
+    uint32_t slope;        // 0.01 °C par code ADC, avec ADC_RESOLUTION_BITS bits de fraction
+    int32_t intercept;     // 0.01 °C retranchés : tension à 0 °C moins la calibration
+    uint16_t periodMs;     // Période courante (MCP9700_setSamplePeriod), 0 : mesure sur demande uniquement
+    uint32_t lastSampleUs; // Échéance de la dernière mesure (TIM1)
+} MCP9700_sensor;
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+
+static MCP9700_sensor MCP9700_sensors[MCP9700_eSENSOR_ID_END];
+static MCP9700_sampleCallback MCP9700_callback = NULL;
+static volatile bool MCP9700_sampleRequested = false;
+
+// Scan lancé par l'ordonnanceur et nombre de passes de l'ADC à son lancement
+static bool MCP9700_scanPending = false;
+static uint32_t MCP9700_scanPassCount = 0;
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION PROTOTYPES                                                                                        */
+/**********************************************************************************************************************/
+
+static MCP9700_status MCP9700_calculateTemperature(const MCP9700_sensor *sensor, uint16_t adcValue, int16_t *temperature);
+
+static bool MCP9700_isDue(const MCP9700_tenuSensorId sensorId, uint32_t nowUs, bool requested);
+
+static void MCP9700_deliverSamples(void);
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+
+static MCP9700_status MCP9700_calculateTemperature(const MCP9700_sensor *sensor, uint16_t adcValue, int16_t *temperature)
+{
+    if (temperature == NULL)
+    {
+        return MCP9700_NOK;
+    }
+
+    if (adcValue >= ADC_RESOLUTION)
+    {
+        return MCP9700_NOK;
+    }
+
+    // Fonction de transfert affine précalculée par MCP9700_init : une multiplication et un décalage, sans division
+    int32_t centiDegC = (int32_t)((((uint32_t)adcValue * sensor->slope) + (1UL << (ADC_RESOLUTION_BITS - 1)))
+                                  >> ADC_RESOLUTION_BITS) - sensor->intercept;
+
+    // Limiter aux bornes de mesure du capteur
+    if (centiDegC < TEMP_MIN)
+    {
+        centiDegC = TEMP_MIN;
+    }
+    else if (centiDegC > TEMP_MAX)
+    {
+        centiDegC = TEMP_MAX;
+    }
+
+    *temperature = (int16_t)centiDegC;
+
+    return MCP9700_OK;
+}
+
+static bool MCP9700_isDue(const MCP9700_tenuSensorId sensorId, uint32_t nowUs, bool requested)
+{
+    const MCP9700_sensor *sensor = &MCP9700_sensors[sensorId];
+    uint32_t periodUs = (uint32_t)sensor->periodMs * 1000UL;
+
+    if (!sensor->enabled)
+    {
+        return false;
+    }
+
+    if (requested)
+    {
+        return true;
+    }
+
+    // Période nulle : mesure sur demande uniquement
+    if (periodUs == 0)
+    {
+        return false;
+    }
+
+    return !sensor->scheduled || ((nowUs - sensor->lastSampleUs) >= periodUs);
+}
+
+static void MCP9700_deliverSamples(void)
+{
+    int16_t temperature;
+
+    for (MCP9700_tenuSensorId sensorId = MCP9700_eSENSOR_ID_BEGIN + 1; sensorId < MCP9700_eSENSOR_ID_END; sensorId++)
+    {
+        if (!MCP9700_sensors[sensorId].due)
+        {
+            continue;
+        }
+
+        MCP9700_sensors[sensorId].due = false;
+
+        if (MCP9700_getTemperature(sensorId, &temperature) != MCP9700_OK)
+        {
+            CMN_systemLogText("Error: Unable to convert a sensor\r\n");
+        }
+        else if (MCP9700_callback != NULL)
+        {
+            MCP9700_callback(sensorId, temperature);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+
+MCP9700_status MCP9700_init(void)
+{
+    MCP9700_status status = MCP9700_OK;
+
+    for (MCP9700_tenuSensorId sensorId = MCP9700_eSENSOR_ID_BEGIN + 1; sensorId < MCP9700_eSENSOR_ID_END; sensorId++)
+    {
+        const MCP9700_tstrSensorConfig *config = MCP9700_kpkstrGetSensorConfig(sensorId);
+        MCP9700_sensor *sensor = &MCP9700_sensors[sensorId];
+
+        sensor->enabled = false;
+        sensor->scheduled = false;
+        sensor->due = false;
+
+        if (!config->bEnable)
+        {
+            continue;
+        }
+
+        // Voie hors de la table de scan, gain nul ou trop faible, tension à 0 °C hors de la pleine échelle
+        if ((ADC_kpkstrGetChannelConfig(config->enuAdcChannelId) == NULL) ||
+            (config->u16GainUvPerDegC == 0) ||
+            (config->u16OffsetMv > ADC_REF_VOLTAGE_MV))
+        {
+            status = MCP9700_NOK;
+            continue;
+        }
+
+        uint32_t halfGain = config->u16GainUvPerDegC / 2;
+        sensor->slope = ((ADC_REF_VOLTAGE_MV * MCP9700_UV_CENTI_PER_MV) + halfGain) / config->u16GainUvPerDegC;
+
+        if (sensor->slope > MCP9700_SLOPE_MAX)
+        {
+            status = MCP9700_NOK;
+            continue;
+        }
+
+        sensor->intercept = (int32_t)((((uint32_t)config->u16OffsetMv * MCP9700_UV_CENTI_PER_MV) + halfGain)
+                                      / config->u16GainUvPerDegC) - config->s16Calibration;
+        sensor->periodMs = config->u16SamplePeriodMs;
+        sensor->enabled = true;
+    }
+
+    MCP9700_sampleRequested = false;
+    MCP9700_scanPending = false;
+
+    return status;
+}
+
+MCP9700_status MCP9700_registerSampleCallback(MCP9700_sampleCallback callback)
+{
+    if (callback == NULL)
+    {
+        return MCP9700_NOK;
+    }
+
+    MCP9700_callback = callback;
+
+    return MCP9700_OK;
+}
+
+MCP9700_status MCP9700_getTemperature(const MCP9700_tenuSensorId sensorId, int16_t *temperature)
+{
+    uint16_t adcValue = 0;
+
+    if ((sensorId <= MCP9700_eSENSOR_ID_BEGIN) || (sensorId >= MCP9700_eSENSOR_ID_END) ||
+        !MCP9700_sensors[sensorId].enabled)
+    {
+        return MCP9700_NOK;
+    }
+
+    // Valeur du dernier scan, déjà corrigée avec la FVR si la voie a une compensation de l'alimentation
+    if (ADC_enuGetChannelValue(MCP9700_kpkstrGetSensorConfig(sensorId)->enuAdcChannelId, &adcValue) != ADC_eSTATUS_OK)
+    {
+        return MCP9700_NOK;
+    }
+
+    return MCP9700_calculateTemperature(&MCP9700_sensors[sensorId], adcValue, temperature);
+}
+
+MCP9700_status MCP9700_setSamplePeriod(const MCP9700_tenuSensorId sensorId, uint16_t periodMs)
+{
+    if ((sensorId <= MCP9700_eSENSOR_ID_BEGIN) || (sensorId >= MCP9700_eSENSOR_ID_END) ||
+        !MCP9700_sensors[sensorId].enabled || (periodMs == 0))
+    {
+        return MCP9700_NOK;
+    }
+
+    // Un capteur mesuré sur demande le reste
+    if (MCP9700_kpkstrGetSensorConfig(sensorId)->u16SamplePeriodMs == 0)
+    {
+        return MCP9700_NOK;
+    }
+
+    // La prochaine échéance est la dernière plus la nouvelle période : une période raccourcie s'applique aussitôt
+    MCP9700_sensors[sensorId].periodMs = periodMs;
+
+    return MCP9700_OK;
+}
+
+void MCP9700_requestSample(void)
+{
+    MCP9700_sampleRequested = true;
+}
+
+void MCP9700_process(void)
+{
+    ADC_tstrScanStatistics statistics;
+
+    if (!MCP9700_scanPending)
+    {
+        uint32_t nowUs = TIM1_u32GetTimestampUs();
+        bool interruptsEnabled = INTCONbits.GIE;
+        bool requested;
+        bool anyDue = false;
+
+        // Lecture et effacement atomiques : une demande faite en interruption entre les deux n'est pas perdue
+        INTCONbits.GIE = false;
+        requested = MCP9700_sampleRequested;
+        MCP9700_sampleRequested = false;
+        INTCONbits.GIE = interruptsEnabled;
+
+        for (MCP9700_tenuSensorId sensorId = MCP9700_eSENSOR_ID_BEGIN + 1; sensorId < MCP9700_eSENSOR_ID_END; sensorId++)
+        {
+            MCP9700_sensors[sensorId].due = MCP9700_isDue(sensorId, nowUs, requested);
+            anyDue = anyDue || MCP9700_sensors[sensorId].due;
+        }
+
+        // Un seul scan pour tous les capteurs ; ADC occupé : nouvel essai à l'appel suivant, la demande est conservée
+        if (!anyDue || (ADC_enuGetScanStatistics(&statistics) != ADC_eSTATUS_OK))
+        {
+            if (requested)
+            {
+                MCP9700_sampleRequested = true;
+            }
+            return;
+        }
+
+        MCP9700_scanPassCount = statistics.u32PassCount;
+
+        if (ADC_enuStartScan(MCP9700_CONFIG_SCAN_TIMEOUT_MS) != ADC_eSTATUS_OK)
+        {
+            if (requested)
+            {
+                MCP9700_sampleRequested = true;
+            }
+            return;
+        }
+
+        MCP9700_scanPending = true;
+
+        // Échéances avancées d'une période (sans dérive), ou recalées sur maintenant après un retard ou une demande
+        for (MCP9700_tenuSensorId sensorId = MCP9700_eSENSOR_ID_BEGIN + 1; sensorId < MCP9700_eSENSOR_ID_END; sensorId++)
+        {
+            MCP9700_sensor *sensor = &MCP9700_sensors[sensorId];
+            uint32_t periodUs = (uint32_t)sensor->periodMs * 1000UL;
+
+            if (!sensor->due)
+            {
+                continue;
+            }
+
+            if (sensor->scheduled && (periodUs != 0) && ((nowUs - sensor->lastSampleUs) >= periodUs) &&
+                ((nowUs - sensor->lastSampleUs) < (2 * periodUs)))
+            {
+                sensor->lastSampleUs += periodUs;
+            }
+            else
+            {
+                sensor->lastSampleUs = nowUs;
+            }
+
+            sensor->scheduled = true;
+        }
+    }
+
+    // En mode continu le scan se termine sous interruption, en mode single-shot il est déjà terminé
+    if ((ADC_enuGetScanStatistics(&statistics) == ADC_eSTATUS_OK) && (statistics.u32PassCount != MCP9700_scanPassCount))
+    {
+        MCP9700_scanPending = false;
+        MCP9700_deliverSamples();
+    }
+}
+
+#if (ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+MCP9700_status MCP9700_setChangeDelta(uint16_t deltaTenthDegC)
+{
+    // 10 mV/°C : un dixième de degré vaut 1 mV
+    uint32_t deltaSteps = (((uint32_t)deltaTenthDegC * ADC_RESOLUTION) + (ADC_REF_VOLTAGE_MV / 2)) / ADC_REF_VOLTAGE_MV;
+
+    if (deltaSteps == 0)
+    {
+        deltaSteps = 1;
+    }
+
+    if ((deltaSteps > INT16_MAX) || !ADC_bSetChangeDelta((uint16_t)deltaSteps))
+    {
+        return MCP9700_NOK;
+    }
+
+    return MCP9700_OK;
+}
+#endif
+
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
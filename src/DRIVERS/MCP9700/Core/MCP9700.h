@@ -30,11 +30,15 @@
 
 #include "Common.h"
 #include "ADC.h"
+#include "MCP9700_cfg.h"
 
 /**********************************************************************************************************************/
 /* CONSTANTS, MACROS                                                                                                  */
 /**********************************************************************************************************************/
 
+// Les températures sont données en 0.01 °C (2345 = 23.45 °C)
+#define MCP9700_TEMPERATURE_SCALE 100
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -45,13 +49,38 @@ typedef enum
     MCP9700_NOK
 } MCP9700_status;
 
+// Consommateur des mesures : identifiant du capteur et température en 0.01 °C
+typedef void (*MCP9700_sampleCallback)(const MCP9700_tenuSensorId sensorId, const int16_t temperature);
+
 /**********************************************************************************************************************/
 /* PUBLIC FUNCTION PROTOTYPES                                                                                         */
 /**********************************************************************************************************************/
 
-MCP9700_status MCP9700_getTemperature(int16_t *temperature);
+// Coefficients de conversion de chaque capteur de MCP9700_cfg.c, un capteur mal configuré est désactivé
+MCP9700_status MCP9700_init(void);
+
+// Un seul consommateur, appelé depuis MCP9700_process
+MCP9700_status MCP9700_registerSampleCallback(MCP9700_sampleCallback callback);
+
+// Température en 0.01 °C, de -4000 à 12500, convertie par le dernier scan de l'ADC
+MCP9700_status MCP9700_getTemperature(const MCP9700_tenuSensorId sensorId, int16_t *temperature);
+
+// Période de mesure d'un capteur en ms, celle de MCP9700_cfg.c à l'initialisation (refusée pour un capteur mesuré sur
+// demande uniquement)
+MCP9700_status MCP9700_setSamplePeriod(const MCP9700_tenuSensorId sensorId, uint16_t periodMs);
+
+// Tous les capteurs actifs sont mesurés au prochain scan, sans attendre leur période (peut être appelé en interruption)
+void MCP9700_requestSample(void);
+
+// Ordonnanceur (boucle principale) : un seul scan de l'ADC pour tous les capteurs dont la période est écoulée, puis
+// chaque mesure est transmise au consommateur avec l'identifiant du capteur
+void MCP9700_process(void);
 
-//MCP9700_status MCP9700_getRawValue(uint16_t *adcValue);
+#if (ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+// Variation de température (en dixièmes de degré) de la voie principale de l'ADC nécessaire pour signaler une nouvelle
+// valeur, avec la pente nominale du MCP9700
+MCP9700_status MCP9700_setChangeDelta(uint16_t deltaTenthDegC);
+#endif
 
 /**********************************************************************************************************************/
 #endif /* MCP9700_H_ */
@@ -0,0 +1,68 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      NVLog_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     NVLog Driver conf part
+ * @details   Module in charge of the persistent log of the samples in the data EEPROM
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef NVLOG_CFG_H_
+#define NVLOG_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the area of the data EEPROM used by the log: its first address, the size of a page and the number of
+ *        pages (at least 2)
+ * @remark The pages are written in a circle, each byte is written once per turn: with 100k cycles of endurance and
+ *         about 1.4 byte per sample, the 1 KB area stores about 70 million samples (7 months at 4 samples per second)
+ */
+#define NVL_CONFIG_START_ADDRESS                            0
+#define NVL_CONFIG_PAGE_SIZE                                64
+#define NVL_CONFIG_PAGE_COUNT                               16
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of samples of a record (1 to 81, a full record shall fit in a page), the samples wait in
+ *        RAM until a record is full
+ * @remark A larger record lowers the cost of the CRC, but more samples are lost at a reset
+ */
+#define NVL_CONFIG_SAMPLES_PER_RECORD                       8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of samples waiting in RAM (at least @ref NVL_CONFIG_SAMPLES_PER_RECORD), the new samples are
+ *        dropped when it is full (EEPROM writes slower than the sampling)
+ */
+#define NVL_CONFIG_STAGING_LENGTH                           16
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* NVLOG_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,815 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      NVLog.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     NVLog Driver core part
+ * @details   Module in charge of the persistent log of the samples in the data EEPROM
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "NVM.h"
+#include "NVLog.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Sizes of the page header, of the record overhead (length and CRC) and of the largest record
+ */
+#define NVL_PAGE_HEADER_SIZE                                8
+#define NVL_RECORD_OVERHEAD                                 3
+#define NVL_MAX_PAYLOAD_SIZE                                (NVL_CONFIG_SAMPLES_PER_RECORD * 3)
+#define NVL_MAX_RECORD_SIZE                                 (NVL_MAX_PAYLOAD_SIZE + NVL_RECORD_OVERHEAD)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if((NVL_CONFIG_PAGE_COUNT < 2) || (NVL_CONFIG_PAGE_COUNT > 255))
+#  error "[NVL ] Error: The setting NVL_CONFIG_PAGE_COUNT must be between 2 and 255"
+#endif
+
+#if((NVL_CONFIG_START_ADDRESS + (NVL_CONFIG_PAGE_SIZE * NVL_CONFIG_PAGE_COUNT)) > NVM_EEPROM_SIZE)
+#  error "[NVL ] Error: The log area does not fit in the data EEPROM"
+#endif
+
+#if((NVL_CONFIG_SAMPLES_PER_RECORD < 1) || (NVL_CONFIG_SAMPLES_PER_RECORD > 81))
+#  error "[NVL ] Error: The setting NVL_CONFIG_SAMPLES_PER_RECORD must be between 1 and 81"
+#endif
+
+#if((NVL_CONFIG_PAGE_SIZE < (NVL_PAGE_HEADER_SIZE + NVL_MAX_RECORD_SIZE)) || (NVL_CONFIG_PAGE_SIZE > 256))
+#  error "[NVL ] Error: The setting NVL_CONFIG_PAGE_SIZE must hold the header and a full record, up to 256 bytes"
+#endif
+
+#if((NVL_CONFIG_STAGING_LENGTH < NVL_CONFIG_SAMPLES_PER_RECORD) || (NVL_CONFIG_STAGING_LENGTH > 255))
+#  error "[NVL ] Error: The setting NVL_CONFIG_STAGING_LENGTH must be between NVL_CONFIG_SAMPLES_PER_RECORD and 255"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Escape byte of the payload, followed by an absolute value
+ */
+#define NVL_DELTA_ESCAPE                                    0x80
+#define NVL_DELTA_MAX                                       127
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Base index of a page without valid header
+ */
+#define NVL_INVALID_INDEX                                   0xFFFFFFFFUL
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief CRC-16/CCITT-FALSE: polynomial and initial value
+ */
+#define NVL_CRC_POLYNOMIAL                                  0x1021U
+#define NVL_CRC_INITIAL_VALUE                               0xFFFFU
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macro used to get the EEPROM address of a byte of a page
+ */
+#define NVL_mADDRESS(_PAGE_, _OFFSET_)                      ((uint16_t)(NVL_CONFIG_START_ADDRESS + \
+                                                                        ((uint16_t)(_PAGE_) * NVL_CONFIG_PAGE_SIZE) + \
+                                                                        (_OFFSET_)))
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Index of the base sample of each page (NVL_INVALID_INDEX without valid header)
+ */
+static uint32_t NVL_au32PageBases[NVL_CONFIG_PAGE_COUNT];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief End of the log: the latest page, the offset after its latest record, the latest value and the index of the
+ *        first sample which is not written yet (a new page is opened for the first record after a mount which skipped
+ *        indexes)
+ */
+static bool     NVL_bHasPage                                = false;
+static bool     NVL_bNewPageRequired                        = false;
+static uint8_t  NVL_u8CurrentPage                           = 0;
+static uint16_t NVL_u16WriteOffset                          = 0;
+static int16_t  NVL_s16LastValue                            = 0;
+static uint32_t NVL_u32StoredIndex                          = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Samples waiting in RAM (the first NVL_u8WritingCount ones are being written), the first one has the index
+ *        NVL_u32StoredIndex
+ */
+static int16_t  NVL_as16Staged[NVL_CONFIG_STAGING_LENGTH];
+static uint8_t  NVL_u8StagedHead                            = 0;
+static uint8_t  NVL_u8StagedCount                           = 0;
+static uint8_t  NVL_u8WritingCount                          = 0;
+static uint16_t NVL_u16DroppedCount                         = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Bytes being written: the page header (new page) and the record, at consecutive addresses
+ */
+static uint8_t  NVL_au8WriteBuffer[NVL_PAGE_HEADER_SIZE + NVL_MAX_RECORD_SIZE];
+static uint16_t NVL_u16WriteAddress                         = 0;
+static uint8_t  NVL_u8WriteLength                           = 0;
+static uint8_t  NVL_u8WriteIndex                            = 0;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to update a CRC-16 with a byte (bit by bit, no table in RAM)
+ */
+static uint16_t u16UpdateCrc(uint16_t u16Crc, const uint8_t ku8Data);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to compute the CRC of a record, starting with the base index of its page
+ */
+static uint16_t u16ComputeRecordCrc(const uint32_t ku32PageBase, uint8_t const * const kpku8Payload, const uint8_t ku8Length);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to delta-encode samples
+ * @return The length of the payload
+ */
+static uint8_t u8EncodeSamples(int16_t s16Previous,
+                               int16_t const * const kpks16Samples,
+                               const uint8_t ku8Count,
+                               uint8_t * const kpu8Payload);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to decode a payload
+ * @param[inout] kps16Previous: The value before the record, updated with the latest decoded value
+ * @return The number of decoded samples, 0 if the payload is malformed
+ */
+static uint8_t u8DecodeSamples(uint8_t const * const kpku8Payload,
+                               const uint8_t ku8Length,
+                               int16_t * const kps16Previous,
+                               int16_t * const kps16Samples);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read bytes of the EEPROM
+ * @return Return "true" if all the bytes were read, return "false" otherwise (write in progress)
+ */
+static bool bReadBytes(const uint16_t ku16Address, uint8_t * const kpu8Data, const uint8_t ku8Length);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read and check a record
+ * @param[out] kpu8Length: The length of its payload
+ * @return The status of the reading, @ref NVL_eSTATUS_NO_SAMPLE if the record is not valid (end of the page data)
+ */
+static NVL_tenuStatus enuReadRecord(const uint8_t ku8Page,
+                                    const uint16_t ku16Offset,
+                                    uint8_t * const kpu8Length,
+                                    uint8_t * const kpu8Payload);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read the samples of a page from a given index
+ * @param[inout] kpu32Index: The index of the next sample to read, updated with the read samples
+ * @param[inout]  kpu8Count: The number of samples in the output buffer, updated with the read samples
+ */
+static NVL_tenuStatus enuReadPage(const uint8_t ku8Page,
+                                  uint32_t * const kpu32Index,
+                                  int16_t * const kps16Values,
+                                  uint8_t * const kpu8Count,
+                                  const uint8_t ku8MaxCount);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to encode a record with the first waiting samples (and a page header if the record does not
+ *        fit in the current page) in the write buffer
+ */
+static void vidCommitRecord(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get a waiting sample
+ */
+static int16_t s16GetStagedSample(const uint8_t ku8Position);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static uint16_t u16UpdateCrc(uint16_t u16Crc, const uint8_t ku8Data)
+{
+  uint8_t u8Bit = 0;
+
+  u16Crc ^= ((uint16_t)ku8Data << 8);
+
+  for(u8Bit = 0; u8Bit < 8; u8Bit++)
+  {
+    u16Crc = ((u16Crc & 0x8000U) != 0) ? (uint16_t)((u16Crc << 1) ^ NVL_CRC_POLYNOMIAL) : (uint16_t)(u16Crc << 1);
+  }
+
+  return u16Crc;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint16_t u16ComputeRecordCrc(const uint32_t ku32PageBase, uint8_t const * const kpku8Payload, const uint8_t ku8Length)
+{
+  uint16_t u16Crc = NVL_CRC_INITIAL_VALUE;
+  uint8_t  u8Byte = 0;
+
+  u16Crc = u16UpdateCrc(u16Crc, (uint8_t)ku32PageBase);
+  u16Crc = u16UpdateCrc(u16Crc, (uint8_t)(ku32PageBase >> 8));
+  u16Crc = u16UpdateCrc(u16Crc, (uint8_t)(ku32PageBase >> 16));
+  u16Crc = u16UpdateCrc(u16Crc, (uint8_t)(ku32PageBase >> 24));
+  u16Crc = u16UpdateCrc(u16Crc, ku8Length);
+
+  for(u8Byte = 0; u8Byte < ku8Length; u8Byte++)
+  {
+    u16Crc = u16UpdateCrc(u16Crc, kpku8Payload[u8Byte]);
+  }
+
+  return u16Crc;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8EncodeSamples(int16_t s16Previous,
+                               int16_t const * const kpks16Samples,
+                               const uint8_t ku8Count,
+                               uint8_t * const kpu8Payload)
+{
+  uint8_t u8Length = 0;
+  uint8_t u8Sample = 0;
+  int32_t s32Delta = 0;
+
+  for(u8Sample = 0; u8Sample < ku8Count; u8Sample++)
+  {
+    s32Delta = (int32_t)kpks16Samples[u8Sample] - s16Previous;
+
+    if((s32Delta >= -NVL_DELTA_MAX) && (s32Delta <= NVL_DELTA_MAX))
+    {
+      kpu8Payload[u8Length++] = (uint8_t)(int8_t)s32Delta;
+    }
+    else
+    {
+      kpu8Payload[u8Length++] = NVL_DELTA_ESCAPE;
+      kpu8Payload[u8Length++] = (uint8_t)kpks16Samples[u8Sample];
+      kpu8Payload[u8Length++] = (uint8_t)((uint16_t)kpks16Samples[u8Sample] >> 8);
+    }
+
+    s16Previous = kpks16Samples[u8Sample];
+  }
+
+  return u8Length;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8DecodeSamples(uint8_t const * const kpku8Payload,
+                               const uint8_t ku8Length,
+                               int16_t * const kps16Previous,
+                               int16_t * const kps16Samples)
+{
+  uint8_t u8Count    = 0;
+  uint8_t u8Position = 0;
+  bool    bIsValid   = true;
+
+  while((u8Position < ku8Length) && (bIsValid == true))
+  {
+    if(u8Count >= NVL_CONFIG_SAMPLES_PER_RECORD)
+    {
+      bIsValid = false;
+    }
+    else if(kpku8Payload[u8Position] != NVL_DELTA_ESCAPE)
+    {
+      *kps16Previous = (int16_t)(*kps16Previous + (int8_t)kpku8Payload[u8Position]);
+      kps16Samples[u8Count++] = *kps16Previous;
+      u8Position++;
+    }
+    else if((u8Position + 2) < ku8Length)
+    {
+      *kps16Previous = (int16_t)((uint16_t)kpku8Payload[u8Position + 1] | ((uint16_t)kpku8Payload[u8Position + 2] << 8));
+      kps16Samples[u8Count++] = *kps16Previous;
+      u8Position += 3;
+    }
+    else
+    {
+      bIsValid = false;
+    }
+  }
+
+  return (bIsValid == true) ? u8Count : 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bReadBytes(const uint16_t ku16Address, uint8_t * const kpu8Data, const uint8_t ku8Length)
+{
+  bool    bStatus = true;
+  uint8_t u8Byte  = 0;
+
+  for(u8Byte = 0; (u8Byte < ku8Length) && (bStatus == true); u8Byte++)
+  {
+    bStatus = NVM_bReadEeprom(ku16Address + u8Byte, &kpu8Data[u8Byte]);
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static NVL_tenuStatus enuReadRecord(const uint8_t ku8Page,
+                                    const uint16_t ku16Offset,
+                                    uint8_t * const kpu8Length,
+                                    uint8_t * const kpu8Payload)
+{
+  NVL_tenuStatus enuStatus = NVL_eSTATUS_NO_SAMPLE;
+  uint8_t        au8Crc[2];
+
+  if((ku16Offset + NVL_RECORD_OVERHEAD) > NVL_CONFIG_PAGE_SIZE)
+  {
+    enuStatus = NVL_eSTATUS_NO_SAMPLE;
+  }
+  else if(bReadBytes(NVL_mADDRESS(ku8Page, ku16Offset), kpu8Length, 1) == false)
+  {
+    enuStatus = NVL_eSTATUS_BUSY;
+  }
+  else if((*kpu8Length == 0) || (*kpu8Length > NVL_MAX_PAYLOAD_SIZE) ||
+          ((ku16Offset + *kpu8Length + NVL_RECORD_OVERHEAD) > NVL_CONFIG_PAGE_SIZE))
+  {
+    enuStatus = NVL_eSTATUS_NO_SAMPLE;
+  }
+  else if((bReadBytes(NVL_mADDRESS(ku8Page, ku16Offset + 1), kpu8Payload, *kpu8Length) == false) ||
+          (bReadBytes(NVL_mADDRESS(ku8Page, ku16Offset + 1 + *kpu8Length), au8Crc, 2) == false))
+  {
+    enuStatus = NVL_eSTATUS_BUSY;
+  }
+  else if(u16ComputeRecordCrc(NVL_au32PageBases[ku8Page], kpu8Payload, *kpu8Length) ==
+          ((uint16_t)au8Crc[0] | ((uint16_t)au8Crc[1] << 8)))
+  {
+    enuStatus = NVL_eSTATUS_OK;
+  }
+  else
+  {
+    enuStatus = NVL_eSTATUS_NO_SAMPLE;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static NVL_tenuStatus enuReadPage(const uint8_t ku8Page,
+                                  uint32_t * const kpu32Index,
+                                  int16_t * const kps16Values,
+                                  uint8_t * const kpu8Count,
+                                  const uint8_t ku8MaxCount)
+{
+  NVL_tenuStatus enuStatus  = NVL_eSTATUS_NO_OK;
+  uint32_t       u32Index   = NVL_au32PageBases[ku8Page];
+  uint16_t       u16Offset  = NVL_PAGE_HEADER_SIZE;
+  int16_t        s16Value   = 0;
+  uint8_t        u8Length   = 0;
+  uint8_t        u8Decoded  = 0;
+  uint8_t        u8Sample   = 0;
+  uint8_t        au8Payload[NVL_MAX_PAYLOAD_SIZE];
+  int16_t        as16Samples[NVL_CONFIG_SAMPLES_PER_RECORD];
+
+  if(bReadBytes(NVL_mADDRESS(ku8Page, 4), au8Payload, 2) == false)
+  {
+    enuStatus = NVL_eSTATUS_BUSY;
+  }
+  else
+  {
+    // The base sample is in the header:
+    s16Value = (int16_t)((uint16_t)au8Payload[0] | ((uint16_t)au8Payload[1] << 8));
+
+    if((u32Index == *kpu32Index) && (*kpu8Count < ku8MaxCount))
+    {
+      kps16Values[(*kpu8Count)++] = s16Value;
+      (*kpu32Index)++;
+    }
+
+    u32Index++;
+    enuStatus = NVL_eSTATUS_OK;
+
+    // The records are decoded up to the requested samples, the end of the page data or the samples not written yet:
+    while((enuStatus == NVL_eSTATUS_OK) && (*kpu8Count < ku8MaxCount) && (u32Index < NVL_u32StoredIndex))
+    {
+      enuStatus = enuReadRecord(ku8Page, u16Offset, &u8Length, au8Payload);
+
+      if(enuStatus == NVL_eSTATUS_OK)
+      {
+        u8Decoded = u8DecodeSamples(au8Payload, u8Length, &s16Value, as16Samples);
+        enuStatus = (u8Decoded > 0) ? NVL_eSTATUS_OK : NVL_eSTATUS_NO_SAMPLE;
+
+        for(u8Sample = 0; u8Sample < u8Decoded; u8Sample++)
+        {
+          if((u32Index == *kpu32Index) && (*kpu8Count < ku8MaxCount))
+          {
+            kps16Values[(*kpu8Count)++] = as16Samples[u8Sample];
+            (*kpu32Index)++;
+          }
+
+          u32Index++;
+        }
+
+        u16Offset += (uint16_t)u8Length + NVL_RECORD_OVERHEAD;
+      }
+    }
+
+    // The end of the page data is not an error:
+    if(enuStatus == NVL_eSTATUS_NO_SAMPLE)
+    {
+      enuStatus = NVL_eSTATUS_OK;
+    }
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidCommitRecord(void)
+{
+  int16_t  as16Samples[NVL_CONFIG_SAMPLES_PER_RECORD];
+  uint8_t  au8Payload[NVL_MAX_PAYLOAD_SIZE];
+  uint8_t  u8Sample    = 0;
+  uint8_t  u8First     = 0;
+  uint8_t  u8Length    = 0;
+  uint8_t  u8Position  = 0;
+  uint16_t u16Crc      = 0;
+  int16_t  s16Previous = NVL_s16LastValue;
+
+  for(u8Sample = 0; u8Sample < NVL_CONFIG_SAMPLES_PER_RECORD; u8Sample++)
+  {
+    as16Samples[u8Sample] = s16GetStagedSample(u8Sample);
+  }
+
+  u8Length = u8EncodeSamples(s16Previous, as16Samples, NVL_CONFIG_SAMPLES_PER_RECORD, au8Payload);
+
+  if((NVL_bHasPage == false) || (NVL_bNewPageRequired == true) ||
+     ((NVL_u16WriteOffset + u8Length + NVL_RECORD_OVERHEAD) > NVL_CONFIG_PAGE_SIZE))
+  {
+    // A new page is opened, the oldest one of the circle: its base is the first sample, the others are encoded again
+    NVL_u8CurrentPage = (NVL_bHasPage == false) ? 0 : (uint8_t)((NVL_u8CurrentPage + 1) % NVL_CONFIG_PAGE_COUNT);
+    NVL_bHasPage         = true;
+    NVL_bNewPageRequired = false;
+
+    NVL_au32PageBases[NVL_u8CurrentPage] = NVL_u32StoredIndex;
+
+    NVL_au8WriteBuffer[0] = (uint8_t)NVL_u32StoredIndex;
+    NVL_au8WriteBuffer[1] = (uint8_t)(NVL_u32StoredIndex >> 8);
+    NVL_au8WriteBuffer[2] = (uint8_t)(NVL_u32StoredIndex >> 16);
+    NVL_au8WriteBuffer[3] = (uint8_t)(NVL_u32StoredIndex >> 24);
+    NVL_au8WriteBuffer[4] = (uint8_t)as16Samples[0];
+    NVL_au8WriteBuffer[5] = (uint8_t)((uint16_t)as16Samples[0] >> 8);
+
+    u16Crc = NVL_CRC_INITIAL_VALUE;
+
+    for(u8Position = 0; u8Position < 6; u8Position++)
+    {
+      u16Crc = u16UpdateCrc(u16Crc, NVL_au8WriteBuffer[u8Position]);
+    }
+
+    NVL_au8WriteBuffer[6] = (uint8_t)u16Crc;
+    NVL_au8WriteBuffer[7] = (uint8_t)(u16Crc >> 8);
+
+    NVL_u16WriteAddress = NVL_mADDRESS(NVL_u8CurrentPage, 0);
+    NVL_u16WriteOffset  = NVL_PAGE_HEADER_SIZE;
+    u8Position          = NVL_PAGE_HEADER_SIZE;
+    s16Previous         = as16Samples[0];
+    u8First             = 1;
+
+    u8Length = u8EncodeSamples(s16Previous,
+                               &as16Samples[u8First],
+                               NVL_CONFIG_SAMPLES_PER_RECORD - u8First,
+                               au8Payload);
+  }
+  else
+  {
+    NVL_u16WriteAddress = NVL_mADDRESS(NVL_u8CurrentPage, NVL_u16WriteOffset);
+    u8Position          = 0;
+  }
+
+  if(u8Length > 0)
+  {
+    u16Crc = u16ComputeRecordCrc(NVL_au32PageBases[NVL_u8CurrentPage], au8Payload, u8Length);
+
+    NVL_au8WriteBuffer[u8Position++] = u8Length;
+
+    for(u8Sample = 0; u8Sample < u8Length; u8Sample++)
+    {
+      NVL_au8WriteBuffer[u8Position++] = au8Payload[u8Sample];
+    }
+
+    NVL_au8WriteBuffer[u8Position++] = (uint8_t)u16Crc;
+    NVL_au8WriteBuffer[u8Position++] = (uint8_t)(u16Crc >> 8);
+
+    NVL_u16WriteOffset += (uint16_t)u8Length + NVL_RECORD_OVERHEAD;
+  }
+
+  NVL_s16LastValue   = as16Samples[NVL_CONFIG_SAMPLES_PER_RECORD - 1];
+  NVL_u8WritingCount = NVL_CONFIG_SAMPLES_PER_RECORD;
+  NVL_u8WriteLength  = u8Position;
+  NVL_u8WriteIndex   = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static int16_t s16GetStagedSample(const uint8_t ku8Position)
+{
+  uint16_t u16Index = (uint16_t)NVL_u8StagedHead + ku8Position;
+
+  if(u16Index >= NVL_CONFIG_STAGING_LENGTH)
+  {
+    u16Index -= NVL_CONFIG_STAGING_LENGTH;
+  }
+
+  return NVL_as16Staged[u16Index];
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void NVL_vidInitialize(void)
+{
+  uint8_t  u8Page     = 0;
+  uint8_t  u8Byte     = 0;
+  uint16_t u16Crc     = 0;
+  uint16_t u16Offset  = NVL_PAGE_HEADER_SIZE;
+  uint8_t  u8Length   = 0;
+  uint8_t  u8Decoded  = 0;
+  uint8_t  au8Header[NVL_PAGE_HEADER_SIZE];
+  uint8_t  au8Payload[NVL_MAX_PAYLOAD_SIZE];
+  int16_t  as16Samples[NVL_CONFIG_SAMPLES_PER_RECORD];
+
+  NVL_bHasPage         = false;
+  NVL_bNewPageRequired = false;
+  NVL_u8CurrentPage    = 0;
+  NVL_u32StoredIndex   = 0;
+  NVL_u8StagedHead     = 0;
+  NVL_u8StagedCount    = 0;
+  NVL_u8WritingCount   = 0;
+  NVL_u16DroppedCount  = 0;
+  NVL_u8WriteLength    = 0;
+  NVL_u8WriteIndex     = 0;
+
+  // 1) The valid page headers give the base index of the pages, the latest page has the greatest one:
+  for(u8Page = 0; u8Page < NVL_CONFIG_PAGE_COUNT; u8Page++)
+  {
+    NVL_au32PageBases[u8Page] = NVL_INVALID_INDEX;
+
+    if(bReadBytes(NVL_mADDRESS(u8Page, 0), au8Header, NVL_PAGE_HEADER_SIZE) == true)
+    {
+      u16Crc = NVL_CRC_INITIAL_VALUE;
+
+      for(u8Byte = 0; u8Byte < 6; u8Byte++)
+      {
+        u16Crc = u16UpdateCrc(u16Crc, au8Header[u8Byte]);
+      }
+
+      if(u16Crc == ((uint16_t)au8Header[6] | ((uint16_t)au8Header[7] << 8)))
+      {
+        NVL_au32PageBases[u8Page] = (uint32_t)au8Header[0]         | ((uint32_t)au8Header[1] << 8) |
+                                    ((uint32_t)au8Header[2] << 16) | ((uint32_t)au8Header[3] << 24);
+
+        if((NVL_au32PageBases[u8Page] != NVL_INVALID_INDEX) &&
+           ((NVL_bHasPage == false) || (NVL_au32PageBases[u8Page] > NVL_au32PageBases[NVL_u8CurrentPage])))
+        {
+          NVL_bHasPage      = true;
+          NVL_u8CurrentPage = u8Page;
+          NVL_s16LastValue  = (int16_t)((uint16_t)au8Header[4] | ((uint16_t)au8Header[5] << 8));
+        }
+      }
+    }
+  }
+
+  // 2) The records of the latest page are read up to the first invalid one, the next records are written there:
+  if(NVL_bHasPage == true)
+  {
+    NVL_u32StoredIndex = NVL_au32PageBases[NVL_u8CurrentPage] + 1;
+
+    do
+    {
+      u8Decoded = 0;
+
+      if(enuReadRecord(NVL_u8CurrentPage, u16Offset, &u8Length, au8Payload) == NVL_eSTATUS_OK)
+      {
+        u8Decoded = u8DecodeSamples(au8Payload, u8Length, &NVL_s16LastValue, as16Samples);
+      }
+
+      if(u8Decoded > 0)
+      {
+        NVL_u32StoredIndex += u8Decoded;
+        u16Offset          += (uint16_t)u8Length + NVL_RECORD_OVERHEAD;
+      }
+    }
+    while(u8Decoded > 0);
+
+    // 3) The indexes of the samples lost in RAM at the reset may have been given out (see NVL_u32GetNextIndex): they
+    //    are skipped and the next record opens a page based after them, an index is never given to two samples
+    NVL_u32StoredIndex  += NVL_CONFIG_STAGING_LENGTH;
+    NVL_bNewPageRequired = true;
+  }
+
+  NVL_u16WriteOffset = u16Offset;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void NVL_vidPushSample(const int16_t ks16Value)
+{
+  uint16_t u16Index = 0;
+
+  if(NVL_u8StagedCount < NVL_CONFIG_STAGING_LENGTH)
+  {
+    u16Index = (uint16_t)NVL_u8StagedHead + NVL_u8StagedCount;
+
+    if(u16Index >= NVL_CONFIG_STAGING_LENGTH)
+    {
+      u16Index -= NVL_CONFIG_STAGING_LENGTH;
+    }
+
+    NVL_as16Staged[u16Index] = ks16Value;
+    NVL_u8StagedCount++;
+  }
+  else if(NVL_u16DroppedCount < UINT16_MAX)
+  {
+    NVL_u16DroppedCount++;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void NVL_vidProcess(void)
+{
+  if(NVL_u8WriteLength != 0)
+  {
+    if(NVM_bIsBusy() == false)
+    {
+      if(NVL_u8WriteIndex < NVL_u8WriteLength)
+      {
+        if(NVM_bStartEepromWrite(NVL_u16WriteAddress + NVL_u8WriteIndex, NVL_au8WriteBuffer[NVL_u8WriteIndex]) == true)
+        {
+          NVL_u8WriteIndex++;
+        }
+      }
+      else
+      {
+        // The record is written: its samples leave the RAM buffer
+        NVL_u8StagedHead    = (uint8_t)((NVL_u8StagedHead + NVL_u8WritingCount) % NVL_CONFIG_STAGING_LENGTH);
+        NVL_u8StagedCount  -= NVL_u8WritingCount;
+        NVL_u32StoredIndex += NVL_u8WritingCount;
+        NVL_u8WritingCount  = 0;
+        NVL_u8WriteLength   = 0;
+      }
+    }
+  }
+  else if(NVL_u8StagedCount >= NVL_CONFIG_SAMPLES_PER_RECORD)
+  {
+    vidCommitRecord();
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint32_t NVL_u32GetOldestIndex(void)
+{
+  uint32_t u32Oldest = NVL_u32StoredIndex;
+  uint8_t  u8Page    = 0;
+
+  for(u8Page = 0; u8Page < NVL_CONFIG_PAGE_COUNT; u8Page++)
+  {
+    if(NVL_au32PageBases[u8Page] < u32Oldest)
+    {
+      u32Oldest = NVL_au32PageBases[u8Page];
+    }
+  }
+
+  return u32Oldest;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint32_t NVL_u32GetNextIndex(void)
+{
+  return NVL_u32StoredIndex + NVL_u8StagedCount;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint16_t NVL_u16GetDroppedCount(void)
+{
+  return NVL_u16DroppedCount;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+NVL_tenuStatus NVL_enuReadSamples(const uint32_t ku32FirstIndex,
+                                  int16_t * const kps16Values,
+                                  const uint8_t ku8MaxCount,
+                                  uint8_t * const kpu8Count)
+{
+  NVL_tenuStatus enuStatus = NVL_eSTATUS_OK;
+  uint32_t       u32Index  = ku32FirstIndex;
+  uint8_t        u8Page    = 0;
+  bool           bHasPage  = false;
+  uint8_t        u8Found   = 0;
+  uint8_t        u8Before  = 0;
+
+  if((kps16Values == NULL) || (kpu8Count == NULL))
+  {
+    enuStatus = NVL_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpu8Count = 0;
+
+    while((enuStatus == NVL_eSTATUS_OK) && (*kpu8Count < ku8MaxCount) && (u32Index < NVL_u32GetNextIndex()))
+    {
+      if(u32Index >= NVL_u32StoredIndex)
+      {
+        // Sample waiting in RAM (or being written):
+        kps16Values[(*kpu8Count)++] = s16GetStagedSample((uint8_t)(u32Index - NVL_u32StoredIndex));
+        u32Index++;
+      }
+      else
+      {
+        // The sample is in the page with the greatest base lower or equal to its index:
+        bHasPage = false;
+
+        for(u8Page = 0; u8Page < NVL_CONFIG_PAGE_COUNT; u8Page++)
+        {
+          if((NVL_au32PageBases[u8Page] <= u32Index) &&
+             ((bHasPage == false) || (NVL_au32PageBases[u8Page] > NVL_au32PageBases[u8Found])))
+          {
+            bHasPage = true;
+            u8Found  = u8Page;
+          }
+        }
+
+        u8Before  = *kpu8Count;
+        enuStatus = (bHasPage == true) ? enuReadPage(u8Found, &u32Index, kps16Values, kpu8Count, ku8MaxCount) :
+                                         NVL_eSTATUS_NO_SAMPLE;
+
+        // The page does not hold the sample (overwritten or lost record):
+        if((enuStatus == NVL_eSTATUS_OK) && (*kpu8Count == u8Before))
+        {
+          enuStatus = NVL_eSTATUS_NO_SAMPLE;
+        }
+      }
+    }
+
+    // The samples read before a write or a missing sample are returned:
+    if(*kpu8Count > 0)
+    {
+      enuStatus = NVL_eSTATUS_OK;
+    }
+    else if(enuStatus == NVL_eSTATUS_OK)
+    {
+      enuStatus = NVL_eSTATUS_NO_SAMPLE;
+    }
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
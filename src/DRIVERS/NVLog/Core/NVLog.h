@@ -0,0 +1,139 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      NVLog.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     NVLog Driver core part
+ * @details   Module in charge of the persistent log of the samples in the data EEPROM. The log is a circle of pages
+ *            written in sequence (each byte is written once per turn, no fixed cell is rewritten), each page starts
+ *            with a header and holds delta-encoded records protected by a CRC:
+ *              - Page header: [0..3] index of the base sample, [4..5] base value, [6..7] CRC-16 of [0..5]
+ *              - Record: [0] payload length L, [1..L] payload, [L+1..L+2] CRC-16 of the page base index, L and the
+ *                payload (a record of a previous turn thus never matches)
+ *              - Payload: for each sample, its delta to the previous one on 1 byte (-127 to 127) or the escape byte
+ *                0x80 followed by its value on 2 bytes
+ *            All the fields are little endian, the samples are numbered from 0 since the first mount of the log.
+ *            At the mount, only the page headers and the records of the latest page are read: the first invalid
+ *            record is the end of the log (a record cut by a reset is overwritten). The indexes of the samples which
+ *            may have been lost in RAM are then skipped, the log continues in a new page.
+ *            The writes never wait: the samples are buffered in RAM and @ref NVL_vidProcess starts a byte write when
+ *            the EEPROM is idle
+ *
+ * @remark    The module only uses NVM_bReadEeprom, NVM_bStartEepromWrite and NVM_bIsBusy, which can be simulated on a
+ *            host
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef NVLOG_H_
+#define NVLOG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "NVLog_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum NVL_tenuStatus
+{
+  NVL_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  NVL_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  NVL_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  NVL_eSTATUS_BUSY,                                               //!< The EEPROM is being written, retry later
+  NVL_eSTATUS_NO_SAMPLE,                                          //!< The requested sample is not stored
+  NVL_eSTATUS_COUNT                                               //!< The total number of return code
+}NVL_tenuStatus;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to mount the log: the end of the log is searched, the next samples are appended to it
+ * @remark The function reads the EEPROM, it shall be called when no write is in progress (initialization)
+ */
+void NVL_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to append a sample to the log, it is buffered in RAM until it is written
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe)
+ * @param[in] ks16Value: The value of the sample
+ */
+void NVL_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to write the buffered samples, one byte per call when the EEPROM is idle (main loop)
+ */
+void NVL_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the index of the oldest sample of the log
+ * @return The index of the oldest sample (equal to @ref NVL_u32GetNextIndex if the log is empty)
+ */
+uint32_t NVL_u32GetOldestIndex(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the index of the next pushed sample
+ * @remark The index is never given to another sample, even after a reset (a gap of @ref NVL_CONFIG_STAGING_LENGTH
+ *         indexes is left at the mount, unless the reset occurs before the first record of the previous mount is
+ *         written): it can be used as a sequence number
+ * @return The index of the next sample
+ */
+uint32_t NVL_u32GetNextIndex(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the number of samples dropped since the initialization (RAM buffer full)
+ * @return The number of dropped samples (saturated)
+ */
+uint16_t NVL_u16GetDroppedCount(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read consecutive samples of the log (from the EEPROM or from the RAM buffer)
+ * @remark The EEPROM cannot be read during a write: the function is best called just before @ref NVL_vidProcess
+ * @param[in]   ku32FirstIndex: The index of the first sample
+ * @param[out]    kps16Values: The read samples
+ * @param[in]     ku8MaxCount: The maximal number of samples to read
+ * @param[out]      kpu8Count: The number of read samples (lower at the end of the log, before the indexes skipped at
+ *                             a mount or if a write started)
+ * @return The status of the reading, @ref NVL_eSTATUS_NO_SAMPLE if the first sample is not stored (overwritten, skipped
+ *         at a mount or not pushed yet), @ref NVL_eSTATUS_BUSY if no sample could be read because of a write
+ */
+NVL_tenuStatus NVL_enuReadSamples(const uint32_t ku32FirstIndex,
+                                  int16_t * const kps16Values,
+                                  const uint8_t ku8MaxCount,
+                                  uint8_t * const kpu8Count);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // NVLOG_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
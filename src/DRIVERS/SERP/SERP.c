@@ -94,7 +94,7 @@ static void SERP_vidRxCallback(char const * const kpkau8Data,
 {
     if (kenuStatus != EUSART_eSTATUS_OK)
     {
-        CMN_systemPrintf("Error: RX Callback received error status\r\n");
+        CMN_systemLogText("Error: RX Callback received error status\r\n");
         return;
     }
 
@@ -134,7 +134,7 @@ static void SERP_vidRxCallback(char const * const kpkau8Data,
                     }
                     else
                     {
-                        CMN_systemPrintf("Error: RX buffer overflow\r\n");
+                        CMN_systemLogText("Error: RX buffer overflow\r\n");
                         SERP_enuRxState = SERP_STATE_IDLE;
                     }
                 }
@@ -149,7 +149,7 @@ static void SERP_vidRxCallback(char const * const kpkau8Data,
                 }
                 else
                 {
-                    CMN_systemPrintf("Error: RX buffer overflow\r\n");
+                    CMN_systemLogText("Error: RX buffer overflow\r\n");
                     SERP_enuRxState = SERP_STATE_IDLE;
                 }
                 break;
@@ -166,7 +166,7 @@ static void SERP_treatReceivedMessage(void)
 {
     if (SERP_u16RxIndex < 3) // MSG_ID + MSG_LENGTH (2 octets minimum)
     {
-        CMN_systemPrintf("Error: Message too short\r\n");
+        CMN_systemLogText("Error: Message too short\r\n");
         return;
     }
 
@@ -175,12 +175,15 @@ static void SERP_treatReceivedMessage(void)
 
     if (SERP_u16MsgLength != (SERP_u16RxIndex - 3))
     {
-        CMN_systemPrintf("Error: Length mismatch\r\n");
+        CMN_systemLogText("Error: Length mismatch\r\n");
         return;
     }
 
-    CMN_systemPrintf("Message received: ID=%d, Length=%d\r\n",
-                     SERP_enuCurrentMsgId, SERP_u16MsgLength);
+    CMN_systemLogText("Message received: ID=");
+    CMN_systemLogInteger(SERP_enuCurrentMsgId);
+    CMN_systemLogText(", Length=");
+    CMN_systemLogInteger(SERP_u16MsgLength);
+    CMN_systemLogText("\r\n");
 
     // Si un callback est enregistré, envoyer les données
     if (SERP_pfAppManagerCallback != NULL)
@@ -208,7 +211,7 @@ void SERP_vidInitialize(void)
     EUSART_tenuStatus eusartStatus = EUSART_enuRegisterRxCbk(SERP_vidRxCallback);
     if (eusartStatus != EUSART_eSTATUS_OK)
     {
-        CMN_systemPrintf("Error: Failed to register EUSART RX callback\r\n");
+        CMN_systemLogText("Error: Failed to register EUSART RX callback\r\n");
         return;
     }
 
@@ -51,7 +51,25 @@ typedef enum SERP_tenuMsgId
     SERP_MSG_ID_STOP_MEASURE = 18,
     SERP_MSG_ID_TEMPERATURE = 18,
     SERP_MSG_ID_LIVE_SIGN = 19,
-    SERP_MSG_ID_CUSTOM = 20
+    SERP_MSG_ID_CUSTOM = 20,
+    SERP_MSG_ID_I2C_TRACE_REQUEST = 21, // Demande d'export de la trace I2C (sans donnees)
+    SERP_MSG_ID_I2C_TRACE = 22,         // [nombre de records][records de I2CM_TRACE_RECORD_SIZE octets]
+    SERP_MSG_ID_I2C_BUS_USAGE = 23,     // Records de I2CM_BUS_USAGE_RECORD_SIZE octets par adresse esclave
+    SERP_MSG_ID_FILTER_SETTINGS = 24,   // Record de FLT_SETTINGS_RECORD_SIZE octets (vide = lecture), réponse avec les réglages courants
+    SERP_MSG_ID_HISTORY_STATS = 25,     // [longueur de fenetre] (vide = lecture), réponse avec un record de HIS_STATISTICS_RECORD_SIZE octets
+    SERP_MSG_ID_HISTORY_QUERY = 26,     // [niveau][age du premier bucket], réponse [niveau][age][nombre][records de AGG_RECORD_SIZE octets]
+    SERP_MSG_ID_TELEMETRY_SAMPLE = 27,  // [numéro de séquence sur 4 octets][mesure sur 2 octets], envoyé quand le lien est établi
+    SERP_MSG_ID_TELEMETRY_BACKFILL = 28, // [numéro de séquence du premier échantillon][nombre][mesures sur 2 octets], rattrapage après une perte du lien
+    SERP_MSG_ID_TELEMETRY_LINK = 29,    // [premier numéro de séquence non reçu sur 4 octets] (vide = signe de vie), réponse avec un record de TLM_STATUS_RECORD_SIZE octets
+    SERP_MSG_ID_LOG_READ = 30,          // Requête de DWL_REQUEST_SIZE octets (lecture du journal), réponse avec un record de DWL_RANGE_RECORD_SIZE octets
+    SERP_MSG_ID_LOG_DATA = 31,          // Chunk du journal : [index du premier échantillon][numéro de chunk][nombre][échantillons] (voir Download.h)
+    SERP_MSG_ID_LOG_ACK = 32,           // [numéro du prochain chunk attendu par l'IHM]
+    SERP_MSG_ID_SENSOR_SAMPLE = 33,     // [identifiant du capteur (MCP9700_tenuSensorId)][mesure brute sur 2 octets]
+    SERP_MSG_ID_ALARM = 34,             // Record de ALM_STATUS_RECORD_SIZE octets envoyé à chaque changement des alarmes (vide = lecture)
+    SERP_MSG_ID_ALARM_SETTINGS = 35,    // Record de ALM_SETTINGS_RECORD_SIZE octets (vide = lecture), réponse avec les réglages courants
+    SERP_MSG_ID_SAMPLING_SETTINGS = 36, // Record de SMP_SETTINGS_RECORD_SIZE octets (vide = lecture), réponse avec les réglages courants
+    SERP_MSG_ID_REPORT_SETTINGS = 37,   // Record de RPT_SETTINGS_RECORD_SIZE octets (vide = lecture), réponse avec les réglages courants
+    SERP_MSG_ID_REPORT_STATUS = 38      // Lecture des compteurs, réponse avec un record de RPT_STATUS_RECORD_SIZE octets
 } SERP_tenuMsgId;
 
 typedef enum SERP_tenuStatus
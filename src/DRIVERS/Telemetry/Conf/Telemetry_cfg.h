@@ -0,0 +1,58 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Telemetry_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Telemetry Driver conf part
+ * @details   Module in charge of the store-and-forward of the samples to the IHM
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef TELEMETRY_CFG_H_
+#define TELEMETRY_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the time in ms without message of the IHM after which the link is lost (the IHM shall send a sign of
+ *        life more often)
+ */
+#define TLM_CONFIG_LINK_TIMEOUT_MS                          3000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the backfill rate: at most one message of TLM_CONFIG_BACKFILL_SAMPLES samples (1 to 22, a message
+ *        shall fit in SERP_MAX_MSG_DATA_SIZE) every TLM_CONFIG_BACKFILL_PERIOD_MS ms
+ * @remark 20 samples every 100 ms drain the log about 50 times faster than the sampling, a message takes about 4 ms
+ *         at 115200 bauds: the live samples and the main loop are not starved
+ */
+#define TLM_CONFIG_BACKFILL_SAMPLES                         20
+#define TLM_CONFIG_BACKFILL_PERIOD_MS                       100
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* TELEMETRY_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
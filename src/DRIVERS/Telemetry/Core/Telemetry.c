@@ -0,0 +1,407 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Telemetry.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Telemetry Driver core part
+ * @details   Module in charge of the store-and-forward of the samples to the IHM (link state, live and backfill)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "TIMER.h"
+#include "SERP.h"
+#include "NVLog.h"
+#include "Telemetry.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of the messages: live sample [0..3] sequence number, [4..5] value and backfill [0..3] sequence number of
+ *        the first sample, [4] number of samples, [5..] values (all the fields are little endian)
+ */
+#define TLM_SAMPLE_MESSAGE_SIZE                             6
+#define TLM_BACKFILL_HEADER_SIZE                            5
+
+#if((TLM_CONFIG_BACKFILL_SAMPLES < 1) || \
+    ((TLM_BACKFILL_HEADER_SIZE + (2 * TLM_CONFIG_BACKFILL_SAMPLES)) > SERP_MAX_MSG_DATA_SIZE))
+#  error "[TLM ] Error: The setting TLM_CONFIG_BACKFILL_SAMPLES must be at least 1 and fit in a SERP message"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Durations in us (see TIM1_u32GetTimestampUs), the drain rate is measured over a second
+ */
+#define TLM_LINK_TIMEOUT_US                                 ((uint32_t)TLM_CONFIG_LINK_TIMEOUT_MS * 1000UL)
+#define TLM_BACKFILL_PERIOD_US                              ((uint32_t)TLM_CONFIG_BACKFILL_PERIOD_MS * 1000UL)
+#define TLM_RATE_WINDOW_US                                  1000000UL
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief State of the link and time of the latest message of the IHM
+ */
+static bool     TLM_bIsLinkUp                               = false;
+static uint32_t TLM_u32LastHostMessageUs                    = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief First sample needed by the IHM (acknowledged, or the oldest one of the log if older ones are overwritten)
+ *        and range of the running backfill: from the next sample to send to the first live sample (excluded)
+ */
+static uint32_t TLM_u32AckedIndex                           = 0;
+static uint32_t TLM_u32BackfillIndex                        = 0;
+static uint32_t TLM_u32BackfillEnd                          = 0;
+static uint32_t TLM_u32LastBackfillUs                       = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Measure of the drain rate: start of the running window, samples sent in it and rate of the latest window
+ */
+static uint32_t TLM_u32RateWindowStartUs                    = 0;
+static uint16_t TLM_u16RateWindowCount                      = 0;
+static uint16_t TLM_u16DrainRate                            = 0;
+static uint16_t TLM_u16OverwrittenCount                     = 0;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to set the link up, a backfill from the acknowledged sample to the next one starts
+ */
+static void vidSetLinkUp(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to skip the samples overwritten in the log before their backfill (they are counted)
+ */
+static void vidSkipOverwrittenSamples(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send the next samples of the backfill in a message
+ * @details A sequence number skipped by the log at a mount is jumped over without message
+ */
+static void vidSendBackfill(const uint32_t ku32NowUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to close the window of the drain rate when it is elapsed
+ */
+static void vidUpdateDrainRate(const uint32_t ku32NowUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the number of samples of the backlog (see @ref TLM_STATUS_RECORD_SIZE)
+ */
+static uint32_t u32GetBacklog(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Functions used to write a value in a buffer, little endian
+ */
+static void vidWriteU16(uint8_t * const kpu8Buffer, const uint16_t ku16Value);
+static void vidWriteU32(uint8_t * const kpu8Buffer, const uint32_t ku32Value);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static void vidSetLinkUp(void)
+{
+  if(TLM_bIsLinkUp == false)
+  {
+    TLM_bIsLinkUp         = true;
+    TLM_u32BackfillIndex  = TLM_u32AckedIndex;
+    TLM_u32BackfillEnd    = NVL_u32GetNextIndex();
+    TLM_u32LastBackfillUs = TIM1_u32GetTimestampUs() - TLM_BACKFILL_PERIOD_US;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidSkipOverwrittenSamples(void)
+{
+  const uint32_t ku32OldestIndex = NVL_u32GetOldestIndex();
+
+  if(TLM_u32AckedIndex < ku32OldestIndex)
+  {
+    if((ku32OldestIndex - TLM_u32AckedIndex) < (uint32_t)(UINT16_MAX - TLM_u16OverwrittenCount))
+    {
+      TLM_u16OverwrittenCount += (uint16_t)(ku32OldestIndex - TLM_u32AckedIndex);
+    }
+    else
+    {
+      TLM_u16OverwrittenCount = UINT16_MAX;
+    }
+
+    TLM_u32AckedIndex = ku32OldestIndex;
+  }
+
+  if(TLM_u32BackfillIndex < TLM_u32AckedIndex)
+  {
+    TLM_u32BackfillIndex = TLM_u32AckedIndex;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidSendBackfill(const uint32_t ku32NowUs)
+{
+  uint8_t        au8Message[TLM_BACKFILL_HEADER_SIZE + (2 * TLM_CONFIG_BACKFILL_SAMPLES)];
+  int16_t        as16Samples[TLM_CONFIG_BACKFILL_SAMPLES];
+  uint8_t        u8Count   = 0;
+  uint8_t        u8Sample  = 0;
+  uint8_t        u8Max     = TLM_CONFIG_BACKFILL_SAMPLES;
+  NVL_tenuStatus enuStatus = NVL_eSTATUS_OK;
+
+  if((TLM_u32BackfillEnd - TLM_u32BackfillIndex) < TLM_CONFIG_BACKFILL_SAMPLES)
+  {
+    u8Max = (uint8_t)(TLM_u32BackfillEnd - TLM_u32BackfillIndex);
+  }
+
+  enuStatus = NVL_enuReadSamples(TLM_u32BackfillIndex, as16Samples, u8Max, &u8Count);
+
+  if(enuStatus == NVL_eSTATUS_OK)
+  {
+    vidWriteU32(au8Message, TLM_u32BackfillIndex);
+    au8Message[4] = u8Count;
+
+    for(u8Sample = 0; u8Sample < u8Count; u8Sample++)
+    {
+      vidWriteU16(&au8Message[TLM_BACKFILL_HEADER_SIZE + (2 * u8Sample)], (uint16_t)as16Samples[u8Sample]);
+    }
+
+    if(SERP_enuSendMessage(SERP_MSG_ID_TELEMETRY_BACKFILL,
+                           au8Message,
+                           TLM_BACKFILL_HEADER_SIZE + (2 * (uint16_t)u8Count)) == SERP_STATUS_OK)
+    {
+      TLM_u32BackfillIndex   += u8Count;
+      TLM_u16RateWindowCount += u8Count;
+      TLM_u32LastBackfillUs   = ku32NowUs;
+    }
+    else
+    {
+      TLM_bIsLinkUp = false;
+    }
+  }
+  else if(enuStatus == NVL_eSTATUS_NO_SAMPLE)
+  {
+    // Sequence number skipped at a mount (the overwritten samples are skipped before): nothing to send, the IHM will
+    // never receive it and takes the acknowledged index of the status
+    if(TLM_u32AckedIndex == TLM_u32BackfillIndex)
+    {
+      TLM_u32AckedIndex++;
+    }
+
+    TLM_u32BackfillIndex++;
+  }
+  else
+  {
+    // The EEPROM is being written: retry at the next call
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidUpdateDrainRate(const uint32_t ku32NowUs)
+{
+  const uint32_t ku32ElapsedUs = ku32NowUs - TLM_u32RateWindowStartUs;
+
+  if(ku32ElapsedUs >= TLM_RATE_WINDOW_US)
+  {
+    TLM_u16DrainRate         = (uint16_t)(((uint32_t)TLM_u16RateWindowCount * 1000UL) / (ku32ElapsedUs / 1000UL));
+    TLM_u16RateWindowCount   = 0;
+    TLM_u32RateWindowStartUs = ku32NowUs;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint32_t u32GetBacklog(void)
+{
+  const uint32_t ku32OldestIndex = NVL_u32GetOldestIndex();
+  uint32_t       u32First        = TLM_u32AckedIndex;
+  uint32_t       u32End          = NVL_u32GetNextIndex();
+  uint32_t       u32Backlog      = 0;
+
+  if(TLM_bIsLinkUp == true)
+  {
+    u32First = TLM_u32BackfillIndex;
+    u32End   = TLM_u32BackfillEnd;
+  }
+
+  if(u32First < ku32OldestIndex)
+  {
+    u32First = ku32OldestIndex;
+  }
+
+  if(u32End > u32First)
+  {
+    u32Backlog = u32End - u32First;
+  }
+
+  return u32Backlog;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidWriteU16(uint8_t * const kpu8Buffer, const uint16_t ku16Value)
+{
+  kpu8Buffer[0] = (uint8_t)ku16Value;
+  kpu8Buffer[1] = (uint8_t)(ku16Value >> 8);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidWriteU32(uint8_t * const kpu8Buffer, const uint32_t ku32Value)
+{
+  kpu8Buffer[0] = (uint8_t)ku32Value;
+  kpu8Buffer[1] = (uint8_t)(ku32Value >> 8);
+  kpu8Buffer[2] = (uint8_t)(ku32Value >> 16);
+  kpu8Buffer[3] = (uint8_t)(ku32Value >> 24);
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void TLM_vidInitialize(void)
+{
+  const uint32_t ku32NowUs = TIM1_u32GetTimestampUs();
+
+  TLM_bIsLinkUp            = false;
+  TLM_u32LastHostMessageUs = ku32NowUs;
+  TLM_u32AckedIndex        = NVL_u32GetOldestIndex();
+  TLM_u32BackfillIndex     = TLM_u32AckedIndex;
+  TLM_u32BackfillEnd       = TLM_u32AckedIndex;
+  TLM_u32LastBackfillUs    = ku32NowUs;
+  TLM_u32RateWindowStartUs = ku32NowUs;
+  TLM_u16RateWindowCount   = 0;
+  TLM_u16DrainRate         = 0;
+  TLM_u16OverwrittenCount  = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TLM_vidPushSample(const int16_t ks16Value)
+{
+  const uint32_t ku32Index = NVL_u32GetNextIndex();
+  uint8_t        au8Message[TLM_SAMPLE_MESSAGE_SIZE];
+
+  NVL_vidPushSample(ks16Value);
+
+  // A sample dropped by the log has no sequence number: it is not sent
+  if((TLM_bIsLinkUp == true) && (NVL_u32GetNextIndex() != ku32Index))
+  {
+    vidWriteU32(au8Message, ku32Index);
+    vidWriteU16(&au8Message[4], (uint16_t)ks16Value);
+
+    if(SERP_enuSendMessage(SERP_MSG_ID_TELEMETRY_SAMPLE, au8Message, TLM_SAMPLE_MESSAGE_SIZE) != SERP_STATUS_OK)
+    {
+      TLM_bIsLinkUp = false;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TLM_vidNotifyHostMessage(void)
+{
+  TLM_u32LastHostMessageUs = TIM1_u32GetTimestampUs();
+  vidSetLinkUp();
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TLM_vidAcknowledge(const uint32_t ku32NextIndex)
+{
+  if((ku32NextIndex > TLM_u32AckedIndex) && (ku32NextIndex <= NVL_u32GetNextIndex()))
+  {
+    TLM_u32AckedIndex = ku32NextIndex;
+  }
+
+  TLM_vidNotifyHostMessage();
+
+  // The samples already received are not sent again by the running backfill:
+  if(TLM_u32BackfillIndex < TLM_u32AckedIndex)
+  {
+    TLM_u32BackfillIndex = TLM_u32AckedIndex;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TLM_vidProcess(void)
+{
+  const uint32_t ku32NowUs = TIM1_u32GetTimestampUs();
+
+  if((TLM_bIsLinkUp == true) && ((ku32NowUs - TLM_u32LastHostMessageUs) >= TLM_LINK_TIMEOUT_US))
+  {
+    TLM_bIsLinkUp = false;
+  }
+
+  vidSkipOverwrittenSamples();
+  vidUpdateDrainRate(ku32NowUs);
+
+  if((TLM_bIsLinkUp == true) &&
+     (TLM_u32BackfillIndex < TLM_u32BackfillEnd) &&
+     ((ku32NowUs - TLM_u32LastBackfillUs) >= TLM_BACKFILL_PERIOD_US))
+  {
+    vidSendBackfill(ku32NowUs);
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t TLM_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= TLM_STATUS_RECORD_SIZE))
+  {
+    kpu8Buffer[0] = (TLM_bIsLinkUp == true) ? 1 : 0;
+    vidWriteU32(&kpu8Buffer[1], NVL_u32GetNextIndex());
+    vidWriteU32(&kpu8Buffer[5], TLM_u32AckedIndex);
+    vidWriteU32(&kpu8Buffer[9], u32GetBacklog());
+    vidWriteU16(&kpu8Buffer[13], TLM_u16DrainRate);
+    vidWriteU16(&kpu8Buffer[15], TLM_u16OverwrittenCount);
+    vidWriteU16(&kpu8Buffer[17], NVL_u16GetDroppedCount());
+
+    u8Size = TLM_STATUS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Telemetry.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Telemetry Driver core part
+ * @details   Module in charge of the store-and-forward of the samples to the IHM. Every sample is appended to the
+ *            persistent log (see NVLog.h), its index in the log is its sequence number:
+ *              - Link: the link is up while the IHM sends messages (sign of life), it is lost after
+ *                TLM_CONFIG_LINK_TIMEOUT_MS ms of silence or when a message cannot be sent
+ *              - Live: while the link is up, each sample is sent at once with its sequence number
+ *              - Backfill: when the link comes back, the samples from the index acknowledged by the IHM to the first
+ *                live sample are read from the log and sent in bulk, at a limited rate
+ *            The IHM acknowledges the first sequence number it has not received yet, from the acknowledged index of
+ *            the latest status (the numbers skipped by the log or overwritten before their backfill are never sent,
+ *            the module moves this index over them), and drops the sequence numbers received twice. A live sample
+ *            lost while the link is up is sent again at the next reconnection
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Telemetry_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of the status record exported by @ref TLM_u8ExportStatus (all fields are little endian):
+ *          - [0]       Link state (1 = up)
+ *          - [1..4]    Sequence number of the next sample
+ *          - [5..8]    Sequence number acknowledged by the IHM, moved over the samples which will never be sent
+ *          - [9..12]   Backlog: samples to backfill (link up) or not acknowledged (link lost), still in the log
+ *          - [13..14]  Drain rate of the backfill over the last second, in samples per second
+ *          - [15..16]  Samples overwritten in the log before their backfill (saturated)
+ *          - [17..18]  Samples dropped by the log, RAM buffer full (saturated)
+ */
+#define TLM_STATUS_RECORD_SIZE                              19
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the module (link lost, nothing acknowledged)
+ * @remark The log shall be mounted before (see NVL_vidInitialize)
+ */
+void TLM_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to log a sample and to send it if the link is up
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe), it replaces
+ *         the subscription of NVL_vidPushSample
+ * @param[in] ks16Value: The value of the sample
+ */
+void TLM_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to notify a message of the IHM (sign of life), the link is up again
+ */
+void TLM_vidNotifyHostMessage(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to take into account an acknowledgement of the IHM, which is also a sign of life
+ * @param[in] ku32NextIndex: The sequence number of the first sample not received by the IHM (the backfill restarts
+ *                           from it at the next reconnection, an older value than a previous one is ignored)
+ */
+void TLM_vidAcknowledge(const uint32_t ku32NextIndex);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to check the link and to send the backfill (main loop)
+ * @remark The log is read from the EEPROM: the function is best called just before NVL_vidProcess
+ */
+void TLM_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the status of the link and of the backfill
+ * @details See @ref TLM_STATUS_RECORD_SIZE for the format of the record
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t TLM_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // TELEMETRY_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,107 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      ADC_cfg.c
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     ADC Hardware conf part
+ * @details   Module in charge of the management of the ADC peripheral
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "ADC_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+// Internal channels of the ADPCH multiplexer (see "PIC18F47Q10 - Datasheet", ADPCH register):
+#define ADC_CHANNEL_FVR_BUFFER_1                            0b00111111
+#define ADC_CHANNEL_TEMPERATURE_INDICATOR                   0b00111101
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief The static database of each scanned channel configuration
+ */
+static const ADC_tstrChannelConfig ADC_kastrChannelConfigList[ADC_eCHANNEL_ID_END] =
+{
+  [ADC_eCHANNEL_ID_SENSOR]                                  =
+  {
+    .u8Channel                                              = ADC_CONFIG_SENSOR_CHANNEL_ADPCH,
+    .u16RegAddressTris                                      = ADC_CONFIG_SENSOR_REG_ADDRESS_TRIS,
+    .u16RegAddressAnsel                                     = ADC_CONFIG_SENSOR_REG_ADDRESS_ANSEL,
+    .u8Pin                                                  = ADC_CONFIG_SENSOR_PIN,
+    .bSupplyCompensation                                    = true,
+  },
+  [ADC_eCHANNEL_ID_POTENTIOMETER]                           =
+  {
+    .u8Channel                                              = ADC_CONFIG_POTENTIOMETER_CHANNEL_ADPCH,
+    .u16RegAddressTris                                      = ADC_CONFIG_POTENTIOMETER_REG_ADDRESS_TRIS,
+    .u16RegAddressAnsel                                     = ADC_CONFIG_POTENTIOMETER_REG_ADDRESS_ANSEL,
+    .u8Pin                                                  = ADC_CONFIG_POTENTIOMETER_PIN,
+    .bSupplyCompensation                                    = false, // Divider of the supply: already ratiometric
+  },
+  [ADC_eCHANNEL_ID_FVR]                                     =
+  {
+    .u8Channel                                              = ADC_CHANNEL_FVR_BUFFER_1,
+    .u16RegAddressTris                                      = 0,
+    .u16RegAddressAnsel                                     = 0,
+    .u8Pin                                                  = 0,
+    .bSupplyCompensation                                    = false,
+  },
+  [ADC_eCHANNEL_ID_DIE_TEMPERATURE]                         =
+  {
+    .u8Channel                                              = ADC_CHANNEL_TEMPERATURE_INDICATOR,
+    .u16RegAddressTris                                      = 0,
+    .u16RegAddressAnsel                                     = 0,
+    .u8Pin                                                  = 0,
+    .bSupplyCompensation                                    = true,
+  },
+};
+
+
+/**********************************************************************************************************************/
+/* GETTERS DEFINITIONS                                                                                                */
+/**********************************************************************************************************************/
+ADC_tstrChannelConfig const * const ADC_kpkstrGetChannelConfig(const ADC_tenuChannelId kenuChannelId)
+{
+  ADC_tstrChannelConfig const *pkstrThisConfig = NULL;
+
+  if((ADC_eCHANNEL_ID_BEGIN < kenuChannelId) && (kenuChannelId < ADC_eCHANNEL_ID_END))
+  {
+    pkstrThisConfig = &ADC_kastrChannelConfigList[kenuChannelId];
+  }
+
+  return pkstrThisConfig;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
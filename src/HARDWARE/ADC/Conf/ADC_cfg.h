@@ -34,63 +34,176 @@
 /* CONSTANTS, MACROS                                                                                                  */
 /**********************************************************************************************************************/
 /**
- * @brief Defines whether the ADC is connected to the potentiometer (RA0 pin) or in the RB3 pin
+ * @brief Settings of the scanned channels connected to a pin (see @ref ADC_tstrChannelConfig)
+ * @remark The TRIS* register is at "0x0F87" for the PORTA and at "0x0F88" for the PORTB, the ANSEL* register is at
+ *         "0x0F0C" for the PORTA and at "0x0F14" for the PORTB
  */
-#define ADC_CONFIG_USE_POTENTIOMETER                        true //false to use PCP9700
+// MCP9700 on the RB3 pin (ANB3):
+#define ADC_CONFIG_SENSOR_CHANNEL_ADPCH                     0b00001011
+#define ADC_CONFIG_SENSOR_REG_ADDRESS_TRIS                  0x0F88
+#define ADC_CONFIG_SENSOR_REG_ADDRESS_ANSEL                 0x0F14
+#define ADC_CONFIG_SENSOR_PIN                               _TRISB_TRISB3_POSITION
+
+// Potentiometer of the Curiosity board on the RA0 pin (ANA0):
+#define ADC_CONFIG_POTENTIOMETER_CHANNEL_ADPCH              0b00000000
+#define ADC_CONFIG_POTENTIOMETER_REG_ADDRESS_TRIS           0x0F87
+#define ADC_CONFIG_POTENTIOMETER_REG_ADDRESS_ANSEL          0x0F0C
+#define ADC_CONFIG_POTENTIOMETER_PIN                        _TRISA_TRISA0_POSITION
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Defines the register address of the TRIS* pin used by the ADC
- * @remark The value "0x0F87" is for the potentiometer (RA0 pin) in the Curiosity board
- * @remark The value "0x0F88" is for the potentiometer (RB3 pin) in the Curiosity board
+ * @brief Defines whether the main channel is the potentiometer or the MCP9700
+ * @details The main channel is the one read by @ref ADC_enuGetRawValue, the continuous mode and the change-detect mode,
+ *          the other channels of the scan table are only converted by @ref ADC_enuStartScan
  */
-#if(ADC_CONFIG_USE_POTENTIOMETER == true)
-#  define ADC_CONFIG_REG_ADDRESS_TRIS                       0x0F87
-#elif(ADC_CONFIG_USE_POTENTIOMETER == false)
-#  define ADC_CONFIG_REG_ADDRESS_TRIS                       0x0F88
-#endif //ADC_CONFIG_USE_POTENTIOMETER
+#define ADC_CONFIG_USE_POTENTIOMETER                        true //false to use MCP9700
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Defines the register address of the ANSEL* pin used by the ADC
- * @remark The value "0x0F0C" is for the potentiometer (RA0 pin) in the Curiosity board
- * @remark The value "0x0F14" is for the potentiometer (RB3 pin) in the Curiosity board
+ * @brief Defines the output voltage of the Fixed Voltage Reference (1024, 2048 or 4096 mV) converted by the channel
+ *        @ref ADC_eCHANNEL_ID_FVR to measure the real supply voltage (the ADC reference)
+ * @remark The FVR shall be lower than the supply voltage
  */
-#if(ADC_CONFIG_USE_POTENTIOMETER == true)
-#  define ADC_CONFIG_REG_ADDRESS_ANSEL                      0x0F0C
-#elif(ADC_CONFIG_USE_POTENTIOMETER == false)
-#  define ADC_CONFIG_REG_ADDRESS_ANSEL                      0x0F14
-#endif //ADC_CONFIG_USE_POTENTIOMETER
+#define ADC_CONFIG_FVR_VOLTAGE_MV                           2048
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Defines the ADPCH channel used to connect the ADC to one of the available pin
- * @remark The value "0b00000000" is for the potentiometer (RA0 pin) in the Curiosity board
- * @remark The value "0b00001011" is for the potentiometer (RB3 pin) in the Curiosity board
+ * @brief Defines the nominal supply voltage: the values of the channels with a supply compensation are scaled as if
+ *        they were converted with this reference
  */
-#if(ADC_CONFIG_USE_POTENTIOMETER == true)
-#  define ADC_CONFIG_CHANNEL_ADPCH                          0b00000000
-#elif(ADC_CONFIG_USE_POTENTIOMETER == false)
-#  define ADC_CONFIG_CHANNEL_ADPCH                          0b00001011
-#endif //ADC_CONFIG_USE_POTENTIOMETER
+#define ADC_CONFIG_NOMINAL_VDD_MV                           3300
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines whether each reading is oversampled by the ADCC hardware (Burst Average mode) or if it is a single
+ *        conversion
+ * @details The ADCC performs 2^N back-to-back conversions in its accumulator (see
+ *          @ref ADC_CONFIG_OVERSAMPLING_RATIO_LOG2) then shifts the sum into the filter register, without any CPU
+ *          cycle: each group of 4 conversions brings 1 effective bit (see @ref ADC_RESOLUTION_BITS)
+ */
+#define ADC_CONFIG_ENABLE_OVERSAMPLING                      true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number N of the 2^N conversions accumulated for each reading (from 1 to 7)
+ * @remark The value 6 gives 64 conversions (about 1.5 ms with the FRC clock) and a 13 Bits result
+ */
+#define ADC_CONFIG_OVERSAMPLING_RATIO_LOG2                  6
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 /**
- * @brief Defines the position of the TRIS* register (a.k.a the ID of the pin)
- * @remark The value "_TRISA_TRISA0_POSITION" is for the potentiometer (RA0 pin) in the Curiosity board
- * @remark The value "_TRISB_TRISB3_POSITION" is for the potentiometer (RB3 pin) in the Curiosity board
+ * @brief Defines whether the conversions are started by the hardware trigger TIM2 (continuous mode) or by each call
+ *        of @ref ADC_enuGetRawValue (single-shot mode)
+ * @details In continuous mode, the ADTIF interruption stores each result in a sample buffer (see
+ *          @ref ADC_CONFIG_SAMPLE_BUFFER_SIZE) and the reading functions return the stored values without waiting
+ */
+#define ADC_CONFIG_ENABLE_CONTINUOUS_MODE                   true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the period of the conversions in continuous mode (in us, rounded to TIM2_TRIGGER_RESOLUTION_US)
+ */
+#define ADC_CONFIG_TRIGGER_PERIOD_US                        10000UL
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of samples kept to compute the average value in continuous mode (power of two)
+ */
+#define ADC_CONFIG_SAMPLE_BUFFER_SIZE                       8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines whether the continuous mode only reports the significant changes of the value (change-detect mode)
+ * @details The hardware threshold comparator of the ADCC computes the error between the result and a setpoint set to
+ *          the last reported value: the ADTIF interruption (thus the sample buffer and the callback registered with
+ *          @ref ADC_bRegisterChangeCbk) is only raised when the error leaves the window +/- delta (see
+ *          @ref ADC_CONFIG_CHANGE_DETECT_DELTA), then the window is re-centred around the new value
+ * @remark This mode needs the continuous mode (see @ref ADC_CONFIG_ENABLE_CONTINUOUS_MODE)
+ */
+#define ADC_CONFIG_ENABLE_CHANGE_DETECT                     true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default half-width of the change-detect window, in steps of ADC_RESOLUTION_BITS bits
+ * @remark The value 12 is about 0.5 degC with the MCP9700 (10 mV/degC) and a 13 Bits result, the window can be changed
+ *         at runtime with @ref ADC_bSetChangeDelta
+ */
+#define ADC_CONFIG_CHANGE_DETECT_DELTA                      12
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enumeration used to declare the channels converted back to back by a scan pass, in the order of the pass
+ */
+typedef enum ADC_tenuChannelId
+{
+  /*-----[DO NOT EDIT/USE THIS]-----*/
+  ADC_eCHANNEL_ID_BEGIN = -1, /*    */
+  /*--------------------------------*/
+  ADC_eCHANNEL_ID_SENSOR,
+  ADC_eCHANNEL_ID_POTENTIOMETER,
+  ADC_eCHANNEL_ID_FVR,
+  ADC_eCHANNEL_ID_DIE_TEMPERATURE,
+  /*-------[DO NOT EDIT THIS]-------*/
+  ADC_eCHANNEL_ID_END /*------------*/
+  /*--------------------------------*/
+}ADC_tenuChannelId;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the channel read by @ref ADC_enuGetRawValue, the continuous mode and the change-detect mode
  */
 #if(ADC_CONFIG_USE_POTENTIOMETER == true)
-#  define ADC_CONFIG_CHANNEL_PORT                           _TRISA_TRISA0_POSITION
+#  define ADC_CONFIG_MAIN_CHANNEL_ID                        ADC_eCHANNEL_ID_POTENTIOMETER
 #elif(ADC_CONFIG_USE_POTENTIOMETER == false)
-#  define ADC_CONFIG_CHANNEL_PORT                           _TRISB_TRISB3_POSITION
+#  define ADC_CONFIG_MAIN_CHANNEL_ID                        ADC_eCHANNEL_ID_SENSOR
 #endif //ADC_CONFIG_USE_POTENTIOMETER
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the channel of the scan table which converts the Fixed Voltage Reference
+ */
+#define ADC_CONFIG_FVR_CHANNEL_ID                           ADC_eCHANNEL_ID_FVR
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Type used to set the static configuration of a scanned channel
+ */
+typedef struct ADC_tstrChannelConfig
+{
+  uint8_t                                                   u8Channel;            //!< The ADPCH value of the channel
+  uint16_t                                                  u16RegAddressTris;    //!< The TRIS* register of the pin, 0 for an internal channel
+  uint16_t                                                  u16RegAddressAnsel;   //!< The ANSEL* register of the pin, 0 for an internal channel
+  uint8_t                                                   u8Pin;                //!< The position of the pin in its port
+  bool                                                      bSupplyCompensation;  //!< If the value is scaled to @ref ADC_CONFIG_NOMINAL_VDD_MV (absolute voltage source)
+}ADC_tstrChannelConfig;
+
+
+/**********************************************************************************************************************/
+/* GETTERS PROTOTYPES                                                                                                 */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to get the static configuration of a scanned channel
+ * @return Return the configuration of the channel, NULL if the ID is not valid
+ */
+ADC_tstrChannelConfig const * const ADC_kpkstrGetChannelConfig(const ADC_tenuChannelId kenuChannelId);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 #endif /* ADC_CFG_H_ */
 /*--------------------------------------------------------------------------------------------------------------------*/
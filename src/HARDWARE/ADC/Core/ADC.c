@@ -43,6 +43,157 @@
 #define ADC_CHANNEL_AVSS                                    0b00111100
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+// ADMD field values of the ADCON2 register:
+#define ADC_MODE_BASIC                                      0b000
+#define ADC_MODE_BURST_AVERAGE                              0b011
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the right shift (ADCRS) applied to the accumulator: the 2^N sum is divided by 2^N, except for the
+ *        effective bits gained by the oversampling which are kept
+ */
+#define ADC_ACCUMULATOR_SHIFT                               (ADC_CONFIG_OVERSAMPLING_RATIO_LOG2 - ADC_OVERSAMPLING_GAIN_BITS)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_OVERSAMPLING == true)
+#  if((ADC_CONFIG_OVERSAMPLING_RATIO_LOG2 < 1) || (ADC_CONFIG_OVERSAMPLING_RATIO_LOG2 > 7))
+#    error "[ADC ] Error: The setting ADC_CONFIG_OVERSAMPLING_RATIO_LOG2 must be between 1 and 7"
+#  endif
+#  define ADC_CONVERSION_COUNT                              (1 << ADC_CONFIG_OVERSAMPLING_RATIO_LOG2)
+#else
+#  define ADC_CONVERSION_COUNT                              1
+#endif //ADC_CONFIG_ENABLE_OVERSAMPLING
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macros used to read the result registers: the filter register (shifted accumulator) when the hardware
+ *        oversampling is enabled, the result register otherwise
+ */
+#if(ADC_CONFIG_ENABLE_OVERSAMPLING == true)
+#  define ADC_mREAD_RESULT()                                ((uint16_t)(((uint16_t)ADFLTRH << 8) | ADFLTRL))
+#  define ADC_mREAD_ACCUMULATOR()                           (((uint32_t)ADACCU << 16) | ((uint32_t)ADACCH << 8) | ADACCL)
+#else
+#  define ADC_mREAD_RESULT()                                ((uint16_t)(((uint16_t)ADRESH << 8) | ADRESL))
+#  define ADC_mREAD_ACCUMULATOR()                           ((uint32_t)ADC_mREAD_RESULT())
+#endif //ADC_CONFIG_ENABLE_OVERSAMPLING
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+#  if((ADC_CONFIG_SAMPLE_BUFFER_SIZE < 1) || (ADC_CONFIG_SAMPLE_BUFFER_SIZE > 128) || \
+      ((ADC_CONFIG_SAMPLE_BUFFER_SIZE & (ADC_CONFIG_SAMPLE_BUFFER_SIZE - 1)) != 0))
+#    error "[ADC ] Error: The setting ADC_CONFIG_SAMPLE_BUFFER_SIZE must be a power of two up to 128"
+#  endif
+#  if((ADC_CONFIG_TRIGGER_PERIOD_US < TIM2_TRIGGER_MIN_PERIOD_US) || (ADC_CONFIG_TRIGGER_PERIOD_US > TIM2_TRIGGER_MAX_PERIOD_US))
+#    error "[ADC ] Error: The setting ADC_CONFIG_TRIGGER_PERIOD_US is out of the range of the trigger TIM2"
+#  endif
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+#  if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == false)
+#    error "[ADC ] Error: The change-detect mode needs the continuous mode (ADC_CONFIG_ENABLE_CONTINUOUS_MODE)"
+#  endif
+#  if((ADC_CONFIG_CHANGE_DETECT_DELTA < 1) || (ADC_CONFIG_CHANGE_DETECT_DELTA > INT16_MAX))
+#    error "[ADC ] Error: The setting ADC_CONFIG_CHANGE_DETECT_DELTA must be between 1 and INT16_MAX"
+#  endif
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the auto-conversion trigger source (ADACT) used in continuous mode: the postscaled output of TIM2
+ * @remark The trigger is disabled during a scan pass
+ */
+#define ADC_TRIGGER_SOURCE_NONE                             0b00000
+#define ADC_TRIGGER_SOURCE_TMR2                             0b00100
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the threshold test (ADTMD) used in continuous mode: ADTIF is set at the end of each computation, that
+ *        is after the last conversion of the burst
+ */
+#define ADC_THRESHOLD_INTERRUPT_ALWAYS                      0b111
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the threshold test (ADTMD) used in change-detect mode: ADTIF is set when the error is lower than
+ *        ADLTH or greater than ADUTH
+ */
+#define ADC_THRESHOLD_INTERRUPT_OUTSIDE_WINDOW              0b011
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the error calculation (ADCALC) used in change-detect mode: the error is the result minus the setpoint
+ *        ADSTPT (the filter register when the hardware oversampling is enabled)
+ */
+#if(ADC_CONFIG_ENABLE_OVERSAMPLING == true)
+#  define ADC_ERROR_RESULT_MINUS_SETPOINT                   0b101
+#else
+#  define ADC_ERROR_RESULT_MINUS_SETPOINT                   0b001
+#endif //ADC_CONFIG_ENABLE_OVERSAMPLING
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define ADC_SAMPLE_INDEX_MASK                               (ADC_CONFIG_SAMPLE_BUFFER_SIZE - 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macros used to protect the values shared with the interruption, only needed in continuous mode
+ */
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+#  define ADC_mENTER_CRITICAL()                             (PIE1bits.ADTIE = 0)
+#  define ADC_mEXIT_CRITICAL()                              (PIE1bits.ADTIE = 1)
+#else
+#  define ADC_mENTER_CRITICAL()
+#  define ADC_mEXIT_CRITICAL()
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the ADFVR gain of the Fixed Voltage Reference (see "PIC18F47Q10 - Datasheet", FVRCON register)
+ */
+#if(ADC_CONFIG_FVR_VOLTAGE_MV == 1024)
+#  define ADC_FVR_GAIN                                      0b01
+#elif(ADC_CONFIG_FVR_VOLTAGE_MV == 2048)
+#  define ADC_FVR_GAIN                                      0b10
+#elif(ADC_CONFIG_FVR_VOLTAGE_MV == 4096)
+#  define ADC_FVR_GAIN                                      0b11
+#else
+#  error "[ADC ] Error: The setting ADC_CONFIG_FVR_VOLTAGE_MV must be 1024, 2048 or 4096"
+#endif //ADC_CONFIG_FVR_VOLTAGE_MV
+
+#if(ADC_CONFIG_FVR_VOLTAGE_MV >= ADC_CONFIG_NOMINAL_VDD_MV)
+#  error "[ADC ] Error: The setting ADC_CONFIG_FVR_VOLTAGE_MV must be lower than the supply voltage"
+#endif //ADC_CONFIG_FVR_VOLTAGE_MV
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the conversion of the FVR with the nominal supply: the ratio between this value and the converted one
+ *        is the ratio between the real supply and the nominal one
+ */
+#define ADC_FVR_NOMINAL_VALUE                               \
+  ((((uint32_t)ADC_CONFIG_FVR_VOLTAGE_MV * ADC_FULL_SCALE) + (ADC_CONFIG_NOMINAL_VDD_MV / 2)) / ADC_CONFIG_NOMINAL_VDD_MV)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the scan index when no scan pass is in progress
+ */
+#define ADC_SCAN_IDLE                                       ADC_eCHANNEL_ID_END
+
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -52,32 +203,284 @@
 /**********************************************************************************************************************/
 /* PRIVATE VARIABLES                                                                                                  */
 /**********************************************************************************************************************/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+/**
+ * @brief Sample buffer filled by the interruption in continuous mode (ring, the oldest sample is overwritten)
+ */
+static volatile uint16_t ADC_au16Samples[ADC_CONFIG_SAMPLE_BUFFER_SIZE] = { 0 };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Running sum of the samples of the buffer, used to give the average without parsing the buffer
+ */
+static volatile uint32_t ADC_u32SampleSum                   = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Accumulator of the latest burst of conversions
+ */
+static volatile uint32_t ADC_u32LatestAccumulator           = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Index of the next sample to be written and number of valid samples in the buffer
+ */
+static volatile uint8_t  ADC_u8SampleIndex                  = 0;
+static volatile uint8_t  ADC_u8SampleCount                  = 0;
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+/**
+ * @brief Callback used to inform the upper layer that the value left the change-detect window
+ */
+static ADC_tpfvidChangeCallback ADC_pfChangeCallback        = NULL;
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Results of the last scan pass (not compensated), one per channel of the scan table
+ */
+static volatile uint16_t ADC_au16ChannelValues[ADC_eCHANNEL_ID_END] = { 0 };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Channel converted by the scan pass in progress, @ref ADC_SCAN_IDLE otherwise
+ */
+static volatile ADC_tenuChannelId ADC_enuScanChannelId      = ADC_SCAN_IDLE;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Start time of the scan pass in progress and timing of the completed ones
+ */
+static volatile uint32_t ADC_u32ScanStartUs                 = 0;
+static volatile ADC_tstrScanStatistics ADC_strScanStatistics;
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+/**
+ * @brief Threshold test (ADTMD) of the main channel, restored at the end of a scan pass
+ */
+static volatile uint8_t  ADC_u8MainThresholdMode            = ADC_THRESHOLD_INTERRUPT_ALWAYS;
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
 
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
 /**********************************************************************************************************************/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+/**
+ * @brief Callback function registered to the interrupt module to store the result of each triggered computation in
+ *        the sample buffer
+ */
+static bool bInterruptHandler(void);
+#else
+static ADC_tenuStatus enuConvert(const uint8_t ku8Channel, const uint32_t ku32TimeoutMs);
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to close a scan pass: its duration is added to the statistics
+ * @remark Called by the interruption in continuous mode, by @ref ADC_enuStartScan in single-shot mode
+ */
+static void vidEndScanPass(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to scale a value to the nominal supply with the FVR value: value * nominal FVR / FVR
+ */
+static uint16_t u16CompensateSupply(const uint16_t ku16Value, const uint16_t ku16FvrValue);
 
 
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTION DEFINITIONS                                                                                       */
 /**********************************************************************************************************************/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+static bool bInterruptHandler(void)
+{
+  bool     bIsIsrFound = false;
+  uint16_t u16Sample   = 0;
+
+  if((PIE1bits.ADTIE == 1) && (PIR1bits.ADTIF == 1))
+  {
+    bIsIsrFound     = true;
+    PIR1bits.ADTIF  = 0;
+    u16Sample       = ADC_mREAD_RESULT();
+  }
+
+  if(bIsIsrFound == false)
+  {
+    // Not an ADC interruption
+  }
+  else if(ADC_enuScanChannelId != ADC_SCAN_IDLE)
+  {
+    // Scan pass: the result is stored and the next channel is started at once (back to back conversions):
+    ADC_au16ChannelValues[ADC_enuScanChannelId] = u16Sample;
+    ADC_enuScanChannelId++;
+
+    if(ADC_enuScanChannelId < ADC_eCHANNEL_ID_END)
+    {
+      ADPCH   = ADC_kpkstrGetChannelConfig(ADC_enuScanChannelId)->u8Channel;
+      ADCON0 |= _ADCON0_ADGO_MASK;
+    }
+    else
+    {
+      vidEndScanPass();
+
+      // The main channel and its trigger are restored:
+      ADPCH             = ADC_kpkstrGetChannelConfig(ADC_CONFIG_MAIN_CHANNEL_ID)->u8Channel;
+      ADCON3bits.ADTMD  = ADC_u8MainThresholdMode;
+      ADACT             = ADC_TRIGGER_SOURCE_TMR2;
+    }
+  }
+  else
+  {
+    ADC_u32LatestAccumulator = ADC_mREAD_ACCUMULATOR();
+
+    // The overwritten sample leaves the running sum (it is 0 while the buffer is not full):
+    ADC_u32SampleSum                    -= ADC_au16Samples[ADC_u8SampleIndex];
+    ADC_u32SampleSum                    += u16Sample;
+    ADC_au16Samples[ADC_u8SampleIndex]   = u16Sample;
+    ADC_u8SampleIndex                    = (uint8_t)((ADC_u8SampleIndex + 1) & ADC_SAMPLE_INDEX_MASK);
+
+    if(ADC_u8SampleCount < ADC_CONFIG_SAMPLE_BUFFER_SIZE)
+    {
+      ADC_u8SampleCount++;
+    }
+
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+    // The window is re-centred around the reported value, the next interruption comes with the next significant
+    // change (the first computation after the initialization is always reported):
+    ADSTPTH                 = (uint8_t)(u16Sample >> 8);
+    ADSTPTL                 = (uint8_t)u16Sample;
+    ADCON3bits.ADTMD        = ADC_THRESHOLD_INTERRUPT_OUTSIDE_WINDOW;
+    ADC_u8MainThresholdMode = ADC_THRESHOLD_INTERRUPT_OUTSIDE_WINDOW;
+
+    if(ADC_pfChangeCallback != NULL)
+    {
+      ADC_pfChangeCallback(u16Sample);
+    }
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+  }
+
+  return bIsIsrFound;
+}
+
+
+#else
+static ADC_tenuStatus enuConvert(const uint8_t ku8Channel, const uint32_t ku32TimeoutMs)
+{
+  ADC_tenuStatus enuStatus     = ADC_eSTATUS_OK;
+  uint32_t       u32TimeoutIdx = 0;
+
+  // Connect the ADC channel:
+  ADPCH = ku8Channel;
+
+  // Start conversion (in Burst Average mode, the accumulator and the counter are cleared by the trigger and the ADGO
+  // bit stays set until the last conversion):
+  ADCON0 |= _ADCON0_ADGO_MASK;
+
+  // Wait until either the ADC conversion is finished or the timeout:
+  while((ADCON0 & _ADCON0_ADGO_MASK) && (u32TimeoutIdx < ku32TimeoutMs))
+  {
+    __delay_ms(CMN_1_MS);
+
+    u32TimeoutIdx++;
+  }
+
+  if(u32TimeoutIdx >= ku32TimeoutMs)
+  {
+    enuStatus = ADC_eSTATUS_CONVERSION_TIMEOUT;
+  }
+
+  // After the conversion re-connect the ADC channel to the AVSS (Analog Ground):
+  ADPCH = ADC_CHANNEL_AVSS;
+
+  // Stop conversion:
+  ADCON0 &= ~(_ADCON0_ADGO_MASK);
+
+  return enuStatus;
+}
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidEndScanPass(void)
+{
+  uint32_t u32ScanTimeUs = TIM1_u32GetTimestampUs() - ADC_u32ScanStartUs;
+
+  ADC_strScanStatistics.u32PassCount++;
+  ADC_strScanStatistics.u32LastScanTimeUs = u32ScanTimeUs;
+
+  if(u32ScanTimeUs > ADC_strScanStatistics.u32MaxScanTimeUs)
+  {
+    ADC_strScanStatistics.u32MaxScanTimeUs = u32ScanTimeUs;
+  }
+
+  ADC_enuScanChannelId = ADC_SCAN_IDLE;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint16_t u16CompensateSupply(const uint16_t ku16Value, const uint16_t ku16FvrValue)
+{
+  uint32_t u32Value = ADC_FULL_SCALE - 1;
+
+  // A supply higher than the nominal one can give a value over the full scale, it is saturated:
+  if(ku16FvrValue != 0)
+  {
+    u32Value = ((((uint32_t)ku16Value * ADC_FVR_NOMINAL_VALUE) + (ku16FvrValue / 2)) / ku16FvrValue);
+  }
+
+  if(u32Value > (ADC_FULL_SCALE - 1))
+  {
+    u32Value = ADC_FULL_SCALE - 1;
+  }
+
+  return (uint16_t)u32Value;
+}
+
 
 /**********************************************************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                                                        */
 /**********************************************************************************************************************/
 void ADC_vidInitialize(void)
 {
-  CMN_assert(ADC_CONFIG_REG_ADDRESS_TRIS  != 0);
-  CMN_assert(ADC_CONFIG_REG_ADDRESS_ANSEL != 0);
-  CMN_assert(ADC_CONFIG_CHANNEL_PORT < CHAR_BIT);
+  ADC_tenuChannelId            enuChannelId    = ADC_eCHANNEL_ID_BEGIN;
+  ADC_tstrChannelConfig const *pkstrThisConfig = NULL;
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+  bool                         bStatus         = false;
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+  // The pins of the scanned channels are set as analog inputs (the internal channels have no pin):
+  for(enuChannelId = 0; enuChannelId < ADC_eCHANNEL_ID_END; enuChannelId++)
+  {
+    pkstrThisConfig = ADC_kpkstrGetChannelConfig(enuChannelId);
+    CMN_assert(pkstrThisConfig != NULL);
+    CMN_assert(pkstrThisConfig->u8Pin < CHAR_BIT);
+
+    if((pkstrThisConfig->u16RegAddressTris != 0) && (pkstrThisConfig->u16RegAddressAnsel != 0))
+    {
+      CMN_set16BitsMaskReg(pkstrThisConfig->u16RegAddressTris,  (1 << pkstrThisConfig->u8Pin));
+      CMN_set16BitsMaskReg(pkstrThisConfig->u16RegAddressAnsel, (1 << pkstrThisConfig->u8Pin));
+    }
+  }
 
-  CMN_set16BitsMaskReg(ADC_CONFIG_REG_ADDRESS_TRIS,  (1 << ADC_CONFIG_CHANNEL_PORT));
-  CMN_set16BitsMaskReg(ADC_CONFIG_REG_ADDRESS_ANSEL, (1 << ADC_CONFIG_CHANNEL_PORT));
+  // Fixed Voltage Reference (supply measurement) and temperature indicator (low range) for the scan passes:
+  FVRCONbits.ADFVR = ADC_FVR_GAIN;
+  FVRCONbits.TSRNG = 0;
+  FVRCONbits.TSEN  = 1;
+  FVRCONbits.FVREN = 1;
 
   ADREFbits.ADNREF = 0;
   ADREFbits.ADPREF = 0;
@@ -86,47 +489,386 @@ void ADC_vidInitialize(void)
   ADCON0 |= _ADCON0_ADCS_MASK; // Select FRC clock
   ADCON0 |= _ADCON0_ADFM_MASK; // Result right justified
 
+#if(ADC_CONFIG_ENABLE_OVERSAMPLING == true)
+  // Hardware oversampling: 2^N conversions per trigger, the filter register gives the shifted accumulator:
+  ADRPT             = ADC_CONVERSION_COUNT;
+  ADCON2bits.ADCRS  = ADC_ACCUMULATOR_SHIFT;
+  ADCON2bits.ADMD   = ADC_MODE_BURST_AVERAGE;
+#else
+  ADCON2bits.ADMD   = ADC_MODE_BASIC;
+#endif //ADC_CONFIG_ENABLE_OVERSAMPLING
+
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+  // The channel stays connected, each TIM2 period starts a computation whose end raises ADTIF:
+  ADPCH             = ADC_kpkstrGetChannelConfig(ADC_CONFIG_MAIN_CHANNEL_ID)->u8Channel;
+  ADCON3bits.ADTMD  = ADC_THRESHOLD_INTERRUPT_ALWAYS;
+  ADACT             = ADC_TRIGGER_SOURCE_TMR2;
+
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+  ADCON3bits.ADCALC = ADC_ERROR_RESULT_MINUS_SETPOINT;
+  bStatus           = ADC_bSetChangeDelta(ADC_CONFIG_CHANGE_DETECT_DELTA);
+  CMN_assert(bStatus == true);
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+  PIR1bits.ADTIF = 0;
+  PIE1bits.ADTIE = 1;
+
+  bStatus = ISR_bRegisterIsrCbk(ISR_ePERIPHERAL_ADC, bInterruptHandler);
+  CMN_assert(bStatus == true);
+
+  bStatus = TIM2_bStartTrigger(ADC_CONFIG_TRIGGER_PERIOD_US);
+  CMN_assert(bStatus == true);
+#else
   // Connect the ADC channel to the AVSS (Analog Ground):
   ADPCH = ADC_CHANNEL_AVSS;
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
 }
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
 ADC_tenuStatus ADC_enuGetRawValue(uint16_t * const kpu16AdcRawValue, const uint32_t ku32TimeoutMs)
 {
-  ADC_tenuStatus enuStatus     = ADC_eSTATUS_NO_OK;
-  uint32_t       u32TimeoutIdx = 0;
+  ADC_tenuStatus           enuStatus = ADC_eSTATUS_NO_OK;
+  ADC_tstrOversampledValue strValue;
 
-  // Connect the ADC channel associated of the ADC ID:
-  ADPCH = ADC_CONFIG_CHANNEL_ADPCH;
+  if(kpu16AdcRawValue == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    enuStatus         = ADC_enuGetOversampledValue(&strValue, ku32TimeoutMs);
+    *kpu16AdcRawValue = strValue.u16Value;
+  }
 
-  // Start conversion:
-  ADCON0 |= _ADCON0_ADGO_MASK;
+  return enuStatus;
+}
 
-  // Wait until either the ADC conversion is finished or the timeout:
-  while((ADCON0 & _ADCON0_ADGO_MASK) && (u32TimeoutIdx < ku32TimeoutMs))
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuGetOversampledValue(ADC_tstrOversampledValue * const kpstrValue, const uint32_t ku32TimeoutMs)
+{
+  ADC_tenuStatus enuStatus = ADC_eSTATUS_NO_OK;
+
+  if(kpstrValue == NULL)
   {
-    __delay_ms(CMN_1_MS);
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    kpstrValue->u8ConversionCount = ADC_CONVERSION_COUNT;
+    kpstrValue->u8ResolutionBits  = ADC_RESOLUTION_BITS;
+    kpstrValue->u32Accumulator    = 0;
+    kpstrValue->u16Value          = (uint16_t)ADC_TIMEOUT_RAW_VALUE;
+
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+    (void)ku32TimeoutMs;
+
+    // The interruption is masked while the multi-byte values are copied:
+    ADC_mENTER_CRITICAL();
+
+    if(ADC_u8SampleCount == 0)
+    {
+      enuStatus = ADC_eSTATUS_NO_SAMPLE;
+    }
+    else
+    {
+      enuStatus                  = ADC_eSTATUS_OK;
+      kpstrValue->u32Accumulator = ADC_u32LatestAccumulator;
+      kpstrValue->u16Value       = ADC_au16Samples[(ADC_u8SampleIndex - 1) & ADC_SAMPLE_INDEX_MASK];
+    }
+
+    ADC_mEXIT_CRITICAL();
+#else
+    enuStatus = enuConvert(ADC_kpkstrGetChannelConfig(ADC_CONFIG_MAIN_CHANNEL_ID)->u8Channel, ku32TimeoutMs);
+
+    if(enuStatus == ADC_eSTATUS_OK)
+    {
+      kpstrValue->u32Accumulator = ADC_mREAD_ACCUMULATOR();
+      kpstrValue->u16Value       = ADC_mREAD_RESULT();
+    }
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+  }
 
-    u32TimeoutIdx++;
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+ADC_tenuStatus ADC_enuGetLatestValue(uint16_t * const kpu16Value)
+{
+  return ADC_enuGetRawValue(kpu16Value, 0);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuGetAverageValue(uint16_t * const kpu16Value)
+{
+  ADC_tenuStatus enuStatus = ADC_eSTATUS_NO_OK;
+  uint32_t       u32Sum    = 0;
+  uint8_t        u8Count   = 0;
+
+  if(kpu16Value == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    ADC_mENTER_CRITICAL();
+    u32Sum  = ADC_u32SampleSum;
+    u8Count = ADC_u8SampleCount;
+    ADC_mEXIT_CRITICAL();
+
+    if(u8Count == 0)
+    {
+      enuStatus   = ADC_eSTATUS_NO_SAMPLE;
+      *kpu16Value = (uint16_t)ADC_TIMEOUT_RAW_VALUE;
+    }
+    else
+    {
+      enuStatus = ADC_eSTATUS_OK;
+
+      // Rounded average, the division is only done while the buffer is being filled:
+      if(u8Count == ADC_CONFIG_SAMPLE_BUFFER_SIZE)
+      {
+        *kpu16Value = (uint16_t)((u32Sum + (ADC_CONFIG_SAMPLE_BUFFER_SIZE / 2)) / ADC_CONFIG_SAMPLE_BUFFER_SIZE);
+      }
+      else
+      {
+        *kpu16Value = (uint16_t)((u32Sum + (u8Count / 2)) / u8Count);
+      }
+    }
   }
 
-  if(u32TimeoutIdx >= ku32TimeoutMs)
+  return enuStatus;
+}
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+bool ADC_bRegisterChangeCbk(const ADC_tpfvidChangeCallback kpfCallback)
+{
+  bool bStatus = false;
+
+  if(kpfCallback != NULL)
+  {
+    ADC_pfChangeCallback = kpfCallback;
+    bStatus              = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool ADC_bSetChangeDelta(const uint16_t ku16Delta)
+{
+  bool    bStatus       = false;
+  int16_t s16LowerLimit = 0;
+
+  if((ku16Delta > 0) && (ku16Delta <= INT16_MAX))
+  {
+    s16LowerLimit = (int16_t)(-(int16_t)ku16Delta);
+
+    // The window limits are signed 16 Bits registers, the interruption is masked while their two bytes are written:
+    ADC_mENTER_CRITICAL();
+    ADUTHH = (uint8_t)(ku16Delta >> 8);
+    ADUTHL = (uint8_t)ku16Delta;
+    ADLTHH = (uint8_t)((uint16_t)s16LowerLimit >> 8);
+    ADLTHL = (uint8_t)s16LowerLimit;
+    ADC_mEXIT_CRITICAL();
+
+    bStatus = true;
+  }
+
+  return bStatus;
+}
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuStartScan(const uint32_t ku32TimeoutMs)
+{
+  ADC_tenuStatus enuStatus = ADC_eSTATUS_OK;
+
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+  (void)ku32TimeoutMs;
+
+  ADC_mENTER_CRITICAL();
+
+  // The trigger of the main channel is paused first, thus no computation can start after the test below:
+  ADACT = ADC_TRIGGER_SOURCE_NONE;
+
+  if(ADC_enuScanChannelId != ADC_SCAN_IDLE)
+  {
+    enuStatus = ADC_eSTATUS_BUSY;
+  }
+  else if(((ADCON0 & _ADCON0_ADGO_MASK) != 0) || (PIR1bits.ADTIF == 1))
   {
-    enuStatus         = ADC_eSTATUS_CONVERSION_TIMEOUT;
-    *kpu16AdcRawValue = (uint16_t)ADC_TIMEOUT_RAW_VALUE;
+    // A computation of the main channel is running or not yet handled, the pass is started at the next request:
+    ADACT     = ADC_TRIGGER_SOURCE_TMR2;
+    enuStatus = ADC_eSTATUS_BUSY;
   }
   else
   {
-    enuStatus         = ADC_eSTATUS_OK;
-    *kpu16AdcRawValue = (uint16_t)((ADRESH << 8) | ADRESL);
+    // Each conversion of the pass must raise ADTIF, whatever the change-detect window:
+    ADC_u32ScanStartUs    = TIM1_u32GetTimestampUs();
+    ADC_enuScanChannelId  = (ADC_tenuChannelId)(ADC_eCHANNEL_ID_BEGIN + 1);
+    ADCON3bits.ADTMD      = ADC_THRESHOLD_INTERRUPT_ALWAYS;
+    ADPCH                 = ADC_kpkstrGetChannelConfig(ADC_enuScanChannelId)->u8Channel;
+    ADCON0               |= _ADCON0_ADGO_MASK;
   }
 
-  // After the conversion re-connect the ADC channel to the AVSS (Analog Ground):
-  ADPCH = ADC_CHANNEL_AVSS;
+  ADC_mEXIT_CRITICAL();
+#else
+  ADC_tenuChannelId enuChannelId = ADC_eCHANNEL_ID_BEGIN;
 
-  // Stop conversion:
-  ADCON0 &= ~(_ADCON0_ADGO_MASK);
+  ADC_u32ScanStartUs = TIM1_u32GetTimestampUs();
+
+  for(enuChannelId = 0; (enuChannelId < ADC_eCHANNEL_ID_END) && (enuStatus == ADC_eSTATUS_OK); enuChannelId++)
+  {
+    enuStatus = enuConvert(ADC_kpkstrGetChannelConfig(enuChannelId)->u8Channel, ku32TimeoutMs);
+
+    if(enuStatus == ADC_eSTATUS_OK)
+    {
+      ADC_au16ChannelValues[enuChannelId] = ADC_mREAD_RESULT();
+    }
+  }
+
+  // A pass stopped by a timeout is not counted:
+  if(enuStatus == ADC_eSTATUS_OK)
+  {
+    vidEndScanPass();
+  }
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuGetChannelValue(const ADC_tenuChannelId kenuChannelId, uint16_t * const kpu16Value)
+{
+  ADC_tenuStatus enuStatus    = ADC_eSTATUS_NO_OK;
+  uint32_t       u32PassCount = 0;
+  uint16_t       u16Value     = 0;
+  uint16_t       u16FvrValue  = 0;
+
+  if((kenuChannelId <= ADC_eCHANNEL_ID_BEGIN) || (kenuChannelId >= ADC_eCHANNEL_ID_END))
+  {
+    enuStatus = ADC_eSTATUS_INVALID_CHANNEL_ID;
+  }
+  else if(kpu16Value == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    ADC_mENTER_CRITICAL();
+    u32PassCount = ADC_strScanStatistics.u32PassCount;
+    u16Value     = ADC_au16ChannelValues[kenuChannelId];
+    u16FvrValue  = ADC_au16ChannelValues[ADC_CONFIG_FVR_CHANNEL_ID];
+    ADC_mEXIT_CRITICAL();
+
+    if(u32PassCount == 0)
+    {
+      enuStatus = ADC_eSTATUS_NO_SAMPLE;
+    }
+    else
+    {
+      enuStatus = ADC_eSTATUS_OK;
+
+      if(ADC_kpkstrGetChannelConfig(kenuChannelId)->bSupplyCompensation == true)
+      {
+        u16Value = u16CompensateSupply(u16Value, u16FvrValue);
+      }
+
+      *kpu16Value = u16Value;
+    }
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuGetSupplyVoltageMv(uint16_t * const kpu16SupplyMv)
+{
+  ADC_tenuStatus enuStatus   = ADC_eSTATUS_NO_OK;
+  uint32_t       u32SupplyMv = 0;
+  uint16_t       u16FvrValue = 0;
+
+  if(kpu16SupplyMv == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    enuStatus = ADC_enuGetChannelValue(ADC_CONFIG_FVR_CHANNEL_ID, &u16FvrValue);
+
+    if((enuStatus == ADC_eSTATUS_OK) && (u16FvrValue == 0))
+    {
+      // A null FVR conversion means a wrong FVR, not an infinite supply:
+      enuStatus = ADC_eSTATUS_NO_OK;
+    }
+    else if(enuStatus == ADC_eSTATUS_OK)
+    {
+      // VDD = FVR * full scale / FVR value:
+      u32SupplyMv = ((((uint32_t)ADC_CONFIG_FVR_VOLTAGE_MV * ADC_FULL_SCALE) + (u16FvrValue / 2)) / u16FvrValue);
+
+      *kpu16SupplyMv = (u32SupplyMv > UINT16_MAX) ? UINT16_MAX : (uint16_t)u32SupplyMv;
+    }
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuCompensateSupply(uint16_t * const kpu16Value)
+{
+  ADC_tenuStatus enuStatus   = ADC_eSTATUS_NO_OK;
+  uint16_t       u16FvrValue = 0;
+
+  if(kpu16Value == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    enuStatus = ADC_enuGetChannelValue(ADC_CONFIG_FVR_CHANNEL_ID, &u16FvrValue);
+
+    if(enuStatus == ADC_eSTATUS_OK)
+    {
+      *kpu16Value = u16CompensateSupply(*kpu16Value, u16FvrValue);
+    }
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ADC_tenuStatus ADC_enuGetScanStatistics(ADC_tstrScanStatistics * const kpstrStatistics)
+{
+  ADC_tenuStatus enuStatus = ADC_eSTATUS_NO_OK;
+
+  if(kpstrStatistics == NULL)
+  {
+    enuStatus = ADC_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    ADC_mENTER_CRITICAL();
+    kpstrStatistics->u32PassCount      = ADC_strScanStatistics.u32PassCount;
+    kpstrStatistics->u32LastScanTimeUs = ADC_strScanStatistics.u32LastScanTimeUs;
+    kpstrStatistics->u32MaxScanTimeUs  = ADC_strScanStatistics.u32MaxScanTimeUs;
+    ADC_mEXIT_CRITICAL();
+
+    enuStatus = ADC_eSTATUS_OK;
+  }
 
   return enuStatus;
 }
@@ -37,6 +37,32 @@
 #define ADC_TIMEOUT_RAW_VALUE                               0xffff
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the resolution of a single conversion of the ADCC
+ */
+#define ADC_NATIVE_RESOLUTION_BITS                          10
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of effective bits gained by the hardware oversampling (one bit each 4 conversions)
+ */
+#if(ADC_CONFIG_ENABLE_OVERSAMPLING == true)
+#  define ADC_OVERSAMPLING_GAIN_BITS                        (ADC_CONFIG_OVERSAMPLING_RATIO_LOG2 / 2)
+#else
+#  define ADC_OVERSAMPLING_GAIN_BITS                        0
+#endif //ADC_CONFIG_ENABLE_OVERSAMPLING
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the resolution (in effective bits) and the full scale of the values given by this module
+ */
+#define ADC_RESOLUTION_BITS                                 (ADC_NATIVE_RESOLUTION_BITS + ADC_OVERSAMPLING_GAIN_BITS)
+#define ADC_FULL_SCALE                                      (1UL << ADC_RESOLUTION_BITS)
+
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -51,10 +77,49 @@ typedef enum ADC_tenuStatus
   ADC_eSTATUS_NO_OK,                                              //!< Generic/default error code
   ADC_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
   ADC_eSTATUS_CONVERSION_TIMEOUT,                                 //!< The ADC conversion has timed out
+  ADC_eSTATUS_NO_SAMPLE,                                          //!< No conversion was completed yet (continuous mode)
+  ADC_eSTATUS_INVALID_CHANNEL_ID,                                 //!< The passed channel ID is not valid
+  ADC_eSTATUS_BUSY,                                               //!< A conversion or a scan pass is in progress
   ADC_eSTATUS_COUNT                                               //!< The total number of return code
 }ADC_tenuStatus;
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Callback type used to inform the upper layer that the value left the change-detect window
+ * @remark The callback is called from the interruption
+ * @param[in] ku16Value: The new value, on @ref ADC_RESOLUTION_BITS bits
+ */
+typedef void (*ADC_tpfvidChangeCallback)(const uint16_t ku16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @struct ADC_tstrOversampledValue
+ * @brief Structure used to give the result of an oversampled reading
+ */
+typedef struct ADC_tstrOversampledValue
+{
+  uint32_t u32Accumulator;      //!< The sum of the 2^N conversions (native resolution)
+  uint16_t u16Value;            //!< The decimated value, on @ref ADC_RESOLUTION_BITS bits
+  uint8_t  u8ConversionCount;   //!< The number of accumulated conversions
+  uint8_t  u8ResolutionBits;    //!< The number of effective bits of the decimated value
+}ADC_tstrOversampledValue;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @struct ADC_tstrScanStatistics
+ * @brief Structure used to give the timing of the scan passes
+ */
+typedef struct ADC_tstrScanStatistics
+{
+  uint32_t u32PassCount;        //!< The number of completed scan passes
+  uint32_t u32LastScanTimeUs;   //!< The duration of the last pass, from its start to the result of its last channel
+  uint32_t u32MaxScanTimeUs;    //!< The longest pass
+}ADC_tstrScanStatistics;
+
+
 /**********************************************************************************************************************/
 /* PUBLIC FUNCTION PROTOTYPES                                                                                         */
 /**********************************************************************************************************************/
@@ -66,9 +131,126 @@ void ADC_vidInitialize(void);
 
 
 /*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read the ADC channel
+ * @remark In continuous mode, the function returns the latest sample without waiting (the timeout is not used)
+ * @param[out] kpu16AdcRawValue: The read value, on @ref ADC_RESOLUTION_BITS bits (oversampled when the setting
+ *                               @ref ADC_CONFIG_ENABLE_OVERSAMPLING is enabled)
+ * @param[in]     ku32TimeoutMs: The maximal time to wait for the end of the conversions (in ms)
+ * @return The status of the reading (see @ref ADC_tenuStatus)
+ */
 ADC_tenuStatus ADC_enuGetRawValue(uint16_t * const kpu16AdcRawValue, const uint32_t ku32TimeoutMs);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read the ADC channel with the details of the hardware oversampling
+ * @remark In continuous mode, the function returns the latest sample without waiting (the timeout is not used)
+ * @param[out]     kpstrValue: The read value and the accumulator of the conversions
+ * @param[in]   ku32TimeoutMs: The maximal time to wait for the end of the conversions (in ms)
+ * @return The status of the reading (see @ref ADC_tenuStatus)
+ */
+ADC_tenuStatus ADC_enuGetOversampledValue(ADC_tstrOversampledValue * const kpstrValue, const uint32_t ku32TimeoutMs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CONTINUOUS_MODE == true)
+/**
+ * @brief Function used to get the latest sample stored by the continuous mode, without waiting
+ * @param[out] kpu16Value: The latest sample, on @ref ADC_RESOLUTION_BITS bits
+ * @return The status of the reading, @ref ADC_eSTATUS_NO_SAMPLE before the first conversion
+ */
+ADC_tenuStatus ADC_enuGetLatestValue(uint16_t * const kpu16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the average of the samples stored by the continuous mode, without waiting
+ * @details The average is computed on the last @ref ADC_CONFIG_SAMPLE_BUFFER_SIZE samples (or less before the buffer
+ *          is full) from a running sum updated by the interruption
+ * @remark In change-detect mode, the buffer only contains the reported values
+ * @param[out] kpu16Value: The average value, on @ref ADC_RESOLUTION_BITS bits
+ * @return The status of the reading, @ref ADC_eSTATUS_NO_SAMPLE before the first conversion
+ */
+ADC_tenuStatus ADC_enuGetAverageValue(uint16_t * const kpu16Value);
+#endif //ADC_CONFIG_ENABLE_CONTINUOUS_MODE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to start a pass which converts back to back all the channels of the scan table (see
+ *        @ref ADC_tenuChannelId)
+ * @details In continuous mode, the trigger of the main channel is paused during the pass and the interruption chains
+ *          the channels, the function returns at once. In single-shot mode, the function returns at the end of the
+ *          pass.
+ * @param[in] ku32TimeoutMs: The maximal time to wait for each conversion in single-shot mode (in ms)
+ * @return The status of the pass, @ref ADC_eSTATUS_BUSY if a conversion or a pass is in progress (continuous mode)
+ */
+ADC_tenuStatus ADC_enuStartScan(const uint32_t ku32TimeoutMs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the value of a channel given by the last scan passes
+ * @details The value of a channel with a supply compensation is scaled to the reference
+ *          @ref ADC_CONFIG_NOMINAL_VDD_MV with the last FVR conversion
+ * @param[in]  kenuChannelId: The ID of the channel
+ * @param[out]    kpu16Value: The value of the channel, on @ref ADC_RESOLUTION_BITS bits
+ * @return The status of the reading, @ref ADC_eSTATUS_NO_SAMPLE before the end of the first pass
+ */
+ADC_tenuStatus ADC_enuGetChannelValue(const ADC_tenuChannelId kenuChannelId, uint16_t * const kpu16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the supply voltage (the ADC reference) measured with the FVR by the last scan pass
+ * @param[out] kpu16SupplyMv: The supply voltage in mV
+ * @return The status of the reading, @ref ADC_eSTATUS_NO_SAMPLE before the end of the first pass
+ */
+ADC_tenuStatus ADC_enuGetSupplyVoltageMv(uint16_t * const kpu16SupplyMv);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to scale a value converted with the real supply as if it was converted with the reference
+ *        @ref ADC_CONFIG_NOMINAL_VDD_MV (ratiometric correction with the last FVR conversion)
+ * @param[in,out] kpu16Value: The value to be corrected, on @ref ADC_RESOLUTION_BITS bits (not changed if the status is
+ *                            not @ref ADC_eSTATUS_OK)
+ * @return The status of the correction, @ref ADC_eSTATUS_NO_SAMPLE before the end of the first pass
+ */
+ADC_tenuStatus ADC_enuCompensateSupply(uint16_t * const kpu16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the timing of the scan passes
+ * @param[out] kpstrStatistics: The timing of the scan passes
+ * @return The status of the reading
+ */
+ADC_tenuStatus ADC_enuGetScanStatistics(ADC_tstrScanStatistics * const kpstrStatistics);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(ADC_CONFIG_ENABLE_CHANGE_DETECT == true)
+/**
+ * @brief Function used to register the callback called when the value leaves the change-detect window
+ * @param[in] kpfCallback: Pointer to the callback function to be called
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool ADC_bRegisterChangeCbk(const ADC_tpfvidChangeCallback kpfCallback);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to set the half-width of the change-detect window
+ * @param[in] ku16Delta: The change (in steps of @ref ADC_RESOLUTION_BITS bits) needed to report a new value, from 1 to
+ *                       INT16_MAX
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool ADC_bSetChangeDelta(const uint16_t ku16Delta);
+#endif //ADC_CONFIG_ENABLE_CHANGE_DETECT
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 #endif /* ADC_H_ */
 /*--------------------------------------------------------------------------------------------------------------------*/
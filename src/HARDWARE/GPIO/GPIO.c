@@ -75,6 +75,9 @@ GPIO_status GPIO_init(void)
     TRISAbits.TRISA4 = 0;
     LATAbits.LATA4 = 0;
 
+    TRISAbits.TRISA5 = 0;
+    LATAbits.LATA5 = 0;
+
     TRISBbits.TRISB4 = 1;
     ANSELBbits.ANSELB4 = 0;
     // WPUBbits.WPUB4 = 1;
@@ -111,6 +114,12 @@ GPIO_status GPIO_toggleGpio(void)
     return GPIO_OK;
 }
 
+GPIO_status GPIO_setAlarmLed(bool on)
+{
+    LATAbits.LATA5 = on ? 1 : 0;
+    return GPIO_OK;
+}
+
 GPIO_status GPIO_registerCallback(GPIO_callback callback)
 {
     if (callback == NULL)
@@ -58,6 +58,9 @@ GPIO_status GPIO_setGpioLow(void);
 
 GPIO_status GPIO_toggleGpio(void);
 
+// LED d'alarme (RA5), distincte de la LED d'etat (RA4) qui clignote en mesure
+GPIO_status GPIO_setAlarmLed(bool on);
+
 GPIO_status GPIO_registerCallback(GPIO_callback callback);
 
 /*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,86 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      I2CM_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     I2CM Hardware conf part
+ * @details   Module in charge of the management of the I2C peripheral as a master
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef I2CM_CFG_H_
+#define I2CM_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#define I2CM_BUS_SPEED_STANDARD_MODE_HZ                     100000UL   //!< @attention Don't change this macro definition >
+#define I2CM_BUS_SPEED_FAST_MODE_HZ                         400000UL   //!< @attention Don't change this macro definition >
+#define I2CM_BUS_SPEED_FAST_MODE_PLUS_HZ                    1000000UL  //!< @attention Don't change this macro definition >
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the SCL frequency (in Hz) of the I2C instance @ref I2CM_I2C_ID0 (MSSP1 on RB1/RB2)
+ * @details The value can be any frequency up to @ref I2CM_BUS_SPEED_FAST_MODE_PLUS_HZ, the baud rate divider is
+ *          computed at compile time from the setting "CLOCK_CONFIG_FOSC_FREQUENCY_MHZ"
+ * @remark The RB1/RB2 pads have the I2C-specific slew rate control, thus the Fast-mode Plus is supported
+ */
+#define I2CM_CONFIG_I2C_ID0_SPEED_HZ                        I2CM_BUS_SPEED_FAST_MODE_HZ
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines whether the MSSP1 stays enabled between the transactions (persistent-open bus mode) or if it is
+ *        enabled and disabled around each transaction
+ */
+#define I2CM_CONFIG_KEEP_BUS_OPEN                           true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines whether each transaction is recorded by the bus activity tracer or not
+ * @details The tracer keeps the last transactions in a ring (see @ref I2CM_CONFIG_TRACE_DEPTH) and the bus busy time
+ *          per slave address (see @ref I2CM_CONFIG_TRACE_ADDRESS_SLOTS)
+ */
+#define I2CM_CONFIG_ENABLE_TRACE                            true
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of transactions kept by the tracer ring (the oldest ones are overwritten)
+ */
+#define I2CM_CONFIG_TRACE_DEPTH                             16
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the number of slave addresses whose bus usage is aggregated by the tracer
+ */
+#define I2CM_CONFIG_TRACE_ADDRESS_SLOTS                     4
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* I2CM_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
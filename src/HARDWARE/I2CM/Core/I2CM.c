@@ -0,0 +1,877 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      I2CM.c
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     I2CM Hardware core part
+ * @details   Module in charge of the management of the I2C peripheral as a master
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "CLOCK.h"
+#include "I2CM.h"
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+#include "TIMER.h"
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#define I2C_RW_BIT                                          0x01
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Computes the baud rate divider (SSPxADD) of a MSSP for the wanted SCL frequency (in Hz)
+ * @details In I2C Master Mode: Clock = F_OSC / (4 * (SSPxADD + 1)), the division is rounded up so that the obtained
+ *          clock is never faster than the wanted one
+ */
+#define I2CM_BAUD_RATE_DIVIDER(_SPEED_HZ_)                  (((_XTAL_FREQ + (4UL * (_SPEED_HZ_)) - 1) / (4UL * (_SPEED_HZ_))) - 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Computes the SCL frequency (in Hz) really obtained with a baud rate divider (SSPxADD)
+ */
+#define I2CM_BUS_FREQUENCY_HZ(_DIVIDER_)                    (_XTAL_FREQ / (4UL * ((_DIVIDER_) + 1)))
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// Allowed range of the baud rate divider (see "PIC18F47Q10 - Datasheet", 27.7 - SSPxADD values 0 to 2 are not supported):
+#define I2CM_MIN_BAUD_RATE_DIVIDER                          3
+#define I2CM_MAX_BAUD_RATE_DIVIDER                          255
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Checks the value of the setting @ref I2CM_CONFIG_I2C_ID0_SPEED_HZ is achievable with the configured Fosc
+ */
+#if((I2CM_CONFIG_I2C_ID0_SPEED_HZ == 0) || (I2CM_CONFIG_I2C_ID0_SPEED_HZ > I2CM_BUS_SPEED_FAST_MODE_PLUS_HZ))
+#error "[I2CM] Error: I2CM_CONFIG_I2C_ID0_SPEED_HZ shall be in the range ]0 ; 1 MHz]"
+#elif(I2CM_CONFIG_I2C_ID0_SPEED_HZ > I2CM_BUS_FREQUENCY_HZ(I2CM_MIN_BAUD_RATE_DIVIDER))
+#error "[I2CM] Error: I2CM_CONFIG_I2C_ID0_SPEED_HZ is too high for the configured Fosc"
+#elif(I2CM_BAUD_RATE_DIVIDER(I2CM_CONFIG_I2C_ID0_SPEED_HZ) > I2CM_MAX_BAUD_RATE_DIVIDER)
+#error "[I2CM] Error: I2CM_CONFIG_I2C_ID0_SPEED_HZ is too low for the configured Fosc"
+#elif(I2CM_BUS_FREQUENCY_HZ(I2CM_BAUD_RATE_DIVIDER(I2CM_CONFIG_I2C_ID0_SPEED_HZ)) != I2CM_CONFIG_I2C_ID0_SPEED_HZ)
+#pragma message "[I2CM] Warning: I2CM_CONFIG_I2C_ID0_SPEED_HZ is not an exact divider of Fosc, the clock is rounded down"
+#endif //I2CM_CONFIG_I2C_ID0_SPEED_HZ
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// Values of the RxyI2C pad control registers (see "PIC18F47Q10 - Datasheet", 15.7 - RxyI2C):
+#define I2CM_PAD_SLEW_I2C                                   0b01  //!< I2C-specific slew rate limiting (Standard/Fast mode)
+#define I2CM_PAD_SLEW_FAST_MODE_PLUS                        0b10  //!< I2C Fast-mode Plus slew rate
+#define I2CM_PAD_THRESHOLD_I2C                              0b01  //!< I2C-specific input thresholds
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Number of SCL periods of the longest bus phase (8 data bits + the ACK bit)
+ */
+#define I2CM_SCL_PERIODS_PER_PHASE                          9
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Margin applied on the nominal phase duration to tolerate the clock stretching of the slaves
+ */
+#define I2CM_TIMEOUT_MARGIN_FACTOR                          4
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Delay between two polls of the interrupt flag (in us)
+ */
+#define I2CM_POLLING_STEP_US                                1
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maximal number of polls of the interrupt flag before considering a bus phase as timed out
+ * @details Derived from the bus clock: (I2CM_SCL_PERIODS_PER_PHASE * I2CM_TIMEOUT_MARGIN_FACTOR) SCL periods
+ */
+#define I2CM_PHASE_TIMEOUT_POLLS(_SPEED_HZ_)                ((uint16_t)(((I2CM_SCL_PERIODS_PER_PHASE * I2CM_TIMEOUT_MARGIN_FACTOR * 1000000UL) / \
+                                                                          (_SPEED_HZ_)) / I2CM_POLLING_STEP_US) + 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Number of SCL pulses to clock out to release a slave which holds SDA low (see I2C-bus specification, 3.1.16)
+ */
+#define I2CM_RECOVERY_SCL_PULSES                            9
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Half period of the SCL pulses generated by software during the recovery (in us, 5 us -> 100 kHz)
+ */
+#define I2CM_RECOVERY_HALF_PERIOD_US                        5
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// PPS output codes of the RB1 (SCL) and RB2 (SDA) pins:
+#define I2CM_PPS_OUTPUT_LATCH                               0x00  //!< The pin is driven by its LAT bit
+#define I2CM_PPS_OUTPUT_SCL1                                0x0F  //!< The pin is driven by the MSSP1 SCL output
+#define I2CM_PPS_OUTPUT_SDA1                                0x10  //!< The pin is driven by the MSSP1 SDA output
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Checks the values of the tracer settings
+ */
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+#if((I2CM_CONFIG_TRACE_DEPTH == 0) || (I2CM_CONFIG_TRACE_DEPTH > 255))
+#error "[I2CM] Error: I2CM_CONFIG_TRACE_DEPTH shall be in the range [1 ; 255]"
+#endif //I2CM_CONFIG_TRACE_DEPTH
+#if((I2CM_CONFIG_TRACE_ADDRESS_SLOTS == 0) || (I2CM_CONFIG_TRACE_ADDRESS_SLOTS > 255))
+#error "[I2CM] Error: I2CM_CONFIG_TRACE_ADDRESS_SLOTS shall be in the range [1 ; 255]"
+#endif //I2CM_CONFIG_TRACE_ADDRESS_SLOTS
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+/**
+ * @brief Structure of a traced transaction
+ */
+typedef struct I2CM_tstrTraceRecord
+{
+  uint32_t                                                  u32TimestampUs;
+  uint16_t                                                  u16DurationUs;
+  uint16_t                                                  u16Length;
+  uint8_t                                                   u8SlaveAddress;
+  uint8_t                                                   u8Direction;
+  uint8_t                                                   u8Status;
+}I2CM_tstrTraceRecord;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure of the bus usage aggregated for a slave address (the slot is free while the address is 0)
+ */
+typedef struct I2CM_tstrBusUsage
+{
+  uint8_t                                                   u8SlaveAddress;
+  uint16_t                                                  u16TransactionCount;
+  uint16_t                                                  u16ErrorCount;
+  uint32_t                                                  u32BusyTimeUs;
+}I2CM_tstrBusUsage;
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief The timeout and recovery counters of each I2C instance
+ */
+static I2CM_tstrStatistics I2CM_astrStatistics[I2CM_I2C_ID_COUNT] = { 0 };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The baud rate divider currently applied on each I2C instance (can be changed with @ref I2CM_enuSetBusSpeed)
+ */
+static uint8_t I2CM_au8BaudRateDivider[I2CM_I2C_ID_COUNT] =
+{
+  [I2CM_I2C_ID0] = (uint8_t)I2CM_BAUD_RATE_DIVIDER(I2CM_CONFIG_I2C_ID0_SPEED_HZ),
+};
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The timeout of a bus phase of each I2C instance, derived from its current SCL frequency
+ */
+static uint16_t I2CM_au16PhaseTimeoutPolls[I2CM_I2C_ID_COUNT] =
+{
+  [I2CM_I2C_ID0] = I2CM_PHASE_TIMEOUT_POLLS(I2CM_BUS_FREQUENCY_HZ(I2CM_BAUD_RATE_DIVIDER(I2CM_CONFIG_I2C_ID0_SPEED_HZ))),
+};
+
+
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The ring of the traced transactions (the oldest one is at I2CM_u8TraceTail)
+ */
+static I2CM_tstrTraceRecord I2CM_astrTraceRing[I2CM_CONFIG_TRACE_DEPTH];
+static uint8_t              I2CM_u8TraceTail  = 0;
+static uint8_t              I2CM_u8TraceCount = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The bus usage aggregated per slave address
+ */
+static I2CM_tstrBusUsage I2CM_astrBusUsage[I2CM_CONFIG_TRACE_ADDRESS_SLOTS] = { 0 };
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+static bool bI2cReservedAddress(const uint8_t ku8I2cAddress);
+static bool bIsTimeoutStatus(const I2CM_tenuStatus kenuStatus);
+static void vidMssp1Configure(void);
+static void vidMssp1ApplyBusSpeed(void);
+static void vidI2c1Open(void);
+static void vidI2c1Close(void);
+static I2CM_tenuStatus enuI2c1IsrFlagPolling(const I2CM_tenuStatus kenuTimeoutStatus);
+static I2CM_tenuStatus enuI2c1SendByte(const uint8_t ku8Data, const I2CM_tenuStatus kenuTimeoutStatus);
+static I2CM_tenuStatus enuI2c1Stop(void);
+static I2CM_tenuStatus enuI2c1RecoverBus(void);
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+static void vidTraceTransaction(const uint8_t ku8I2cSlaveAddress,
+                                const I2CM_tenuTraceDirection kenuDirection,
+                                const uint16_t ku16Length,
+                                const I2CM_tenuStatus kenuStatus,
+                                const uint32_t ku32StartUs);
+static uint8_t u8SerializeUint(uint8_t * const kpu8Buffer, const uint32_t ku32Value, const uint8_t ku8Size);
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bI2cReservedAddress(const uint8_t ku8I2cAddress)
+{
+  return ((ku8I2cAddress & 0x78) == 0) || ((ku8I2cAddress & 0x78) == 0x78);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bIsTimeoutStatus(const I2CM_tenuStatus kenuStatus)
+{
+  return (I2CM_eSTATUS_START_TIMEOUT <= kenuStatus) && (kenuStatus <= I2CM_eSTATUS_STOP_TIMEOUT);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidMssp1Configure(void)
+{
+  /* Reset the MSSP1 state machine */
+  SSP1CON1 = 0;
+  SSP1CON2 = 0;
+
+  /* PPS setting for using RB1 as SCL */
+  SSP1CLKPPS = 0x09;
+  RB1PPS     = I2CM_PPS_OUTPUT_SCL1;
+
+  /* PPS setting for using RB2 as SDA */
+  SSP1DATPPS = 0x0A;
+  RB2PPS     = I2CM_PPS_OUTPUT_SDA1;
+
+  /* Set pins RB1 and RB2 as Digital */
+  ANSELBbits.ANSELB1 = 0;
+  ANSELBbits.ANSELB2 = 0;
+
+  /* Set pull-up resistorsfor RB1 and RB2 */
+  WPUBbits.WPUB1 = 1;
+  WPUBbits.WPUB2 = 1;
+
+  /* I2C Master Mode: Clock = F_OSC / (4 * (SSP1ADD + 1)) */
+  SSP1CON1bits.SSPM3 = 1;
+
+  /* Set the boud rate devider and the pads to obtain the I2C clock */
+  vidMssp1ApplyBusSpeed();
+
+  /* Clear IRQ */
+  PIR3bits.SSP1IF = 0;
+
+#if(I2CM_CONFIG_KEEP_BUS_OPEN == true)
+  /* I2C Master Open for the whole life of the software */
+  SSP1CON1bits.SSPEN = 1;
+#endif //I2CM_CONFIG_KEEP_BUS_OPEN
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidMssp1ApplyBusSpeed(void)
+{
+  const uint8_t  ku8Divider  = I2CM_au8BaudRateDivider[I2CM_I2C_ID0];
+  const uint32_t ku32SpeedHz = I2CM_BUS_FREQUENCY_HZ(ku8Divider);
+
+  SSP1ADD = ku8Divider;
+
+  /* Slew rate control of the MSSP: enabled only for the Fast mode, disabled for the Standard and Fast-mode Plus */
+  SSP1STATbits.SMP = ((I2CM_BUS_SPEED_STANDARD_MODE_HZ < ku32SpeedHz) && (ku32SpeedHz <= I2CM_BUS_SPEED_FAST_MODE_HZ)) ? 0 : 1;
+
+  /* I2C pads: I2C thresholds and the slew rate matching the bus speed */
+  RB1I2Cbits.TH   = I2CM_PAD_THRESHOLD_I2C;
+  RB2I2Cbits.TH   = I2CM_PAD_THRESHOLD_I2C;
+  RB1I2Cbits.SLEW = (ku32SpeedHz > I2CM_BUS_SPEED_FAST_MODE_HZ) ? I2CM_PAD_SLEW_FAST_MODE_PLUS : I2CM_PAD_SLEW_I2C;
+  RB2I2Cbits.SLEW = (ku32SpeedHz > I2CM_BUS_SPEED_FAST_MODE_HZ) ? I2CM_PAD_SLEW_FAST_MODE_PLUS : I2CM_PAD_SLEW_I2C;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidI2c1Open(void)
+{
+  /* Clear IRQ */
+  PIR3bits.SSP1IF = 0;
+
+#if(I2CM_CONFIG_KEEP_BUS_OPEN == false)
+  /* I2C Master Open */
+  SSP1CON1bits.SSPEN = 1;
+#endif //I2CM_CONFIG_KEEP_BUS_OPEN
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidI2c1Close(void)
+{
+#if(I2CM_CONFIG_KEEP_BUS_OPEN == false)
+  /* Disable I2C1 */
+  SSP1CON1bits.SSPEN = 0;
+#endif //I2CM_CONFIG_KEEP_BUS_OPEN
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static I2CM_tenuStatus enuI2c1IsrFlagPolling(const I2CM_tenuStatus kenuTimeoutStatus)
+{
+  I2CM_tenuStatus enuStatus   = I2CM_eSTATUS_OK;
+  uint16_t        u16PollIdx  = 0;
+
+  /* Polling Interrupt Flag, bounded by the timeout of the bus phase */
+  while((PIR3bits.SSP1IF == 0) && (u16PollIdx < I2CM_au16PhaseTimeoutPolls[I2CM_I2C_ID0]))
+  {
+    __delay_us(I2CM_POLLING_STEP_US);
+
+    u16PollIdx++;
+  }
+
+  if(PIR3bits.SSP1IF == 0)
+  {
+    enuStatus = kenuTimeoutStatus;
+
+    I2CM_astrStatistics[I2CM_I2C_ID0].u16TimeoutCount++;
+  }
+
+  /* Clear Interrupt Flag */
+  PIR3bits.SSP1IF = 0;
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static I2CM_tenuStatus enuI2c1SendByte(const uint8_t ku8Data, const I2CM_tenuStatus kenuTimeoutStatus)
+{
+  I2CM_tenuStatus enuStatus = I2CM_eSTATUS_OK;
+
+  SSP1BUF = ku8Data;
+
+  enuStatus = enuI2c1IsrFlagPolling(kenuTimeoutStatus);
+
+  if((enuStatus == I2CM_eSTATUS_OK) && (SSP1CON2bits.ACKSTAT))
+  {
+    enuStatus = I2CM_eSTATUS_NO_ACKED;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static I2CM_tenuStatus enuI2c1Stop(void)
+{
+  /* STOP Condition */
+  SSP1CON2bits.PEN = 1;
+
+  return enuI2c1IsrFlagPolling(I2CM_eSTATUS_STOP_TIMEOUT);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static I2CM_tenuStatus enuI2c1RecoverBus(void)
+{
+  I2CM_tenuStatus enuStatus  = I2CM_eSTATUS_OK;
+  uint8_t         u8PulseIdx = 0;
+
+  I2CM_astrStatistics[I2CM_I2C_ID0].u16RecoveryCount++;
+
+  /* Disable I2C1 and give the control of the pins back to the latches (open-drain emulated with the TRIS bits) */
+  SSP1CON1bits.SSPEN = 0;
+  RB1PPS             = I2CM_PPS_OUTPUT_LATCH;
+  RB2PPS             = I2CM_PPS_OUTPUT_LATCH;
+  LATBbits.LATB1     = 0;
+  LATBbits.LATB2     = 0;
+  TRISBbits.TRISB1   = 1;
+  TRISBbits.TRISB2   = 1;
+
+  /* Clock out up to 9 SCL pulses until the slave releases SDA */
+  for(u8PulseIdx = 0; ((u8PulseIdx < I2CM_RECOVERY_SCL_PULSES) && (PORTBbits.RB2 == 0)); u8PulseIdx++)
+  {
+    TRISBbits.TRISB1 = 0;
+    __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+    TRISBbits.TRISB1 = 1;
+    __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+  }
+
+  /* STOP Condition: SDA rising while SCL is high */
+  TRISBbits.TRISB1 = 0;
+  __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+  TRISBbits.TRISB2 = 0;
+  __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+  TRISBbits.TRISB1 = 1;
+  __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+  TRISBbits.TRISB2 = 1;
+  __delay_us(I2CM_RECOVERY_HALF_PERIOD_US);
+
+  if((PORTBbits.RB1 == 0) || (PORTBbits.RB2 == 0))
+  {
+    enuStatus = I2CM_eSTATUS_BUS_STUCK;
+
+    I2CM_astrStatistics[I2CM_I2C_ID0].u16RecoveryFailureCount++;
+  }
+
+  /* Re-init MSSP1 */
+  vidMssp1Configure();
+
+  return enuStatus;
+}
+
+
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidTraceTransaction(const uint8_t ku8I2cSlaveAddress,
+                                const I2CM_tenuTraceDirection kenuDirection,
+                                const uint16_t ku16Length,
+                                const I2CM_tenuStatus kenuStatus,
+                                const uint32_t ku32StartUs)
+{
+  const uint32_t        ku32DurationUs = TIM1_u32GetTimestampUs() - ku32StartUs;
+  I2CM_tstrTraceRecord* pstrRecord     = NULL;
+  I2CM_tstrBusUsage*    pstrUsage      = NULL;
+  uint8_t               u8SlotIdx      = 0;
+
+  /* The ring is full: the oldest record is overwritten */
+  if(I2CM_u8TraceCount == I2CM_CONFIG_TRACE_DEPTH)
+  {
+    I2CM_u8TraceTail = (uint8_t)((I2CM_u8TraceTail + 1) % I2CM_CONFIG_TRACE_DEPTH);
+    I2CM_u8TraceCount--;
+
+    I2CM_astrStatistics[I2CM_I2C_ID0].u16TraceDropCount++;
+  }
+
+  pstrRecord = &I2CM_astrTraceRing[(I2CM_u8TraceTail + I2CM_u8TraceCount) % I2CM_CONFIG_TRACE_DEPTH];
+
+  pstrRecord->u32TimestampUs = ku32StartUs;
+  pstrRecord->u16DurationUs  = (ku32DurationUs > UINT16_MAX) ? UINT16_MAX : (uint16_t)ku32DurationUs;
+  pstrRecord->u16Length      = ku16Length;
+  pstrRecord->u8SlaveAddress = ku8I2cSlaveAddress;
+  pstrRecord->u8Direction    = (uint8_t)kenuDirection;
+  pstrRecord->u8Status       = (uint8_t)kenuStatus;
+
+  I2CM_u8TraceCount++;
+
+  /* Aggregation in the slot of the address, or in the first free one (the addresses not tracked are ignored) */
+  for(u8SlotIdx = 0; ((u8SlotIdx < I2CM_CONFIG_TRACE_ADDRESS_SLOTS) && (pstrUsage == NULL)); u8SlotIdx++)
+  {
+    if((I2CM_astrBusUsage[u8SlotIdx].u8SlaveAddress == ku8I2cSlaveAddress) ||
+       (I2CM_astrBusUsage[u8SlotIdx].u8SlaveAddress == 0))
+    {
+      pstrUsage = &I2CM_astrBusUsage[u8SlotIdx];
+    }
+  }
+
+  if(pstrUsage != NULL)
+  {
+    pstrUsage->u8SlaveAddress = ku8I2cSlaveAddress;
+    pstrUsage->u16TransactionCount++;
+    pstrUsage->u32BusyTimeUs += ku32DurationUs;
+
+    if(kenuStatus != I2CM_eSTATUS_OK)
+    {
+      pstrUsage->u16ErrorCount++;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8SerializeUint(uint8_t * const kpu8Buffer, const uint32_t ku32Value, const uint8_t ku8Size)
+{
+  uint8_t u8ByteIdx = 0;
+
+  /* Little endian */
+  for(u8ByteIdx = 0; u8ByteIdx < ku8Size; u8ByteIdx++)
+  {
+    kpu8Buffer[u8ByteIdx] = (uint8_t)(ku32Value >> (8 * u8ByteIdx));
+  }
+
+  return ku8Size;
+}
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void I2CM_vidInitalize(void)
+{
+  vidMssp1Configure();
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+I2CM_tenuStatus I2CM_enuWriteBuffer(const I2CM_tenuI2cId kenuI2cId,
+                                        const uint8_t ku8I2cSlaveAddress,
+                                        uint8_t const * const kpku8TxBuffer,
+                                        const uint16_t ku16TxBufferSize)
+{
+  I2CM_tenuStatus enuStatus = I2CM_eSTATUS_OK;
+  uint16_t            u16Index  = 0;
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+  uint32_t            u32StartUs = 0;
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+  if(kenuI2cId >= I2CM_I2C_ID_COUNT)
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_I2C_ID;
+  }
+  else if(bI2cReservedAddress(ku8I2cSlaveAddress))
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_SLAVE_ADDRESS;
+  }
+  else if(kpku8TxBuffer == NULL)
+  {
+    enuStatus = I2CM_eSTATUS_NULL_POINTER;
+  }
+  else if(ku16TxBufferSize == 0)
+  {
+    enuStatus = I2CM_eSTATUS_EMPTY_BUFFER;
+  }
+  else
+  {
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+    u32StartUs = TIM1_u32GetTimestampUs();
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+    vidI2c1Open();
+
+    /* START Condition*/
+    SSP1CON2bits.SEN = 1;
+
+    enuStatus = enuI2c1IsrFlagPolling(I2CM_eSTATUS_START_TIMEOUT);
+
+    if(enuStatus == I2CM_eSTATUS_OK)
+    {
+      enuStatus = enuI2c1SendByte((uint8_t)((ku8I2cSlaveAddress << 1) & ~I2C_RW_BIT), I2CM_eSTATUS_ADDRESS_TIMEOUT);
+    }
+
+    for(u16Index = 0; ((u16Index < ku16TxBufferSize) && (enuStatus == I2CM_eSTATUS_OK)); u16Index++)
+    {
+      enuStatus = enuI2c1SendByte(kpku8TxBuffer[u16Index], I2CM_eSTATUS_DATA_TIMEOUT);
+
+      if(enuStatus == I2CM_eSTATUS_NO_ACKED)
+      {
+        enuStatus = I2CM_eSTATUS_NO_OK;
+      }
+    }
+
+    /* STOP Condition (the bus recovery generates its own STOP) */
+    if(!bIsTimeoutStatus(enuStatus))
+    {
+      if((enuI2c1Stop() != I2CM_eSTATUS_OK) && (enuStatus == I2CM_eSTATUS_OK))
+      {
+        enuStatus = I2CM_eSTATUS_STOP_TIMEOUT;
+      }
+    }
+
+    if(bIsTimeoutStatus(enuStatus) && (enuI2c1RecoverBus() != I2CM_eSTATUS_OK))
+    {
+      enuStatus = I2CM_eSTATUS_BUS_STUCK;
+    }
+
+    vidI2c1Close();
+
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+    vidTraceTransaction(ku8I2cSlaveAddress, I2CM_eTRACE_WRITE, ku16TxBufferSize, enuStatus, u32StartUs);
+#endif //I2CM_CONFIG_ENABLE_TRACE
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+I2CM_tenuStatus I2CM_enuReadBuffer(const I2CM_tenuI2cId kenuI2cId,
+                                       const uint8_t ku8I2cSlaveAddress,
+                                       uint8_t const * const kpku8TxBuffer,
+                                       const uint16_t ku16TxBufferSize,
+                                       uint8_t * const kpu8RxBuffer,
+                                       const uint16_t ku16RxBufferSize)
+{
+  I2CM_tenuStatus enuStatus        = I2CM_eSTATUS_OK;
+  uint16_t            u16Index         = 0;
+  uint16_t            u16RxBufferIndex = 0;
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+  uint32_t            u32StartUs       = 0;
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+  if(kenuI2cId >= I2CM_I2C_ID_COUNT)
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_I2C_ID;
+  }
+  else if(bI2cReservedAddress(ku8I2cSlaveAddress))
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_SLAVE_ADDRESS;
+  }
+  else if((kpku8TxBuffer == NULL) || (kpu8RxBuffer == NULL))
+  {
+    enuStatus = I2CM_eSTATUS_NULL_POINTER;
+  }
+  else if((ku16TxBufferSize == 0) || (ku16RxBufferSize == 0))
+  {
+    enuStatus = I2CM_eSTATUS_EMPTY_BUFFER;
+  }
+  else
+  {
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+    u32StartUs = TIM1_u32GetTimestampUs();
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+    vidI2c1Open();
+
+    /* START Condition */
+    SSP1CON2bits.SEN = 1;
+
+    enuStatus = enuI2c1IsrFlagPolling(I2CM_eSTATUS_START_TIMEOUT);
+
+    // Sending the slave address in write mode:
+    if(enuStatus == I2CM_eSTATUS_OK)
+    {
+      enuStatus = enuI2c1SendByte((uint8_t)((ku8I2cSlaveAddress << 1) & ~I2C_RW_BIT), I2CM_eSTATUS_ADDRESS_TIMEOUT);
+    }
+
+    for(u16Index = 0; ((u16Index < ku16TxBufferSize) && (enuStatus == I2CM_eSTATUS_OK)); u16Index++)
+    {
+      enuStatus = enuI2c1SendByte(kpku8TxBuffer[u16Index], I2CM_eSTATUS_DATA_TIMEOUT);
+
+      if(enuStatus == I2CM_eSTATUS_NO_ACKED)
+      {
+        enuStatus = I2CM_eSTATUS_NO_OK;
+      }
+    }
+
+    if(enuStatus == I2CM_eSTATUS_OK)
+    {
+      /* Repeated START Condition: the bus is kept between the write and the read phases */
+      SSP1CON2bits.RSEN = 1;
+
+      enuStatus = enuI2c1IsrFlagPolling(I2CM_eSTATUS_START_TIMEOUT);
+    }
+
+    // Sending the slave address in read mode:
+    if(enuStatus == I2CM_eSTATUS_OK)
+    {
+      enuStatus = enuI2c1SendByte((uint8_t)((ku8I2cSlaveAddress << 1) | I2C_RW_BIT), I2CM_eSTATUS_ADDRESS_TIMEOUT);
+    }
+
+    while((u16RxBufferIndex < ku16RxBufferSize) && (enuStatus == I2CM_eSTATUS_OK))
+    {
+      // The ACK is received from the slave, then let continue by enabling the master in receiver mode:
+      SSP1CON2bits.RCEN = 1;
+
+      // After the eighth falling edge of SCL, SSPxIF and BF are set:
+      enuStatus = enuI2c1IsrFlagPolling(I2CM_eSTATUS_DATA_TIMEOUT);
+
+      if(enuStatus == I2CM_eSTATUS_OK)
+      {
+        // Master clears SSPxIF and reads the received byte from SSPUF which clears BF:
+        kpu8RxBuffer[u16RxBufferIndex] = SSP1BUF;
+
+        // Master sends a not ACK on the last byte to end communication, an ACK otherwise:
+        SSP1CON2bits.ACKDT = (u16RxBufferIndex == (ku16RxBufferSize - 1)) ? 1 : 0;
+        SSP1CON2bits.ACKEN = 1;
+
+        // Master's ACK is clocked out to the slave and SSPxIF is set:
+        enuStatus = enuI2c1IsrFlagPolling(I2CM_eSTATUS_DATA_TIMEOUT);
+
+        u16RxBufferIndex++;
+      }
+    }
+
+    /* STOP Condition (the bus recovery generates its own STOP) */
+    if(!bIsTimeoutStatus(enuStatus))
+    {
+      if((enuI2c1Stop() != I2CM_eSTATUS_OK) && (enuStatus == I2CM_eSTATUS_OK))
+      {
+        enuStatus = I2CM_eSTATUS_STOP_TIMEOUT;
+      }
+    }
+
+    if(bIsTimeoutStatus(enuStatus) && (enuI2c1RecoverBus() != I2CM_eSTATUS_OK))
+    {
+      enuStatus = I2CM_eSTATUS_BUS_STUCK;
+    }
+
+    vidI2c1Close();
+
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+    vidTraceTransaction(ku8I2cSlaveAddress, I2CM_eTRACE_READ, (uint16_t)(ku16TxBufferSize + ku16RxBufferSize), enuStatus, u32StartUs);
+#endif //I2CM_CONFIG_ENABLE_TRACE
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+I2CM_tenuStatus I2CM_enuGetStatistics(const I2CM_tenuI2cId kenuI2cId, I2CM_tstrStatistics * const kpstrStatistics)
+{
+  I2CM_tenuStatus enuStatus = I2CM_eSTATUS_OK;
+
+  if(kenuI2cId >= I2CM_I2C_ID_COUNT)
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_I2C_ID;
+  }
+  else if(kpstrStatistics == NULL)
+  {
+    enuStatus = I2CM_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrStatistics = I2CM_astrStatistics[kenuI2cId];
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+I2CM_tenuStatus I2CM_enuSetBusSpeed(const I2CM_tenuI2cId kenuI2cId, const uint32_t ku32BusSpeedHz)
+{
+  I2CM_tenuStatus enuStatus = I2CM_eSTATUS_OK;
+
+  if(kenuI2cId >= I2CM_I2C_ID_COUNT)
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_I2C_ID;
+  }
+  else if((ku32BusSpeedHz == 0)                                 ||
+          (ku32BusSpeedHz > I2CM_BUS_SPEED_FAST_MODE_PLUS_HZ)   ||
+          (ku32BusSpeedHz > I2CM_BUS_FREQUENCY_HZ(I2CM_MIN_BAUD_RATE_DIVIDER)) ||
+          (I2CM_BAUD_RATE_DIVIDER(ku32BusSpeedHz) > I2CM_MAX_BAUD_RATE_DIVIDER))
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_BUS_SPEED;
+  }
+  else
+  {
+    I2CM_au8BaudRateDivider[kenuI2cId]    = (uint8_t)I2CM_BAUD_RATE_DIVIDER(ku32BusSpeedHz);
+    I2CM_au16PhaseTimeoutPolls[kenuI2cId] = I2CM_PHASE_TIMEOUT_POLLS(I2CM_BUS_FREQUENCY_HZ(I2CM_au8BaudRateDivider[kenuI2cId]));
+
+    /* The bus is idle between two transactions, the MSSP1 is stopped while its clock is changed */
+    SSP1CON1bits.SSPEN = 0;
+
+    vidMssp1ApplyBusSpeed();
+
+#if(I2CM_CONFIG_KEEP_BUS_OPEN == true)
+    SSP1CON1bits.SSPEN = 1;
+#endif //I2CM_CONFIG_KEEP_BUS_OPEN
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+I2CM_tenuStatus I2CM_enuGetBusSpeed(const I2CM_tenuI2cId kenuI2cId, uint32_t * const kpu32BusSpeedHz)
+{
+  I2CM_tenuStatus enuStatus = I2CM_eSTATUS_OK;
+
+  if(kenuI2cId >= I2CM_I2C_ID_COUNT)
+  {
+    enuStatus = I2CM_eSTATUS_INVALID_I2C_ID;
+  }
+  else if(kpu32BusSpeedHz == NULL)
+  {
+    enuStatus = I2CM_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpu32BusSpeedHz = I2CM_BUS_FREQUENCY_HZ(I2CM_au8BaudRateDivider[kenuI2cId]);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+uint16_t I2CM_u16ExportTrace(uint8_t * const kpu8Buffer, const uint16_t ku16BufferSize)
+{
+  uint16_t                    u16Size     = 0;
+  I2CM_tstrTraceRecord const* pkstrRecord = NULL;
+
+  if(kpu8Buffer != NULL)
+  {
+    while((I2CM_u8TraceCount > 0) && ((u16Size + I2CM_TRACE_RECORD_SIZE) <= ku16BufferSize))
+    {
+      pkstrRecord = &I2CM_astrTraceRing[I2CM_u8TraceTail];
+
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u32TimestampUs, sizeof(uint32_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u16DurationUs,  sizeof(uint16_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u16Length,      sizeof(uint16_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u8SlaveAddress, sizeof(uint8_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u8Direction,    sizeof(uint8_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], pkstrRecord->u8Status,       sizeof(uint8_t));
+
+      I2CM_u8TraceTail = (uint8_t)((I2CM_u8TraceTail + 1) % I2CM_CONFIG_TRACE_DEPTH);
+      I2CM_u8TraceCount--;
+    }
+  }
+
+  return u16Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint16_t I2CM_u16ExportBusUsage(uint8_t * const kpu8Buffer, const uint16_t ku16BufferSize)
+{
+  uint16_t u16Size   = 0;
+  uint8_t  u8SlotIdx = 0;
+
+  if(kpu8Buffer != NULL)
+  {
+    for(u8SlotIdx = 0; ((u8SlotIdx < I2CM_CONFIG_TRACE_ADDRESS_SLOTS)                   &&
+                        (I2CM_astrBusUsage[u8SlotIdx].u8SlaveAddress != 0)                 &&
+                        ((u16Size + I2CM_BUS_USAGE_RECORD_SIZE) <= ku16BufferSize)); u8SlotIdx++)
+    {
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], I2CM_astrBusUsage[u8SlotIdx].u8SlaveAddress,      sizeof(uint8_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], I2CM_astrBusUsage[u8SlotIdx].u16TransactionCount, sizeof(uint16_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], I2CM_astrBusUsage[u8SlotIdx].u16ErrorCount,       sizeof(uint16_t));
+      u16Size += u8SerializeUint(&kpu8Buffer[u16Size], I2CM_astrBusUsage[u8SlotIdx].u32BusyTimeUs,       sizeof(uint32_t));
+    }
+  }
+
+  return u16Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif //I2CM_CONFIG_ENABLE_TRACE
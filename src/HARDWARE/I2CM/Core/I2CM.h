@@ -0,0 +1,230 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      I2CM.h
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     I2CM Hardware core part
+ * @details   Module in charge of the management of the I2C peripheral as a master
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef I2CM_H_
+#define I2CM_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+#include "I2CM_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of a transaction record exported by @ref I2CM_u16ExportTrace (all fields are little endian):
+ *          - [0..3]  Timestamp of the START in us (see TIM1_u32GetTimestampUs)
+ *          - [4..5]  Duration of the transaction in us
+ *          - [6..7]  Number of payload bytes (Tx + Rx)
+ *          - [8]     7 Bits slave address
+ *          - [9]     Direction (see @ref I2CM_tenuTraceDirection)
+ *          - [10]    Status (see @ref I2CM_tenuStatus)
+ */
+#define I2CM_TRACE_RECORD_SIZE                              11
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of a bus usage record exported by @ref I2CM_u16ExportBusUsage (all fields are little endian):
+ *          - [0]     7 Bits slave address
+ *          - [1..2]  Number of transactions
+ *          - [3..4]  Number of transactions which have failed
+ *          - [5..8]  Cumulated bus busy time in us
+ */
+#define I2CM_BUS_USAGE_RECORD_SIZE                          9
+
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum I2CM_tenuStatus
+{
+  I2CM_eSTATUS_OK                                           = 0,
+  I2CM_eSTATUS_NO_OK,
+  I2CM_eSTATUS_INVALID_I2C_ID,
+  I2CM_eSTATUS_INVALID_SLAVE_ADDRESS,
+  I2CM_eSTATUS_NULL_POINTER,
+  I2CM_eSTATUS_EMPTY_BUFFER,
+  I2CM_eSTATUS_NO_ACKED,
+  I2CM_eSTATUS_START_TIMEOUT,
+  I2CM_eSTATUS_ADDRESS_TIMEOUT,
+  I2CM_eSTATUS_DATA_TIMEOUT,
+  I2CM_eSTATUS_STOP_TIMEOUT,
+  I2CM_eSTATUS_BUS_STUCK,
+  I2CM_eSTATUS_INVALID_BUS_SPEED,
+  I2CM_eSTATUS_COUNT
+}I2CM_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to list all I2C instances (not used here, only the the standardization syntax)
+ */
+typedef enum I2CM_tenuI2cId
+{
+  I2CM_I2C_ID0                                              = 0,
+  I2CM_I2C_ID_COUNT
+}I2CM_tenuI2cId;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to report the health counters of an I2C instance
+ */
+typedef struct I2CM_tstrStatistics
+{
+  uint16_t                                                  u16TimeoutCount;          //!< Number of bus phases which have timed out
+  uint16_t                                                  u16RecoveryCount;         //!< Number of bus recovery sequences performed
+  uint16_t                                                  u16RecoveryFailureCount;  //!< Number of recoveries which could not release SDA
+  uint16_t                                                  u16TraceDropCount;        //!< Number of traced transactions overwritten before their export
+}I2CM_tstrStatistics;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to give the direction of a traced transaction
+ */
+typedef enum I2CM_tenuTraceDirection
+{
+  I2CM_eTRACE_WRITE                                         = 0,
+  I2CM_eTRACE_READ,
+  I2CM_eTRACE_COUNT
+}I2CM_tenuTraceDirection;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Initialise the I2C Bus
+ * @details Each instance is clocked at its configured speed (see "I2CM_CONFIG_I2Cx_SPEED_HZ" in I2CM_cfg.h)
+ */
+void I2CM_vidInitalize();
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send data to the I2C bus
+ * @param kenuI2cId: ID of the I2C instance
+ * @param ku8I2cSlaveAddress: I2C slave address
+ * @param kpku8Buffer: Pointer to the buffer which contains the data to be send
+ * @param ku16BufferSize: Size of the buffer
+ * @return 0 if the function ran successfully, other value in case of any error
+ * @remark Each bus phase is bounded by a timeout, on timeout the bus is recovered before returning
+ */
+I2CM_tenuStatus I2CM_enuWriteBuffer(const I2CM_tenuI2cId kenuI2cId,
+                                        const uint8_t ku8I2cSlaveAddress,
+                                        uint8_t const * const kpku8Buffer,
+                                        const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send data to the I2C bus and to reveive a data
+ * @details The write and the read phases are chained with a repeated START (Sr) in a single transaction, thus the
+ *          slave sees an atomic register read
+ * @param kenuI2cId: ID of the I2C instance
+ * @param ku8I2cSlaveAddress: I2C slave address
+ * @param kpku8TxBuffer: Pointer to the Tx buffer which contains the data to be send
+ * @param ku16TxBufferSize: Size of the Tx buffer
+ * @param kpu8RxBuffer Pointer to the buffer used to contain the received data
+ * @param ku16RxBufferSize Size of the Rx buffer
+ * @return 0 if the function ran successfully, other value in case of any error
+ * @remark Each bus phase is bounded by a timeout, on timeout the bus is recovered before returning
+ */
+I2CM_tenuStatus I2CM_enuReadBuffer(const I2CM_tenuI2cId kenuI2cId,
+                                       const uint8_t ku8I2cSlaveAddress,
+                                       uint8_t const * const kpku8TxBuffer,
+                                       const uint16_t ku16TxBufferSize,
+                                       uint8_t * const kpu8RxBuffer,
+                                       const uint16_t ku16RxBufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the timeout and recovery counters of an I2C instance
+ * @param kenuI2cId: ID of the I2C instance
+ * @param kpstrStatistics: Pointer to the structure to be filled
+ * @return 0 if the function ran successfully, other value in case of any error
+ */
+I2CM_tenuStatus I2CM_enuGetStatistics(const I2CM_tenuI2cId kenuI2cId, I2CM_tstrStatistics * const kpstrStatistics);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the SCL frequency of an I2C instance at runtime (e.g. before talking to a slave
+ *        which does not support the configured speed)
+ * @details The baud rate divider is rounded so that the obtained frequency is never above the requested one (see
+ *          @ref I2CM_enuGetBusSpeed)
+ * @param kenuI2cId: ID of the I2C instance
+ * @param ku32BusSpeedHz: The wanted SCL frequency in Hz (up to 1 MHz, Fast-mode Plus)
+ * @return 0 if the function ran successfully, other value in case of any error
+ * @attention This function shall not be called while a transaction is ongoing
+ */
+I2CM_tenuStatus I2CM_enuSetBusSpeed(const I2CM_tenuI2cId kenuI2cId, const uint32_t ku32BusSpeedHz);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the SCL frequency really applied on an I2C instance
+ * @param kenuI2cId: ID of the I2C instance
+ * @param kpu32BusSpeedHz: Pointer to the variable used to store the frequency in Hz
+ * @return 0 if the function ran successfully, other value in case of any error
+ */
+I2CM_tenuStatus I2CM_enuGetBusSpeed(const I2CM_tenuI2cId kenuI2cId, uint32_t * const kpu32BusSpeedHz);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(I2CM_CONFIG_ENABLE_TRACE == true)
+/**
+ * @brief Function used to export the traced transactions, the oldest first
+ * @details The exported records are removed from the tracer ring, see @ref I2CM_TRACE_RECORD_SIZE for their format
+ * @param kpu8Buffer: Pointer to the buffer used to store the records
+ * @param ku16BufferSize: Size of the buffer, only complete records are written
+ * @return The number of bytes written in the buffer
+ */
+uint16_t I2CM_u16ExportTrace(uint8_t * const kpu8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the bus busy time aggregated per slave address
+ * @details See @ref I2CM_BUS_USAGE_RECORD_SIZE for the format of the records, the counters are not reset
+ * @param kpu8Buffer: Pointer to the buffer used to store the records
+ * @param ku16BufferSize: Size of the buffer, only complete records are written
+ * @return The number of bytes written in the buffer
+ */
+uint16_t I2CM_u16ExportBusUsage(uint8_t * const kpu8Buffer, const uint16_t ku16BufferSize);
+#endif //I2CM_CONFIG_ENABLE_TRACE
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* I2CM_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -75,8 +75,10 @@ typedef enum ISR_tenuPeripheral
   /*-----------------------------*/
 
   ISR_ePERIPHERAL_TIMER,
+  ISR_ePERIPHERAL_TIMER1,
   ISR_ePERIPHERAL_EUSART,
   ISR_ePERIPHERAL_INPUT_GPIO,
+  ISR_ePERIPHERAL_ADC,
 
   /*-----[ DO NOT EDIT THIS ]----*/
   ISR_ePERIPHERAL_END /*---------*/
@@ -0,0 +1,123 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      NVM.c
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     NVM Hardware core part
+ * @details   Module in charge of the access to the data EEPROM
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "NVM.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Region of the NVM selected by NVMREG: data EEPROM (see "PIC18F47Q10 - Datasheet", NVMCON1 register)
+ */
+#define NVM_REGION_DATA_EEPROM                              0b00
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Unlock sequence written in NVMCON2 before setting WR
+ */
+#define NVM_UNLOCK_KEY_1                                    0x55
+#define NVM_UNLOCK_KEY_2                                    0xAA
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void NVM_vidInitialize(void)
+{
+  NVMCON1bits.WREN   = false;
+  NVMCON1bits.NVMREG = NVM_REGION_DATA_EEPROM;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool NVM_bReadEeprom(const uint16_t ku16Address, uint8_t * const kpu8Data)
+{
+  bool bStatus = false;
+
+  if((kpu8Data != NULL) && (ku16Address < NVM_EEPROM_SIZE) && (NVMCON1bits.WR == false))
+  {
+    NVMADRH            = (uint8_t)(ku16Address >> 8);
+    NVMADRL            = (uint8_t)ku16Address;
+    NVMCON1bits.NVMREG = NVM_REGION_DATA_EEPROM;
+    NVMCON1bits.RD     = true;                    // The data is available in NVMDAT at the next instruction
+
+    *kpu8Data = NVMDAT;
+    bStatus   = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool NVM_bStartEepromWrite(const uint16_t ku16Address, const uint8_t ku8Data)
+{
+  bool bStatus            = false;
+  bool bInterruptsEnabled = false;
+
+  if((ku16Address < NVM_EEPROM_SIZE) && (NVMCON1bits.WR == false))
+  {
+    NVMADRH            = (uint8_t)(ku16Address >> 8);
+    NVMADRL            = (uint8_t)ku16Address;
+    NVMDAT             = ku8Data;
+    NVMCON1bits.NVMREG = NVM_REGION_DATA_EEPROM;
+    NVMCON1bits.WREN   = true;
+
+    // The unlock sequence shall not be interrupted:
+    bInterruptsEnabled = INTCONbits.GIE;
+    INTCONbits.GIE     = false;
+    NVMCON2            = NVM_UNLOCK_KEY_1;
+    NVMCON2            = NVM_UNLOCK_KEY_2;
+    NVMCON1bits.WR     = true;
+    INTCONbits.GIE     = bInterruptsEnabled;
+
+    bStatus = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool NVM_bIsBusy(void)
+{
+  bool bIsBusy = true;
+
+  if(NVMCON1bits.WR == false)
+  {
+    NVMCON1bits.WREN = false;
+    bIsBusy          = false;
+  }
+
+  return bIsBusy;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,86 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      NVM.h
+ *
+ * @author    Jean DEBAINS
+ * @date      Wednesday, January 31, 2024.
+ *
+ * @version   0.0.0
+ *
+ * @brief     NVM Hardware core part
+ * @details   Module in charge of the access to the data EEPROM. The writes are not blocking: a byte write is started
+ *            and its end is polled, the CPU keeps running during the self-timed write (about 4 ms)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef NVM_H_
+#define NVM_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of the data EEPROM in bytes (see "PIC18F47Q10 - Datasheet", Memory Organization)
+ */
+#define NVM_EEPROM_SIZE                                     1024U
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Initialize the NVM controller: the data EEPROM is selected and the writes are disabled
+ */
+void NVM_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read a byte of the data EEPROM
+ * @param[in] ku16Address: The address of the byte, lower than @ref NVM_EEPROM_SIZE
+ * @param[out]   kpu8Data: The read byte
+ * @return Return "true" if the function ran successfully, return "false" otherwise (NULL pointer, wrong address or
+ *         write in progress)
+ */
+bool NVM_bReadEeprom(const uint16_t ku16Address, uint8_t * const kpu8Data);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to start the write of a byte of the data EEPROM
+ * @details - 1) Load the address and the data (see "PIC18F47Q10 - Datasheet", NVMADR and NVMDAT registers)
+ *          - 2) Run the unlock sequence with the interrupts disabled, then start the self-timed erase and write
+ *          - 3) Return without waiting, the end is polled with @ref NVM_bIsBusy
+ * @param[in] ku16Address: The address of the byte, lower than @ref NVM_EEPROM_SIZE
+ * @param[in]     ku8Data: The byte to write
+ * @return Return "true" if the write is started, return "false" otherwise (wrong address or write in progress)
+ */
+bool NVM_bStartEepromWrite(const uint16_t ku16Address, const uint8_t ku8Data);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to know if a write is in progress, the writes are disabled again at its end
+ * @return Return "true" if a write is in progress, return "false" otherwise
+ */
+bool NVM_bIsBusy(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* NVM_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
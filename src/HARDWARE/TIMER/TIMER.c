@@ -35,7 +35,59 @@
 /**********************************************************************************************************************/
 /* CONSTANTS, MACROS                                                                                                  */
 /**********************************************************************************************************************/
+/**
+ * @brief Clock source of TIM1: Fosc/4 (see "PIC18F47Q10 - Datasheet", P.321, T1CLK)
+ */
+#define TIM1_CLOCK_SOURCE_FOSC_DIV4                         0b0001
+
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Prescaler of TIM1 (T1CKPS value, the prescaler is 2^T1CKPS) giving a tick of 1 us
+ */
+#if(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_04MHZ)
+#  define TIM1_PRESCALER                                    0b00
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_08MHZ)
+#  define TIM1_PRESCALER                                    0b01
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_16MHZ)
+#  define TIM1_PRESCALER                                    0b10
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_32MHZ)
+#  define TIM1_PRESCALER                                    0b11
+#else
+#  error "[TIM ] Error: The timebase TIM1 cannot have a 1 us tick with the configured Fosc"
+#endif //CLOCK_CONFIG_FOSC_FREQUENCY_MHZ
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Counter values of TIM1 considered as just wrapped when the overflow flag is still pending (half of the range,
+ *        far longer than the read of the timebase)
+ */
+#define TIM1_WRAPPED_COUNTER_LIMIT                          0x8000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// Settings of TIM2 (see "PIC18F47Q10 - Datasheet", T2CLKCON, T2HLT and T2CON registers):
+#define TIM2_CLOCK_SOURCE_FOSC_DIV4                         0b0001
+#define TIM2_POSTSCALER_16                                  0b1111
+#define TIM2_MODE_FREE_RUNNING_SOFTWARE_GATE                0b00000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Prescaler of TIM2 (T2CKPS value, the prescaler is 2^T2CKPS) giving a tick of 16 us
+ */
+#if(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_04MHZ)
+#  define TIM2_PRESCALER                                    0b100
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_08MHZ)
+#  define TIM2_PRESCALER                                    0b101
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_16MHZ)
+#  define TIM2_PRESCALER                                    0b110
+#elif(CLOCK_CONFIG_FOSC_FREQUENCY_MHZ == CLOCK_FOSC_FREQUENCY_32MHZ)
+#  define TIM2_PRESCALER                                    0b111
+#else
+#  error "[TIM ] Error: The trigger TIM2 cannot have a 16 us tick with the configured Fosc"
+#endif //CLOCK_CONFIG_FOSC_FREQUENCY_MHZ
 
 
 /**********************************************************************************************************************/
@@ -53,6 +105,13 @@
 static TIM0_tpfvidRxCallback TIM0_pfRxCallback              = NULL;
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Number of overflows of TIM1, used as the 16 MSB of the timebase
+ */
+static volatile uint16_t TIM1_u16OverflowCount              = 0;
+
+
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
 /**********************************************************************************************************************/
@@ -64,6 +123,13 @@ static TIM0_tpfvidRxCallback TIM0_pfRxCallback              = NULL;
 static bool bInterruptHandler(void);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Callback function registered to the interrupt module to extend the TIM1 counter on its overflow
+ */
+static bool bTim1InterruptHandler(void);
+
+
 /**********************************************************************************************************************/
 /* PRIVATE FUNCTION DEFINITIONS                                                                                       */
 /**********************************************************************************************************************/
@@ -95,6 +161,23 @@ static bool bInterruptHandler(void)
 }
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bTim1InterruptHandler(void)
+{
+  bool bIsIsrFound = false;
+
+  if((PIE4bits.TMR1IE == 1) && (PIR4bits.TMR1IF == 1))
+  {
+    bIsIsrFound     = true;
+    PIR4bits.TMR1IF = 0;
+
+    TIM1_u16OverflowCount++;
+  }
+
+  return bIsIsrFound;
+}
+
+
 /**********************************************************************************************************************/
 /* PUBLIC FUNCTION DEFINITIONS                                                                                        */
 /**********************************************************************************************************************/
@@ -188,4 +271,95 @@ bool TIM0_bStop(void)
 }
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TIM1_vidInitialize(void)
+{
+  bool bStatus = false;
+
+  // - 1) Clock the timer with Fosc/4, 16 Bits read/write in one operation, no gate:
+  T1CONbits.ON    = 0;
+  T1CLK           = TIM1_CLOCK_SOURCE_FOSC_DIV4;
+  T1CONbits.CKPS  = TIM1_PRESCALER;
+  T1CONbits.RD16  = 1;
+  T1GCONbits.GE   = 0;
+  TMR1H           = 0x00;
+  TMR1L           = 0x00;
+
+  // - 2) Extend the counter to 32 Bits with the overflow interruption:
+  TIM1_u16OverflowCount = 0;
+  PIR4bits.TMR1IF       = 0;
+  PIE4bits.TMR1IE       = 1;
+
+  // - 3) Connects the module to the interruption manager:
+  bStatus = ISR_bRegisterIsrCbk(ISR_ePERIPHERAL_TIMER1, bTim1InterruptHandler);
+  CMN_assert(bStatus == true);
+
+  T1CONbits.ON = 1;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint32_t TIM1_u32GetTimestampUs(void)
+{
+  uint16_t u16OverflowCount = 0;
+  uint16_t u16Counter       = 0;
+  bool     bOverflowPending = false;
+
+  // The overflow count is read again until it was not changed by the ISR while the counter was read:
+  do
+  {
+    u16OverflowCount = TIM1_u16OverflowCount;
+    u16Counter       = TMR1L;                     // Reading TMR1L latches TMR1H (RD16 mode)
+    u16Counter      |= ((uint16_t)TMR1H << 8);
+    bOverflowPending = (PIR4bits.TMR1IF == 1);    // Read after the counter
+  }
+  while(u16OverflowCount != TIM1_u16OverflowCount);
+
+  // An overflow not counted yet by the ISR (interruptions masked, e.g. when called from an ISR): it is counted here if
+  // the counter read has already wrapped, not if the overflow occurred just after the counter was read
+  if((bOverflowPending == true) && (u16Counter < TIM1_WRAPPED_COUNTER_LIMIT))
+  {
+    u16OverflowCount++;
+  }
+
+  return (((uint32_t)u16OverflowCount << 16) | u16Counter);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool TIM2_bStartTrigger(const uint32_t ku32PeriodUs)
+{
+  bool bStatus = false;
+
+  if((ku32PeriodUs >= TIM2_TRIGGER_MIN_PERIOD_US) && (ku32PeriodUs <= TIM2_TRIGGER_MAX_PERIOD_US))
+  {
+    // - 1) Clock the timer with Fosc/4, a tick of 16 us and a postscaler of 16:
+    T2CONbits.ON     = 0;
+    T2CLKCON         = TIM2_CLOCK_SOURCE_FOSC_DIV4;
+    T2HLTbits.MODE   = TIM2_MODE_FREE_RUNNING_SOFTWARE_GATE;
+    T2CONbits.CKPS   = TIM2_PRESCALER;
+    T2CONbits.OUTPS  = TIM2_POSTSCALER_16;
+
+    // - 2) The timer counts from 0 to T2PR included:
+    T2TMR            = 0x00;
+    T2PR             = (uint8_t)(((ku32PeriodUs + (TIM2_TRIGGER_RESOLUTION_US / 2)) / TIM2_TRIGGER_RESOLUTION_US) - 1);
+
+    // - 3) No interruption, the postscaled output triggers the peripheral:
+    PIE4bits.TMR2IE  = 0;
+    T2CONbits.ON     = 1;
+
+    bStatus = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void TIM2_vidStopTrigger(void)
+{
+  T2CONbits.ON = 0;
+}
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
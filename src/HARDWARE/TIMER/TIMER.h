@@ -12,7 +12,8 @@
  * @version   0.0.0
  *
  * @brief     TIMER Hardware core part
- * @details   Module in charge of the management of the TIM1 peripheral
+ * @details   Module in charge of the management of the TIM0 (periodic callback) and TIM1 (free-running timebase)
+ *            peripherals
  *
  * @remark    Coding Language: C
  *
@@ -33,8 +34,19 @@
 /**********************************************************************************************************************/
 /* CONSTANTS, MACROS                                                                                                  */
 /**********************************************************************************************************************/
+/**
+ * @brief Resolution of the period of the TIM2 hardware trigger (see @ref TIM2_bStartTrigger)
+ */
+#define TIM2_TRIGGER_RESOLUTION_US                          256UL
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Limits of the period of the TIM2 hardware trigger (8 Bits period register)
+ */
+#define TIM2_TRIGGER_MIN_PERIOD_US                          (TIM2_TRIGGER_RESOLUTION_US)
+#define TIM2_TRIGGER_MAX_PERIOD_US                          (TIM2_TRIGGER_RESOLUTION_US * 256UL)
+
 
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
@@ -183,6 +195,50 @@ bool TIM0_bStart(const TIM0_tenuClkSrc kenuClockSrc,
 bool TIM0_bStop(void);
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Initialize and start the timer TIM1 as a free-running timebase
+ * @details - 1) Clock the timer with Fosc/4 and a prescaler giving a tick of 1 us (see "PIC18F47Q10 -
+ *               Datasheet", P.310, 19.1)
+ *          - 2) Extend the 16 Bits counter to 32 Bits with the overflow interruption
+ *          - 3) Connects the module to the interruption manager
+ */
+void TIM1_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the current value of the free-running timebase
+ * @details The value wraps around after 2^32 us (about 71 minutes), durations shall be computed with an unsigned
+ *          subtraction. The function can be called with the interruptions masked (from an ISR): an overflow whose
+ *          interruption is pending is taken into account
+ * @return Return the time elapsed since the call of @ref TIM1_vidInitialize in us
+ */
+uint32_t TIM1_u32GetTimestampUs(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to start the timer TIM2 as a periodic hardware trigger of the other peripherals (for example
+ *        the auto-conversion trigger of the ADC)
+ * @details - 1) Clock the timer with Fosc/4 and a prescaler giving a tick of 16 us, the postscaler divides it by 16
+ *               (see "PIC18F47Q10 - Datasheet", Timer2/4/6 module)
+ *          - 2) Set the period register, the postscaled output is the trigger
+ *          - 3) No interruption is used, the triggered peripheral handles its own one
+ * @param[in] ku32PeriodUs: The trigger period in us, rounded to @ref TIM2_TRIGGER_RESOLUTION_US (from
+ *                          @ref TIM2_TRIGGER_MIN_PERIOD_US to @ref TIM2_TRIGGER_MAX_PERIOD_US)
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool TIM2_bStartTrigger(const uint32_t ku32PeriodUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to stop the timer TIM2
+ */
+void TIM2_vidStopTrigger(void);
+
+
 /*--------------------------------------------------------------------------------------------------------------------*/
 #endif /* TIMER_H_ */
 /*--------------------------------------------------------------------------------------------------------------------*/
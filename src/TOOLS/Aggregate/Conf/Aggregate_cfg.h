@@ -0,0 +1,56 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Aggregate_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Aggregate Tools conf part
+ * @details   Module in charge of the multi-resolution history of the samples (minute, hour and day buckets)
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef AGGREGATE_CFG_H_
+#define AGGREGATE_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the number of closed buckets kept for each level (1 to 255), the oldest ones are overwritten
+ * @remark Each bucket takes @ref AGG_BUCKET_RAM_SIZE bytes
+ */
+#define AGG_CONFIG_MINUTE_BUCKETS                           60
+#define AGG_CONFIG_HOUR_BUCKETS                             24
+#define AGG_CONFIG_DAY_BUCKETS                              7
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the RAM budget of the module in bytes, the build fails if the buckets do not fit in it
+ */
+#define AGG_CONFIG_RAM_BUDGET                               800
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* AGGREGATE_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,421 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Aggregate.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Aggregate Tools core part
+ * @details   Module in charge of the multi-resolution history of the samples (minute, hour and day buckets)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "TIMER.h"
+#include "Aggregate.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((AGG_CONFIG_MINUTE_BUCKETS < 1) || (AGG_CONFIG_MINUTE_BUCKETS > 255) || \
+    (AGG_CONFIG_HOUR_BUCKETS < 1)   || (AGG_CONFIG_HOUR_BUCKETS > 255)   || \
+    (AGG_CONFIG_DAY_BUCKETS < 1)    || (AGG_CONFIG_DAY_BUCKETS > 255))
+#  error "[AGG ] Error: The number of buckets of each level must be between 1 and 255"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief RAM used by the module: the closed buckets, the running bucket and the ring indexes of the 3 levels (19 bytes
+ *        each) and the timebase (8 bytes)
+ */
+#define AGG_BUCKET_COUNT                                    (AGG_CONFIG_MINUTE_BUCKETS + AGG_CONFIG_HOUR_BUCKETS + \
+                                                             AGG_CONFIG_DAY_BUCKETS)
+#define AGG_RAM_SIZE                                        ((AGG_BUCKET_COUNT * AGG_BUCKET_RAM_SIZE) + (3 * 19) + 8)
+
+#if(AGG_RAM_SIZE > AGG_CONFIG_RAM_BUDGET)
+#  error "[AGG ] Error: The buckets do not fit in AGG_CONFIG_RAM_BUDGET"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Duration of a minute bucket in us and number of children of the coarser buckets
+ */
+#define AGG_MINUTE_US                                       60000000UL
+#define AGG_MINUTES_PER_HOUR                                60
+#define AGG_HOURS_PER_DAY                                   24
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Structure of the configuration of a level: its ring in the buckets storage and the number of finer buckets
+ *        rolled up in one of its buckets (unused by the minutes, closed by the time)
+ */
+typedef struct AGG_tstrLevelConfig
+{
+  uint16_t                                                  u16Offset;
+  uint8_t                                                   u8Length;
+  uint8_t                                                   u8ChildrenPerBucket;
+}AGG_tstrLevelConfig;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure of the running bucket of a level
+ */
+typedef struct AGG_tstrRunningBucket
+{
+  int16_t                                                   s16Min;
+  int16_t                                                   s16Max;
+  int64_t                                                   s64Sum;                   //!< Sum of the samples of the bucket
+  uint32_t                                                  u32Count;                 //!< Samples of the bucket
+  uint8_t                                                   u8Children;               //!< Closed children, empty or not
+}AGG_tstrRunningBucket;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Configuration of the levels, in the order of AGG_tenuLevel
+ */
+static const AGG_tstrLevelConfig AGG_kastrLevelConfigs[AGG_eLEVEL_END] =
+{
+  {0,                                                   AGG_CONFIG_MINUTE_BUCKETS, 0},
+  {AGG_CONFIG_MINUTE_BUCKETS,                           AGG_CONFIG_HOUR_BUCKETS,   AGG_MINUTES_PER_HOUR},
+  {AGG_CONFIG_MINUTE_BUCKETS + AGG_CONFIG_HOUR_BUCKETS, AGG_CONFIG_DAY_BUCKETS,    AGG_HOURS_PER_DAY},
+};
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The closed buckets, one ring per level (see AGG_kastrLevelConfigs)
+ */
+static AGG_tstrBucket AGG_astrBuckets[AGG_BUCKET_COUNT];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The running bucket, the next slot and the number of stored buckets of each level
+ */
+static AGG_tstrRunningBucket AGG_astrRunningBuckets[AGG_eLEVEL_END];
+static uint8_t               AGG_au8NextIndexes[AGG_eLEVEL_END];
+static uint8_t               AGG_au8StoredCounts[AGG_eLEVEL_END];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Timebase of the minutes: last reading of TIM1 and time elapsed in the running minute
+ */
+static uint32_t AGG_u32LastTimestampUs                      = 0;
+static uint32_t AGG_u32MinuteElapsedUs                      = 0;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to close the minutes elapsed since the last call
+ */
+static void vidAdvanceTime(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to close the running minute and to roll it up, as well as the coarser buckets which are complete
+ * @details The loop stops at the first level which is not complete, thus at most one closing per level
+ */
+static void vidCloseMinute(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to store the running bucket of a level in its ring and to restart it
+ */
+static void vidStoreBucket(const AGG_tenuLevel kenuLevel);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the index of a stored bucket in AGG_astrBuckets
+ */
+static uint16_t u16GetBucketIndex(const AGG_tenuLevel kenuLevel, const uint8_t ku8Age);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static void vidAdvanceTime(void)
+{
+  const uint32_t ku32NowUs = TIM1_u32GetTimestampUs();
+
+  AGG_u32MinuteElapsedUs += (ku32NowUs - AGG_u32LastTimestampUs);
+  AGG_u32LastTimestampUs  = ku32NowUs;
+
+  while(AGG_u32MinuteElapsedUs >= AGG_MINUTE_US)
+  {
+    AGG_u32MinuteElapsedUs -= AGG_MINUTE_US;
+    vidCloseMinute();
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidCloseMinute(void)
+{
+  AGG_tenuLevel           enuLevel   = AGG_eLEVEL_MINUTE;
+  AGG_tstrRunningBucket * pstrChild  = NULL;
+  AGG_tstrRunningBucket * pstrParent = NULL;
+  bool                    bIsOver    = false;
+
+  while(bIsOver == false)
+  {
+    pstrChild = &AGG_astrRunningBuckets[enuLevel];
+
+    if((enuLevel + 1) < AGG_eLEVEL_END)
+    {
+      // The bucket rolls up in the running bucket of the coarser level before being restarted, the sum and the count
+      // of its samples are carried so the coarser mean is weighted by the samples:
+      pstrParent = &AGG_astrRunningBuckets[enuLevel + 1];
+
+      if(pstrChild->u32Count > 0)
+      {
+        if((pstrParent->u32Count == 0) || (pstrChild->s16Min < pstrParent->s16Min))
+        {
+          pstrParent->s16Min = pstrChild->s16Min;
+        }
+
+        if((pstrParent->u32Count == 0) || (pstrChild->s16Max > pstrParent->s16Max))
+        {
+          pstrParent->s16Max = pstrChild->s16Max;
+        }
+
+        pstrParent->s64Sum   += pstrChild->s64Sum;
+        pstrParent->u32Count += pstrChild->u32Count;
+      }
+
+      pstrParent->u8Children++;
+    }
+
+    vidStoreBucket(enuLevel);
+
+    if(((enuLevel + 1) < AGG_eLEVEL_END) &&
+       (AGG_astrRunningBuckets[enuLevel + 1].u8Children >= AGG_kastrLevelConfigs[enuLevel + 1].u8ChildrenPerBucket))
+    {
+      enuLevel++;
+    }
+    else
+    {
+      bIsOver = true;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidStoreBucket(const AGG_tenuLevel kenuLevel)
+{
+  AGG_tstrRunningBucket * const kpstrRunning = &AGG_astrRunningBuckets[kenuLevel];
+  AGG_tstrLevelConfig const * const kpkstrConfig = &AGG_kastrLevelConfigs[kenuLevel];
+  AGG_tstrBucket                strBucket    = {0, 0, 0, 0};
+  const int64_t                 ks64Count    = kpstrRunning->u32Count;
+
+  if(ks64Count > 0)
+  {
+    strBucket.s16Min   = kpstrRunning->s16Min;
+    strBucket.s16Max   = kpstrRunning->s16Max;
+    strBucket.u16Count = (kpstrRunning->u32Count > UINT16_MAX) ? UINT16_MAX : (uint16_t)kpstrRunning->u32Count;
+
+    // Mean rounded half away from zero:
+    strBucket.s16Mean = (int16_t)((kpstrRunning->s64Sum >= 0) ? ((kpstrRunning->s64Sum + (ks64Count / 2)) / ks64Count) :
+                                                               ((kpstrRunning->s64Sum - (ks64Count / 2)) / ks64Count));
+  }
+
+  AGG_astrBuckets[kpkstrConfig->u16Offset + AGG_au8NextIndexes[kenuLevel]] = strBucket;
+
+  AGG_au8NextIndexes[kenuLevel]++;
+
+  if(AGG_au8NextIndexes[kenuLevel] >= kpkstrConfig->u8Length)
+  {
+    AGG_au8NextIndexes[kenuLevel] = 0;
+  }
+
+  if(AGG_au8StoredCounts[kenuLevel] < kpkstrConfig->u8Length)
+  {
+    AGG_au8StoredCounts[kenuLevel]++;
+  }
+
+  kpstrRunning->s64Sum     = 0;
+  kpstrRunning->u32Count   = 0;
+  kpstrRunning->u8Children = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint16_t u16GetBucketIndex(const AGG_tenuLevel kenuLevel, const uint8_t ku8Age)
+{
+  AGG_tstrLevelConfig const * const kpkstrConfig = &AGG_kastrLevelConfigs[kenuLevel];
+  uint16_t                          u16Index     = 0;
+
+  // The latest bucket is just before the next slot (ku8Age is lower than the stored count, thus than the length):
+  u16Index = (uint16_t)AGG_au8NextIndexes[kenuLevel] + kpkstrConfig->u8Length - 1 - ku8Age;
+
+  if(u16Index >= kpkstrConfig->u8Length)
+  {
+    u16Index -= kpkstrConfig->u8Length;
+  }
+
+  return (uint16_t)(kpkstrConfig->u16Offset + u16Index);
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void AGG_vidInitialize(void)
+{
+  AGG_tenuLevel enuLevel = AGG_eLEVEL_MINUTE;
+
+  for(enuLevel = AGG_eLEVEL_MINUTE; enuLevel < AGG_eLEVEL_END; enuLevel++)
+  {
+    AGG_astrRunningBuckets[enuLevel].s64Sum     = 0;
+    AGG_astrRunningBuckets[enuLevel].u32Count   = 0;
+    AGG_astrRunningBuckets[enuLevel].u8Children = 0;
+    AGG_au8NextIndexes[enuLevel]                = 0;
+    AGG_au8StoredCounts[enuLevel]               = 0;
+  }
+
+  AGG_u32LastTimestampUs = TIM1_u32GetTimestampUs();
+  AGG_u32MinuteElapsedUs = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void AGG_vidPushSample(const int16_t ks16Value)
+{
+  AGG_tstrRunningBucket * const kpstrMinute = &AGG_astrRunningBuckets[AGG_eLEVEL_MINUTE];
+
+  // The elapsed minutes are closed first, so the sample goes in the right one:
+  vidAdvanceTime();
+
+  // The count saturates (more than 1000 samples per second), the extra samples are ignored:
+  if(kpstrMinute->u32Count < UINT16_MAX)
+  {
+    if((kpstrMinute->u32Count == 0) || (ks16Value < kpstrMinute->s16Min))
+    {
+      kpstrMinute->s16Min = ks16Value;
+    }
+
+    if((kpstrMinute->u32Count == 0) || (ks16Value > kpstrMinute->s16Max))
+    {
+      kpstrMinute->s16Max = ks16Value;
+    }
+
+    kpstrMinute->s64Sum += ks16Value;
+    kpstrMinute->u32Count++;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void AGG_vidProcess(void)
+{
+  vidAdvanceTime();
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t AGG_u8GetBucketCount(const AGG_tenuLevel kenuLevel)
+{
+  uint8_t u8Count = 0;
+
+  if((kenuLevel > AGG_eLEVEL_BEGIN) && (kenuLevel < AGG_eLEVEL_END))
+  {
+    u8Count = AGG_au8StoredCounts[kenuLevel];
+  }
+
+  return u8Count;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+AGG_tenuStatus AGG_enuGetBucket(const AGG_tenuLevel kenuLevel, const uint8_t ku8Age, AGG_tstrBucket * const kpstrBucket)
+{
+  AGG_tenuStatus enuStatus = AGG_eSTATUS_NO_OK;
+
+  if(kpstrBucket == NULL)
+  {
+    enuStatus = AGG_eSTATUS_NULL_POINTER;
+  }
+  else if((kenuLevel <= AGG_eLEVEL_BEGIN) || (kenuLevel >= AGG_eLEVEL_END))
+  {
+    enuStatus = AGG_eSTATUS_INVALID_LEVEL;
+  }
+  else if(ku8Age >= AGG_au8StoredCounts[kenuLevel])
+  {
+    enuStatus = AGG_eSTATUS_NO_BUCKET;
+  }
+  else
+  {
+    *kpstrBucket = AGG_astrBuckets[u16GetBucketIndex(kenuLevel, ku8Age)];
+    enuStatus    = AGG_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t AGG_u8ExportBuckets(const AGG_tenuLevel kenuLevel,
+                            const uint8_t ku8FirstAge,
+                            uint8_t * const kpu8Buffer,
+                            const uint8_t ku8BufferSize)
+{
+  uint8_t        u8Size    = 0;
+  uint8_t        u8Age     = ku8FirstAge;
+  AGG_tstrBucket strBucket;
+
+  if(kpu8Buffer != NULL)
+  {
+    while(((ku8BufferSize - u8Size) >= AGG_RECORD_SIZE) &&
+          (AGG_enuGetBucket(kenuLevel, u8Age, &strBucket) == AGG_eSTATUS_OK))
+    {
+      kpu8Buffer[u8Size]     = (uint8_t)strBucket.s16Min;
+      kpu8Buffer[u8Size + 1] = (uint8_t)((uint16_t)strBucket.s16Min >> 8);
+      kpu8Buffer[u8Size + 2] = (uint8_t)strBucket.s16Max;
+      kpu8Buffer[u8Size + 3] = (uint8_t)((uint16_t)strBucket.s16Max >> 8);
+      kpu8Buffer[u8Size + 4] = (uint8_t)strBucket.s16Mean;
+      kpu8Buffer[u8Size + 5] = (uint8_t)((uint16_t)strBucket.s16Mean >> 8);
+      kpu8Buffer[u8Size + 6] = (uint8_t)strBucket.u16Count;
+      kpu8Buffer[u8Size + 7] = (uint8_t)(strBucket.u16Count >> 8);
+
+      // No wrap of the age: it stays lower than the stored count (at most 255)
+      u8Size += AGG_RECORD_SIZE;
+      u8Age++;
+    }
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
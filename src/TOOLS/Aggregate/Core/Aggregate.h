@@ -0,0 +1,174 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Aggregate.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Aggregate Tools core part
+ * @details   Module in charge of the multi-resolution history of the samples in a constant memory: the samples roll up
+ *            into minute buckets, the minutes into hour buckets and the hours into day buckets. Each level keeps a
+ *            fixed ring of closed buckets (min, max, mean, count), the running bucket of each level is updated
+ *            incrementally thus the cost of a sample is constant and the cost of a closing is bounded by the number
+ *            of levels.
+ *            The sum and the count of the samples roll up with the buckets: the mean of an hour (resp. day) bucket is
+ *            the mean of all its samples, whatever the number of samples of each minute (resp. hour)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef AGGREGATE_H_
+#define AGGREGATE_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Aggregate_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of a bucket record exported by @ref AGG_u8ExportBuckets (all fields are little endian):
+ *          - [0..1]  Minimum (signed)
+ *          - [2..3]  Maximum (signed)
+ *          - [4..5]  Mean, rounded (signed)
+ *          - [6..7]  Count: samples of the bucket at every level, saturated to 65535 (0 = no sample, the other fields
+ *                    are then 0)
+ */
+#define AGG_RECORD_SIZE                                     8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief RAM size of a closed bucket (see @ref AGG_tstrBucket) used for the check of @ref AGG_CONFIG_RAM_BUDGET
+ */
+#define AGG_BUCKET_RAM_SIZE                                 8
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum AGG_tenuStatus
+{
+  AGG_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  AGG_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  AGG_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  AGG_eSTATUS_INVALID_LEVEL,                                      //!< The level is out of the list
+  AGG_eSTATUS_NO_BUCKET,                                          //!< The requested bucket is not stored
+  AGG_eSTATUS_COUNT                                               //!< The total number of return code
+}AGG_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to list the levels of the history, from the finest to the coarsest
+ */
+typedef enum AGG_tenuLevel
+{
+  /*-----[ DO NOT EDIT THIS ]----*/
+  AGG_eLEVEL_BEGIN = -1, /*------*/
+  /*-----------------------------*/
+
+  AGG_eLEVEL_MINUTE,
+  AGG_eLEVEL_HOUR,
+  AGG_eLEVEL_DAY,
+
+  /*-----[ DO NOT EDIT THIS ]----*/
+  AGG_eLEVEL_END /*--------------*/
+  /*-----------------------------*/
+}AGG_tenuLevel;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure of a closed bucket
+ */
+typedef struct AGG_tstrBucket
+{
+  int16_t                                                   s16Min;                   //!< Minimum of the bucket
+  int16_t                                                   s16Max;                   //!< Maximum of the bucket
+  int16_t                                                   s16Mean;                  //!< Rounded mean of the bucket
+  uint16_t                                                  u16Count;                 //!< See @ref AGG_RECORD_SIZE
+}AGG_tstrBucket;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the history (no bucket, the first minute starts now)
+ */
+void AGG_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to add a sample to the running minute
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe)
+ * @param[in] ks16Value: The value of the sample
+ */
+void AGG_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to close the elapsed buckets (the minutes without sample are closed empty)
+ * @remark The time is measured with TIM1, thus the function shall be called at least every 71 minutes (main loop)
+ */
+void AGG_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the number of closed buckets stored for a level
+ * @param[in] kenuLevel: The level
+ * @return The number of stored buckets (0 for an invalid level)
+ */
+uint8_t AGG_u8GetBucketCount(const AGG_tenuLevel kenuLevel);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read a closed bucket
+ * @param[in] kenuLevel: The level of the bucket
+ * @param[in]    ku8Age: The age of the bucket, 0 for the latest closed one
+ * @param[out] kpstrBucket: The bucket
+ * @return The status of the reading, @ref AGG_eSTATUS_NO_BUCKET if the bucket is not stored (or overwritten)
+ */
+AGG_tenuStatus AGG_enuGetBucket(const AGG_tenuLevel kenuLevel, const uint8_t ku8Age, AGG_tstrBucket * const kpstrBucket);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export closed buckets, from the given age to the older ones
+ * @details See @ref AGG_RECORD_SIZE for the format of the records
+ * @param[in] kenuLevel: The level of the buckets
+ * @param[in] ku8FirstAge: The age of the first exported bucket, 0 for the latest closed one
+ * @param kpu8Buffer: Pointer to the buffer used to store the records
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if there is no more bucket or if the level is invalid)
+ */
+uint8_t AGG_u8ExportBuckets(const AGG_tenuLevel kenuLevel,
+                            const uint8_t ku8FirstAge,
+                            uint8_t * const kpu8Buffer,
+                            const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // AGGREGATE_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,89 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Alarm_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Alarm Tools conf part
+ * @details   Module in charge of the evaluation of the alarms (thresholds and rate of change) on each filtered value
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef ALARM_CFG_H_
+#define ALARM_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the alarms enabled at the initialization (see @ref ALM_tenuAlarm), they can be changed at runtime
+ */
+#define ALM_CONFIG_DEFAULT_ALARMS                           ((1 << ALM_eALARM_HIGH) | (1 << ALM_eALARM_LOW) | \
+                                                             (1 << ALM_eALARM_RISE) | (1 << ALM_eALARM_FALL))
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default thresholds and their hysteresis, in 0.01 degC: an alarm is raised when the value reaches
+ *        its threshold and cleared when the value is back beyond the threshold minus the hysteresis
+ */
+#define ALM_CONFIG_DEFAULT_HIGH_THRESHOLD                   3500
+#define ALM_CONFIG_DEFAULT_LOW_THRESHOLD                    1000
+#define ALM_CONFIG_DEFAULT_HYSTERESIS                       50
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default rate of change which raises an alarm and its hysteresis, in 0.01 degC/min
+ */
+#define ALM_CONFIG_DEFAULT_RATE_LIMIT                       200
+#define ALM_CONFIG_DEFAULT_RATE_HYSTERESIS                  50
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default dwell time in s: the condition of an alarm shall last this time before it is raised
+ */
+#define ALM_CONFIG_DEFAULT_DWELL_TIME_S                     5
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the age in the history of the sample compared to the new one to compute the rate of change (see
+ *        HIS_enuGetSample), lower than HIS_CONFIG_CAPACITY: their span shall reach ALM_CONFIG_RATE_MIN_SPAN_MS at the
+ *        fastest period of the filtered value (12 s at 250 ms)
+ */
+#define ALM_CONFIG_RATE_SAMPLE_AGE                          48
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the minimal time between the 2 samples of the rate of change in ms: below it, the rate is not computed
+ *        (the quantization of the value would give a large rate)
+ */
+#define ALM_CONFIG_RATE_MIN_SPAN_MS                         10000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* ALARM_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,518 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Alarm.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Alarm Tools core part
+ * @details   Module in charge of the evaluation of the alarms (thresholds and rate of change) on each filtered value
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "TIMER.h"
+#include "History.h"
+#include "Alarm.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((ALM_CONFIG_RATE_SAMPLE_AGE < 1) || (ALM_CONFIG_RATE_SAMPLE_AGE >= HIS_CONFIG_CAPACITY))
+#  error "[ALM ] Error: The setting ALM_CONFIG_RATE_SAMPLE_AGE must be between 1 and HIS_CONFIG_CAPACITY - 1"
+#endif
+
+#if(ALM_CONFIG_DEFAULT_DWELL_TIME_S > ALM_MAX_DWELL_TIME_S)
+#  error "[ALM ] Error: The setting ALM_CONFIG_DEFAULT_DWELL_TIME_S is out of range"
+#endif
+
+#if(ALM_CONFIG_RATE_MIN_SPAN_MS < 10)
+#  error "[ALM ] Error: The setting ALM_CONFIG_RATE_MIN_SPAN_MS must be at least 10 ms"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Mask of the valid alarms
+ */
+#define ALM_ALARM_MASK_ALL                                  ((1 << ALM_eALARM_END) - 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief The rate is computed in 0.01 degC per minute from a span in 0.01 s (the product stays on 32 Bits)
+ */
+#define ALM_US_PER_CENTISECOND                              10000UL
+#define ALM_CENTISECONDS_PER_MINUTE                         6000L
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macro used to get the bit of an alarm in the masks
+ */
+#define ALM_mALARM_BIT(_ALARM_)                             ((uint8_t)(1 << (_ALARM_)))
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Runtime settings of the alarms
+ */
+static ALM_tstrSettings ALM_strSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Consumer of the alarm changes
+ */
+static ALM_tpfvidEventCallback ALM_pfEventCallback          = NULL;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the alarms: the raised ones, the ones whose condition is met during the dwell time and the start of
+ *        their condition (see TIM1_u32GetTimestampUs)
+ */
+static uint8_t  ALM_u8ActiveMask                            = 0;
+static uint8_t  ALM_u8PendingMask                           = 0;
+static uint32_t ALM_au32PendingSinceUs[ALM_eALARM_END];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Result of the latest evaluation: the changed alarms, the value and its rate of change
+ */
+static uint8_t  ALM_u8ChangedMask                           = 0;
+static int16_t  ALM_s16LatestValue                          = 0;
+static int16_t  ALM_s16LatestRate                           = 0;
+static bool     ALM_bIsRateKnown                            = false;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to check the range of each setting
+ */
+static bool bAreSettingsValid(ALM_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to compute the rate of change between the latest sample of the history and the one of age
+ *        @ref ALM_CONFIG_RATE_SAMPLE_AGE
+ * @return Return "false" if a sample is missing or if they are too close (see @ref ALM_CONFIG_RATE_MIN_SPAN_MS)
+ */
+static bool bComputeRate(int16_t * const kps16Rate);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to know whether the condition of an alarm is met, with the hysteresis when it is active
+ * @remark Without a known rate, the condition of the rate alarms keeps its previous result
+ */
+static bool bIsConditionMet(const ALM_tenuAlarm kenuAlarm, const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to update the state of an alarm with its condition (dwell time before the raise)
+ */
+static void vidUpdateAlarm(const ALM_tenuAlarm kenuAlarm, const bool kbIsConditionMet, const uint32_t ku32NowUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to raise a pending alarm whose dwell time is over
+ */
+static void vidCheckDwellTime(const ALM_tenuAlarm kenuAlarm, const uint32_t ku32NowUs);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bAreSettingsValid(ALM_tstrSettings const * const kpkstrSettings)
+{
+  bool bIsValid = true;
+
+  if((kpkstrSettings->u8AlarmMask & ~ALM_ALARM_MASK_ALL) != 0)
+  {
+    bIsValid = false;
+  }
+  else if(kpkstrSettings->s16LowThreshold >= kpkstrSettings->s16HighThreshold)
+  {
+    bIsValid = false;
+  }
+  else if((kpkstrSettings->u16RateLimit == 0) || (kpkstrSettings->u16RateHysteresis > kpkstrSettings->u16RateLimit))
+  {
+    bIsValid = false;
+  }
+  else if(kpkstrSettings->u16DwellTimeS > ALM_MAX_DWELL_TIME_S)
+  {
+    bIsValid = false;
+  }
+
+  return bIsValid;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bComputeRate(int16_t * const kps16Rate)
+{
+  bool           bIsKnown       = false;
+  uint32_t       u32SpanCs      = 0;
+  int32_t        s32Rate        = 0;
+  HIS_tstrSample strLatest;
+  HIS_tstrSample strOldest;
+
+  if((HIS_enuGetSample(0, &strLatest) == HIS_eSTATUS_OK) &&
+     (HIS_enuGetSample(ALM_CONFIG_RATE_SAMPLE_AGE, &strOldest) == HIS_eSTATUS_OK))
+  {
+    u32SpanCs = (strLatest.u32TimestampUs - strOldest.u32TimestampUs) / ALM_US_PER_CENTISECOND;
+
+    if(u32SpanCs >= (ALM_CONFIG_RATE_MIN_SPAN_MS / 10))
+    {
+      s32Rate = (((int32_t)strLatest.s16Value - strOldest.s16Value) * ALM_CENTISECONDS_PER_MINUTE) / (int32_t)u32SpanCs;
+
+      if(s32Rate > INT16_MAX)
+      {
+        s32Rate = INT16_MAX;
+      }
+      else if(s32Rate < -INT16_MAX)
+      {
+        s32Rate = -INT16_MAX;
+      }
+
+      *kps16Rate = (int16_t)s32Rate;
+      bIsKnown   = true;
+    }
+  }
+
+  return bIsKnown;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bIsConditionMet(const ALM_tenuAlarm kenuAlarm, const int16_t ks16Value)
+{
+  const bool    kbIsActive  = ((ALM_u8ActiveMask & ALM_mALARM_BIT(kenuAlarm)) != 0);
+  const int32_t ks32Limit   = (int32_t)ALM_strSettings.u16RateLimit;
+  const int32_t ks32Release = (int32_t)ALM_strSettings.u16RateLimit - ALM_strSettings.u16RateHysteresis;
+  bool          bIsMet      = false;
+
+  if((kenuAlarm == ALM_eALARM_HIGH) && (kbIsActive == true))
+  {
+    bIsMet = (ks16Value > ((int32_t)ALM_strSettings.s16HighThreshold - ALM_strSettings.u16Hysteresis));
+  }
+  else if(kenuAlarm == ALM_eALARM_HIGH)
+  {
+    bIsMet = (ks16Value >= ALM_strSettings.s16HighThreshold);
+  }
+  else if((kenuAlarm == ALM_eALARM_LOW) && (kbIsActive == true))
+  {
+    bIsMet = (ks16Value < ((int32_t)ALM_strSettings.s16LowThreshold + ALM_strSettings.u16Hysteresis));
+  }
+  else if(kenuAlarm == ALM_eALARM_LOW)
+  {
+    bIsMet = (ks16Value <= ALM_strSettings.s16LowThreshold);
+  }
+  else if(ALM_bIsRateKnown == false)
+  {
+    // The rate alarms stay in their state (active or pending) until the rate is known again:
+    bIsMet = (((ALM_u8ActiveMask | ALM_u8PendingMask) & ALM_mALARM_BIT(kenuAlarm)) != 0);
+  }
+  else if(kenuAlarm == ALM_eALARM_RISE)
+  {
+    bIsMet = (ALM_s16LatestRate >= ((kbIsActive == true) ? (ks32Release + 1) : ks32Limit));
+  }
+  else if(kenuAlarm == ALM_eALARM_FALL)
+  {
+    bIsMet = (ALM_s16LatestRate <= ((kbIsActive == true) ? (-ks32Release - 1) : -ks32Limit));
+  }
+
+  return bIsMet;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidUpdateAlarm(const ALM_tenuAlarm kenuAlarm, const bool kbIsConditionMet, const uint32_t ku32NowUs)
+{
+  const uint8_t ku8Bit = ALM_mALARM_BIT(kenuAlarm);
+
+  if(((ALM_strSettings.u8AlarmMask & ku8Bit) == 0) || (kbIsConditionMet == false))
+  {
+    // Disabled or condition over: the alarm is cleared at once, the hysteresis prevents the chattering
+    ALM_u8PendingMask &= (uint8_t)~ku8Bit;
+
+    if((ALM_u8ActiveMask & ku8Bit) != 0)
+    {
+      ALM_u8ActiveMask  &= (uint8_t)~ku8Bit;
+      ALM_u8ChangedMask |= ku8Bit;
+    }
+  }
+  else if(((ALM_u8ActiveMask | ALM_u8PendingMask) & ku8Bit) == 0)
+  {
+    ALM_u8PendingMask                 |= ku8Bit;
+    ALM_au32PendingSinceUs[kenuAlarm]  = ku32NowUs;
+
+    vidCheckDwellTime(kenuAlarm, ku32NowUs);
+  }
+  else
+  {
+    vidCheckDwellTime(kenuAlarm, ku32NowUs);
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidCheckDwellTime(const ALM_tenuAlarm kenuAlarm, const uint32_t ku32NowUs)
+{
+  const uint8_t  ku8Bit       = ALM_mALARM_BIT(kenuAlarm);
+  const uint32_t ku32DwellUs  = (uint32_t)ALM_strSettings.u16DwellTimeS * 1000000UL;
+
+  if(((ALM_u8PendingMask & ku8Bit) != 0) && ((ku32NowUs - ALM_au32PendingSinceUs[kenuAlarm]) >= ku32DwellUs))
+  {
+    ALM_u8PendingMask &= (uint8_t)~ku8Bit;
+    ALM_u8ActiveMask  |= ku8Bit;
+    ALM_u8ChangedMask |= ku8Bit;
+  }
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void ALM_vidInitialize(void)
+{
+  ALM_strSettings.u8AlarmMask       = ALM_CONFIG_DEFAULT_ALARMS;
+  ALM_strSettings.s16HighThreshold  = ALM_CONFIG_DEFAULT_HIGH_THRESHOLD;
+  ALM_strSettings.s16LowThreshold   = ALM_CONFIG_DEFAULT_LOW_THRESHOLD;
+  ALM_strSettings.u16Hysteresis     = ALM_CONFIG_DEFAULT_HYSTERESIS;
+  ALM_strSettings.u16RateLimit      = ALM_CONFIG_DEFAULT_RATE_LIMIT;
+  ALM_strSettings.u16RateHysteresis = ALM_CONFIG_DEFAULT_RATE_HYSTERESIS;
+  ALM_strSettings.u16DwellTimeS     = ALM_CONFIG_DEFAULT_DWELL_TIME_S;
+
+  CMN_assert(bAreSettingsValid(&ALM_strSettings) == true);
+
+  ALM_u8ActiveMask  = 0;
+  ALM_u8PendingMask = 0;
+  ALM_u8ChangedMask = 0;
+  ALM_bIsRateKnown  = false;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool ALM_bRegisterEventCbk(const ALM_tpfvidEventCallback kpfCallback)
+{
+  bool bStatus = false;
+
+  if(kpfCallback != NULL)
+  {
+    ALM_pfEventCallback = kpfCallback;
+    bStatus             = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void ALM_vidPushSample(const int16_t ks16Value)
+{
+  const uint32_t ku32NowUs = TIM1_u32GetTimestampUs();
+  ALM_tenuAlarm  enuAlarm  = ALM_eALARM_BEGIN;
+
+  ALM_s16LatestValue = ks16Value;
+  ALM_bIsRateKnown   = bComputeRate(&ALM_s16LatestRate);
+  ALM_u8ChangedMask  = 0;
+
+  // A fixed number of comparisons per sample, whatever the history:
+  for(enuAlarm = (ALM_tenuAlarm)(ALM_eALARM_BEGIN + 1); enuAlarm < ALM_eALARM_END; enuAlarm++)
+  {
+    vidUpdateAlarm(enuAlarm, bIsConditionMet(enuAlarm, ks16Value), ku32NowUs);
+  }
+
+  if((ALM_u8ChangedMask != 0) && (ALM_pfEventCallback != NULL))
+  {
+    ALM_pfEventCallback(ALM_u8ChangedMask);
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void ALM_vidProcess(void)
+{
+  const uint32_t ku32NowUs = TIM1_u32GetTimestampUs();
+  ALM_tenuAlarm  enuAlarm  = ALM_eALARM_BEGIN;
+  uint8_t        u8Changed = 0;
+
+  if(ALM_u8PendingMask != 0)
+  {
+    ALM_u8ChangedMask = 0;
+
+    for(enuAlarm = (ALM_tenuAlarm)(ALM_eALARM_BEGIN + 1); enuAlarm < ALM_eALARM_END; enuAlarm++)
+    {
+      vidCheckDwellTime(enuAlarm, ku32NowUs);
+    }
+
+    u8Changed = ALM_u8ChangedMask;
+  }
+
+  if((u8Changed != 0) && (ALM_pfEventCallback != NULL))
+  {
+    ALM_pfEventCallback(u8Changed);
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t ALM_u8GetActiveMask(void)
+{
+  return ALM_u8ActiveMask;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ALM_tenuStatus ALM_enuSetSettings(ALM_tstrSettings const * const kpkstrSettings)
+{
+  ALM_tenuStatus enuStatus = ALM_eSTATUS_NO_OK;
+
+  if(kpkstrSettings == NULL)
+  {
+    enuStatus = ALM_eSTATUS_NULL_POINTER;
+  }
+  else if(bAreSettingsValid(kpkstrSettings) == false)
+  {
+    enuStatus = ALM_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    // The conditions are evaluated again with the new settings from the next sample:
+    ALM_strSettings   = *kpkstrSettings;
+    ALM_u8PendingMask = 0;
+
+    enuStatus = ALM_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ALM_tenuStatus ALM_enuGetSettings(ALM_tstrSettings * const kpstrSettings)
+{
+  ALM_tenuStatus enuStatus = ALM_eSTATUS_NO_OK;
+
+  if(kpstrSettings == NULL)
+  {
+    enuStatus = ALM_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrSettings = ALM_strSettings;
+    enuStatus      = ALM_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t ALM_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= ALM_SETTINGS_RECORD_SIZE))
+  {
+    kpu8Buffer[0]  = ALM_strSettings.u8AlarmMask;
+    kpu8Buffer[1]  = (uint8_t)ALM_strSettings.s16HighThreshold;
+    kpu8Buffer[2]  = (uint8_t)((uint16_t)ALM_strSettings.s16HighThreshold >> 8);
+    kpu8Buffer[3]  = (uint8_t)ALM_strSettings.s16LowThreshold;
+    kpu8Buffer[4]  = (uint8_t)((uint16_t)ALM_strSettings.s16LowThreshold >> 8);
+    kpu8Buffer[5]  = (uint8_t)ALM_strSettings.u16Hysteresis;
+    kpu8Buffer[6]  = (uint8_t)(ALM_strSettings.u16Hysteresis >> 8);
+    kpu8Buffer[7]  = (uint8_t)ALM_strSettings.u16RateLimit;
+    kpu8Buffer[8]  = (uint8_t)(ALM_strSettings.u16RateLimit >> 8);
+    kpu8Buffer[9]  = (uint8_t)ALM_strSettings.u16RateHysteresis;
+    kpu8Buffer[10] = (uint8_t)(ALM_strSettings.u16RateHysteresis >> 8);
+    kpu8Buffer[11] = (uint8_t)ALM_strSettings.u16DwellTimeS;
+    kpu8Buffer[12] = (uint8_t)(ALM_strSettings.u16DwellTimeS >> 8);
+
+    u8Size = ALM_SETTINGS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+ALM_tenuStatus ALM_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize)
+{
+  ALM_tenuStatus   enuStatus = ALM_eSTATUS_NO_OK;
+  ALM_tstrSettings strSettings;
+
+  if(kpku8Buffer == NULL)
+  {
+    enuStatus = ALM_eSTATUS_NULL_POINTER;
+  }
+  else if(ku16BufferSize != ALM_SETTINGS_RECORD_SIZE)
+  {
+    enuStatus = ALM_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    strSettings.u8AlarmMask       = kpku8Buffer[0];
+    strSettings.s16HighThreshold  = (int16_t)((uint16_t)kpku8Buffer[1] | ((uint16_t)kpku8Buffer[2] << 8));
+    strSettings.s16LowThreshold   = (int16_t)((uint16_t)kpku8Buffer[3] | ((uint16_t)kpku8Buffer[4] << 8));
+    strSettings.u16Hysteresis     = (uint16_t)kpku8Buffer[5] | ((uint16_t)kpku8Buffer[6] << 8);
+    strSettings.u16RateLimit      = (uint16_t)kpku8Buffer[7] | ((uint16_t)kpku8Buffer[8] << 8);
+    strSettings.u16RateHysteresis = (uint16_t)kpku8Buffer[9] | ((uint16_t)kpku8Buffer[10] << 8);
+    strSettings.u16DwellTimeS     = (uint16_t)kpku8Buffer[11] | ((uint16_t)kpku8Buffer[12] << 8);
+
+    enuStatus = ALM_enuSetSettings(&strSettings);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t ALM_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+  int16_t s16Rate = (ALM_bIsRateKnown == true) ? ALM_s16LatestRate : 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= ALM_STATUS_RECORD_SIZE))
+  {
+    kpu8Buffer[0] = ALM_u8ActiveMask;
+    kpu8Buffer[1] = ALM_u8ChangedMask;
+    kpu8Buffer[2] = (uint8_t)ALM_s16LatestValue;
+    kpu8Buffer[3] = (uint8_t)((uint16_t)ALM_s16LatestValue >> 8);
+    kpu8Buffer[4] = (uint8_t)s16Rate;
+    kpu8Buffer[5] = (uint8_t)((uint16_t)s16Rate >> 8);
+
+    u8Size = ALM_STATUS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,229 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Alarm.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Alarm Tools core part
+ * @details   Module in charge of the evaluation of the alarms on each filtered value:
+ *              - High and low thresholds, with a hysteresis to clear them
+ *              - Rising and falling rate of change in 0.01 degC/min, computed with a sample of the history (see
+ *                History.h), with a hysteresis to clear them
+ *            The condition of an alarm shall last the dwell time before the alarm is raised, an alarm is cleared as
+ *            soon as its condition ends. Each change of the alarms is reported to the registered callback. The cost of
+ *            a sample is constant (no loop over the history)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef ALARM_H_
+#define ALARM_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Alarm_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Maximal dwell time in s, the time of a pending alarm is measured with TIM1 (wrap after about 71 min)
+ */
+#define ALM_MAX_DWELL_TIME_S                                3600
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the settings record used by @ref ALM_u8ExportSettings and @ref ALM_enuImportSettings (all fields are
+ *        little endian):
+ *          - [0]       Mask of the enabled alarms (Bit n = alarm n of @ref ALM_tenuAlarm)
+ *          - [1..2]    High threshold (signed)
+ *          - [3..4]    Low threshold (signed, lower than the high one)
+ *          - [5..6]    Hysteresis of the thresholds
+ *          - [7..8]    Rate of change limit, in 0.01 degC/min (not 0)
+ *          - [9..10]   Hysteresis of the rate of change (up to the limit)
+ *          - [11..12]  Dwell time in s (up to @ref ALM_MAX_DWELL_TIME_S)
+ */
+#define ALM_SETTINGS_RECORD_SIZE                            13
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the status record exported by @ref ALM_u8ExportStatus (all fields are little endian):
+ *          - [0]     Mask of the active alarms (Bit n = alarm n of @ref ALM_tenuAlarm)
+ *          - [1]     Mask of the alarms changed by the latest evaluation
+ *          - [2..3]  Latest value (signed)
+ *          - [4..5]  Latest rate of change in 0.01 degC/min (signed, saturated, 0 if it is not known)
+ */
+#define ALM_STATUS_RECORD_SIZE                              6
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum ALM_tenuStatus
+{
+  ALM_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  ALM_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  ALM_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  ALM_eSTATUS_INVALID_SETTINGS,                                   //!< A setting is out of its range
+  ALM_eSTATUS_COUNT                                               //!< The total number of return code
+}ALM_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to list the alarms
+ */
+typedef enum ALM_tenuAlarm
+{
+  /*-----[ DO NOT EDIT THIS ]----*/
+  ALM_eALARM_BEGIN = -1, /*------*/
+  /*-----------------------------*/
+
+  ALM_eALARM_HIGH,
+  ALM_eALARM_LOW,
+  ALM_eALARM_RISE,
+  ALM_eALARM_FALL,
+
+  /*-----[ DO NOT EDIT THIS ]----*/
+  ALM_eALARM_END /*--------------*/
+  /*-----------------------------*/
+}ALM_tenuAlarm;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to set the runtime settings of the alarms
+ */
+typedef struct ALM_tstrSettings
+{
+  uint8_t                                                   u8AlarmMask;              //!< Enabled alarms (Bit n = alarm n)
+  int16_t                                                   s16HighThreshold;         //!< Raised at or above it
+  int16_t                                                   s16LowThreshold;          //!< Raised at or below it, lower than the high one
+  uint16_t                                                  u16Hysteresis;            //!< Distance to the threshold to clear the alarm
+  uint16_t                                                  u16RateLimit;             //!< Rate (0.01 degC/min) raising the rise/fall alarms
+  uint16_t                                                  u16RateHysteresis;        //!< Distance to the limit to clear them, up to the limit
+  uint16_t                                                  u16DwellTimeS;            //!< Time of the condition before the raise
+}ALM_tstrSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Callback type definition of the consumer of the alarm changes
+ * @param[in] ku8ChangedMask: The mask of the alarms whose state changed (see @ref ALM_u8GetActiveMask for the state)
+ */
+typedef void (*ALM_tpfvidEventCallback)(const uint8_t ku8ChangedMask);
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the alarms with the default settings (see Alarm_cfg.h), no alarm is active
+ */
+void ALM_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to register the consumer of the alarm changes
+ * @param[in] kpfCallback: Pointer to the function called at each change
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool ALM_bRegisterEventCbk(const ALM_tpfvidEventCallback kpfCallback);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to evaluate the alarms with a new value
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe), after
+ *         HIS_vidPushSample: the latest sample of the history is the new value
+ * @param[in] ks16Value: The value of the sample
+ */
+void ALM_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to raise the alarms whose dwell time ended without a new sample (main loop)
+ */
+void ALM_vidProcess(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the active alarms
+ * @return The mask of the active alarms (Bit n = alarm n of @ref ALM_tenuAlarm)
+ */
+uint8_t ALM_u8GetActiveMask(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings of the alarms
+ * @details The dwell time of the pending alarms restarts, the disabled alarms are cleared at the next evaluation
+ * @param[in] kpkstrSettings: The new settings (unchanged if one of them is out of its range)
+ * @return The status of the change
+ */
+ALM_tenuStatus ALM_enuSetSettings(ALM_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the runtime settings of the alarms
+ * @param[out] kpstrSettings: The current settings
+ * @return The status of the reading
+ */
+ALM_tenuStatus ALM_enuGetSettings(ALM_tstrSettings * const kpstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the runtime settings (see @ref ALM_SETTINGS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t ALM_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings with a record (see @ref ALM_SETTINGS_RECORD_SIZE for the format)
+ * @param kpku8Buffer: Pointer to the record
+ * @param ku16BufferSize: Size of the record
+ * @return The status of the change, @ref ALM_eSTATUS_INVALID_SETTINGS if the size or a setting is wrong
+ */
+ALM_tenuStatus ALM_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the state of the alarms (see @ref ALM_STATUS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t ALM_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // ALARM_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -32,6 +32,7 @@
 #include <limits.h>
 #include "Common_pt.h"
 #include "Common_cfg.h"
+#include "Common_fmt.h"
 
 
 /**********************************************************************************************************************/
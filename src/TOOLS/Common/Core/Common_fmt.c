@@ -0,0 +1,297 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Common_fmt.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Common file for the formatting of the numbers
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+#include "Common_fmt.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#define CMN_FMT_DECIMAL_POINT                               '.'
+#define CMN_FMT_MINUS_SIGN                                  '-'
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief The table of the powers of ten used to extract the digits by subtractions (the PIC18 has no divider)
+ */
+static const uint32_t CMN_kau32PowersOfTen[CMN_FMT_MAX_DIGITS] =
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+static uint32_t u32Magnitude(const int32_t ks32Value);
+static uint8_t u8ExpandDigits(char * const kps8Digits, uint32_t u32Value, const uint8_t ku8MinDigits);
+static uint8_t u8Assemble(char * const kps8Buffer,
+                          const uint8_t ku8BufferSize,
+                          const bool kbNegative,
+                          char const * const kpks8IntegerDigits,
+                          const uint8_t ku8IntegerCount,
+                          char const * const kpks8FractionDigits,
+                          const uint8_t ku8FractionCount);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static uint32_t u32Magnitude(const int32_t ks32Value)
+{
+  /* Computed without overflow for INT32_MIN */
+  return (ks32Value < 0) ? ((uint32_t)(-(ks32Value + 1)) + 1) : (uint32_t)ks32Value;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8ExpandDigits(char * const kps8Digits, uint32_t u32Value, const uint8_t ku8MinDigits)
+{
+  uint8_t u8Count    = 0;
+  uint8_t u8PowerIdx = 0;
+  char    s8Digit    = '0';
+
+  for(u8PowerIdx = 0; u8PowerIdx < CMN_FMT_MAX_DIGITS; u8PowerIdx++)
+  {
+    s8Digit = '0';
+
+    while(u32Value >= CMN_kau32PowersOfTen[u8PowerIdx])
+    {
+      u32Value -= CMN_kau32PowersOfTen[u8PowerIdx];
+      s8Digit++;
+    }
+
+    /* The leading zeros are skipped, except those needed to reach the minimal number of digits */
+    if((s8Digit != '0') || (u8Count != 0) || ((CMN_FMT_MAX_DIGITS - u8PowerIdx) <= ku8MinDigits))
+    {
+      kps8Digits[u8Count] = s8Digit;
+      u8Count++;
+    }
+  }
+
+  return u8Count;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint8_t u8Assemble(char * const kps8Buffer,
+                          const uint8_t ku8BufferSize,
+                          const bool kbNegative,
+                          char const * const kpks8IntegerDigits,
+                          const uint8_t ku8IntegerCount,
+                          char const * const kpks8FractionDigits,
+                          const uint8_t ku8FractionCount)
+{
+  uint8_t u8Length = (uint8_t)((kbNegative ? 1 : 0) + ku8IntegerCount + ((ku8FractionCount > 0) ? (1 + ku8FractionCount) : 0));
+  uint8_t u8Index  = 0;
+  uint8_t u8Idx    = 0;
+
+  if((kps8Buffer == NULL) || (ku8BufferSize == 0))
+  {
+    u8Length = 0;
+  }
+  else if(u8Length >= ku8BufferSize)
+  {
+    kps8Buffer[0] = '\0';
+    u8Length      = 0;
+  }
+  else
+  {
+    if(kbNegative)
+    {
+      kps8Buffer[u8Index++] = CMN_FMT_MINUS_SIGN;
+    }
+
+    for(u8Idx = 0; u8Idx < ku8IntegerCount; u8Idx++)
+    {
+      kps8Buffer[u8Index++] = kpks8IntegerDigits[u8Idx];
+    }
+
+    if(ku8FractionCount > 0)
+    {
+      kps8Buffer[u8Index++] = CMN_FMT_DECIMAL_POINT;
+
+      for(u8Idx = 0; u8Idx < ku8FractionCount; u8Idx++)
+      {
+        kps8Buffer[u8Index++] = kpks8FractionDigits[u8Idx];
+      }
+    }
+
+    kps8Buffer[u8Index] = '\0';
+  }
+
+  return u8Length;
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+uint8_t CMN_u8FormatUnsigned(char * const kps8Buffer, const uint8_t ku8BufferSize, const uint32_t ku32Value)
+{
+  char    as8Digits[CMN_FMT_MAX_DIGITS];
+  uint8_t u8Count = u8ExpandDigits(as8Digits, ku32Value, 1);
+
+  return u8Assemble(kps8Buffer, ku8BufferSize, false, as8Digits, u8Count, NULL, 0);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t CMN_u8FormatSigned(char * const kps8Buffer, const uint8_t ku8BufferSize, const int32_t ks32Value)
+{
+  return CMN_u8FormatDecimal(kps8Buffer, ku8BufferSize, ks32Value, 0);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t CMN_u8FormatDecimal(char * const kps8Buffer,
+                            const uint8_t ku8BufferSize,
+                            const int32_t ks32Value,
+                            const uint8_t ku8Decimals)
+{
+  char    as8Digits[CMN_FMT_MAX_DIGITS];
+  uint8_t u8Count  = 0;
+  uint8_t u8Length = 0;
+
+  if(ku8Decimals < CMN_FMT_MAX_DIGITS)
+  {
+    /* At least one digit before the decimal point: "0.05" */
+    u8Count  = u8ExpandDigits(as8Digits, u32Magnitude(ks32Value), (uint8_t)(ku8Decimals + 1));
+    u8Length = u8Assemble(kps8Buffer,
+                          ku8BufferSize,
+                          (ks32Value < 0),
+                          as8Digits,
+                          (uint8_t)(u8Count - ku8Decimals),
+                          &as8Digits[u8Count - ku8Decimals],
+                          ku8Decimals);
+  }
+  else if((kps8Buffer != NULL) && (ku8BufferSize > 0))
+  {
+    kps8Buffer[0] = '\0';
+  }
+
+  return u8Length;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t CMN_u8FormatFixedPoint(char * const kps8Buffer,
+                               const uint8_t ku8BufferSize,
+                               const int32_t ks32Value,
+                               const uint8_t ku8FractionalBits,
+                               const uint8_t ku8Decimals)
+{
+  char     as8IntegerDigits[CMN_FMT_MAX_DIGITS];
+  char     as8FractionDigits[CMN_FMT_MAX_FIXED_POINT_DECIMALS];
+  uint32_t u32AbsValue      = 0;
+  uint32_t u32Integer       = 0;
+  uint32_t u32Fraction      = 0;
+  uint32_t u32DecimalScale  = 0;
+  uint8_t  u8IntegerCount   = 0;
+  uint8_t  u8FractionCount  = 0;
+  uint8_t  u8Length         = 0;
+
+  if((ku8FractionalBits > CMN_FMT_MAX_FRACTIONAL_BITS) || (ku8Decimals > CMN_FMT_MAX_FIXED_POINT_DECIMALS))
+  {
+    if((kps8Buffer != NULL) && (ku8BufferSize > 0))
+    {
+      kps8Buffer[0] = '\0';
+    }
+  }
+  else
+  {
+    u32AbsValue     = u32Magnitude(ks32Value);
+    u32DecimalScale = CMN_kau32PowersOfTen[CMN_FMT_MAX_DIGITS - 1 - ku8Decimals];
+    u32Integer      = (u32AbsValue >> ku8FractionalBits);
+    u32Fraction     = (u32AbsValue & ((1UL << ku8FractionalBits) - 1));
+
+    /* Fraction converted to the decimal scale, rounded to the nearest */
+    u32Fraction = (ku8FractionalBits == 0) ? 0 :
+                  (((u32Fraction * u32DecimalScale) + (1UL << (ku8FractionalBits - 1))) >> ku8FractionalBits);
+
+    if(u32Fraction >= u32DecimalScale)
+    {
+      u32Fraction -= u32DecimalScale;
+      u32Integer++;
+    }
+
+    u8IntegerCount = u8ExpandDigits(as8IntegerDigits, u32Integer, 1);
+
+    if(ku8Decimals > 0)
+    {
+      u8FractionCount = u8ExpandDigits(as8FractionDigits, u32Fraction, ku8Decimals);
+    }
+
+    /* No sign when the rounded value is zero */
+    u8Length = u8Assemble(kps8Buffer,
+                          ku8BufferSize,
+                          ((ks32Value < 0) && ((u32Integer != 0) || (u32Fraction != 0))),
+                          as8IntegerDigits,
+                          u8IntegerCount,
+                          as8FractionDigits,
+                          u8FractionCount);
+  }
+
+  return u8Length;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(CMN_ENABLE_PRINTF == true)
+void CMN_vidLogText(char const * const kpks8Text)
+{
+  char const *pks8Char = kpks8Text;
+
+  if(pks8Char != NULL)
+  {
+    while(*pks8Char != '\0')
+    {
+      CMN_portPutChar(*pks8Char);
+      pks8Char++;
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void CMN_vidLogDecimal(const int32_t ks32Value, const uint8_t ku8Decimals)
+{
+  char as8Buffer[CMN_FMT_BUFFER_SIZE];
+
+  if(CMN_u8FormatDecimal(as8Buffer, sizeof(as8Buffer), ks32Value, ku8Decimals) > 0)
+  {
+    CMN_vidLogText(as8Buffer);
+  }
+}
+#endif //CMN_ENABLE_PRINTF
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
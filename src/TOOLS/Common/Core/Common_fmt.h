@@ -0,0 +1,162 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Common_fmt.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Common file for the formatting of the numbers
+ * @details   Lightweight replacement of the printf family for the integer and fixed-point values: the digits are
+ *            extracted with a table of powers of ten (subtractions only, no division) and there is no format string to
+ *            parse
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef COMMON_FMT_H_
+#define COMMON_FMT_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "Common_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Maximal number of digits of a 32 Bits value
+ */
+#define CMN_FMT_MAX_DIGITS                                  10
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Buffer size needed to format any 32 Bits value: sign, digits, decimal point and the '\0' ending
+ */
+#define CMN_FMT_BUFFER_SIZE                                 (1 + CMN_FMT_MAX_DIGITS + 1 + 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+// Limits of the fixed-point formatting (the fraction is computed on 32 Bits):
+#define CMN_FMT_MAX_FRACTIONAL_BITS                         16
+#define CMN_FMT_MAX_FIXED_POINT_DECIMALS                    4
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Buffer size needed to format any fixed-point value: the integer part of a Q0 value has up to 10 digits
+ */
+#define CMN_FMT_FIXED_POINT_BUFFER_SIZE                     (1 + CMN_FMT_MAX_DIGITS + 1 + CMN_FMT_MAX_FIXED_POINT_DECIMALS + 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Log macros without format string, enabled with the @ref CMN_ENABLE_PRINTF setting like @ref CMN_systemPrintf
+ */
+#if(CMN_ENABLE_PRINTF == true)
+#define CMN_systemLogText(_TEXT_)                           CMN_vidLogText(_TEXT_)
+#define CMN_systemLogInteger(_VALUE_)                       CMN_vidLogDecimal((int32_t)(_VALUE_), 0)
+#define CMN_systemLogDecimal(_VALUE_, _DECIMALS_)           CMN_vidLogDecimal((int32_t)(_VALUE_), (_DECIMALS_))
+#else
+#define CMN_systemLogText(_TEXT_)
+#define CMN_systemLogInteger(_VALUE_)
+#define CMN_systemLogDecimal(_VALUE_, _DECIMALS_)
+#endif //CMN_ENABLE_PRINTF
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to format an unsigned integer in decimal
+ * @param[out]  kps8Buffer: The buffer where the text is written, always ended by '\0'
+ * @param[in] ku8BufferSize: The size of the buffer (see @ref CMN_FMT_BUFFER_SIZE)
+ * @param[in]     ku32Value: The value to be formatted
+ * @return The number of written characters (without the '\0' ending), 0 if the buffer is too small
+ */
+uint8_t CMN_u8FormatUnsigned(char * const kps8Buffer, const uint8_t ku8BufferSize, const uint32_t ku32Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to format a signed integer in decimal
+ * @param[out]  kps8Buffer: The buffer where the text is written, always ended by '\0'
+ * @param[in] ku8BufferSize: The size of the buffer (see @ref CMN_FMT_BUFFER_SIZE)
+ * @param[in]     ks32Value: The value to be formatted
+ * @return The number of written characters (without the '\0' ending), 0 if the buffer is too small
+ */
+uint8_t CMN_u8FormatSigned(char * const kps8Buffer, const uint8_t ku8BufferSize, const int32_t ks32Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to format a value scaled by a power of ten, for example 2345 with 2 decimals gives "23.45"
+ * @param[out]  kps8Buffer: The buffer where the text is written, always ended by '\0'
+ * @param[in] ku8BufferSize: The size of the buffer (see @ref CMN_FMT_BUFFER_SIZE)
+ * @param[in]     ks32Value: The scaled value to be formatted
+ * @param[in]   ku8Decimals: The number of decimals of the value (0 gives an integer)
+ * @return The number of written characters (without the '\0' ending), 0 if the buffer is too small
+ */
+uint8_t CMN_u8FormatDecimal(char * const kps8Buffer,
+                            const uint8_t ku8BufferSize,
+                            const int32_t ks32Value,
+                            const uint8_t ku8Decimals);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to format a binary fixed-point value (Q format), rounded to the nearest
+ * @param[out]        kps8Buffer: The buffer where the text is written, always ended by '\0'
+ * @param[in]       ku8BufferSize: The size of the buffer (see @ref CMN_FMT_FIXED_POINT_BUFFER_SIZE)
+ * @param[in]           ks32Value: The fixed-point value to be formatted
+ * @param[in]   ku8FractionalBits: The number of fractional bits of the value (up to @ref CMN_FMT_MAX_FRACTIONAL_BITS)
+ * @param[in]         ku8Decimals: The number of printed decimals (up to @ref CMN_FMT_MAX_FIXED_POINT_DECIMALS)
+ * @return The number of written characters (without the '\0' ending), 0 if the buffer is too small or if the
+ *         parameters are out of range
+ */
+uint8_t CMN_u8FormatFixedPoint(char * const kps8Buffer,
+                               const uint8_t ku8BufferSize,
+                               const int32_t ks32Value,
+                               const uint8_t ku8FractionalBits,
+                               const uint8_t ku8Decimals);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#if(CMN_ENABLE_PRINTF == true)
+/**
+ * @brief Function used to send a text on the printf output
+ * @remark The direct use of this function is not recommended, use the @ref CMN_systemLogText instead
+ * @param[in] kpks8Text: The text to be sent
+ */
+void CMN_vidLogText(char const * const kpks8Text);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to send a value scaled by a power of ten on the printf output
+ * @remark The direct use of this function is not recommended, use the @ref CMN_systemLogInteger or
+ *         @ref CMN_systemLogDecimal instead
+ * @param[in]   ks32Value: The scaled value to be sent
+ * @param[in] ku8Decimals: The number of decimals of the value (0 gives an integer)
+ */
+void CMN_vidLogDecimal(const int32_t ks32Value, const uint8_t ku8Decimals);
+#endif //CMN_ENABLE_PRINTF
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // COMMON_FMT_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
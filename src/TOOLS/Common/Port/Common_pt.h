@@ -46,6 +46,13 @@
 #define CMN_portPrintf(...)                                 printf(__VA_ARGS__)
 
 
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Port character output macro (the output used by printf)
+ */
+#define CMN_portPutChar(_CHAR_)                             putch(_CHAR_)
+
+
 /**********************************************************************************************************************/
 /* TYPES                                                                                                              */
 /**********************************************************************************************************************/
@@ -0,0 +1,85 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Filter_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Filter Tools conf part
+ * @details   Module in charge of the digital filtering of a sampled signal and of the publication of the filtered
+ *            values to the subscribed consumers
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef FILTER_CFG_H_
+#define FILTER_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the maximal number of consumers which can subscribe to the filtered values
+ */
+#define FLT_CONFIG_MAX_SUBSCRIBERS                          8
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the maximal window of the median stage (odd value), it bounds the cost of a sample
+ */
+#define FLT_CONFIG_MEDIAN_MAX_LENGTH                        7
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the stages enabled at the initialization (see @ref FLT_tenuStage), they can be changed at runtime
+ */
+#define FLT_CONFIG_DEFAULT_STAGES                           ((1 << FLT_eSTAGE_MEDIAN) | (1 << FLT_eSTAGE_EMA))
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default window of the median stage (odd value up to @ref FLT_CONFIG_MEDIAN_MAX_LENGTH)
+ */
+#define FLT_CONFIG_DEFAULT_MEDIAN_LENGTH                    5
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default smoothing factor of the EMA stage as a shift: alpha = 1 / 2^shift
+ */
+#define FLT_CONFIG_DEFAULT_EMA_SHIFT                        2
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default Q14 coefficients of the IIR stage: y[n] = b0.x[n] + b1.x[n-1] - a1.y[n-1]
+ * @details Bilinear first-order low-pass with a cut-off at 5 % of the sampling frequency (unity DC gain)
+ */
+#define FLT_CONFIG_DEFAULT_IIR_B0                           2240
+#define FLT_CONFIG_DEFAULT_IIR_B1                           2240
+#define FLT_CONFIG_DEFAULT_IIR_A1                           (-11904)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* FILTER_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
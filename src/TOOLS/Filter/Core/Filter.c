@@ -0,0 +1,457 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Filter.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Filter Tools core part
+ * @details   Module in charge of the digital filtering of a sampled signal and of the publication of the filtered
+ *            values to the subscribed consumers
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Filter.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((FLT_CONFIG_MEDIAN_MAX_LENGTH < 1) || (FLT_CONFIG_MEDIAN_MAX_LENGTH > UINT8_MAX) || \
+    ((FLT_CONFIG_MEDIAN_MAX_LENGTH & 1) == 0))
+#  error "[FLT ] Error: The setting FLT_CONFIG_MEDIAN_MAX_LENGTH must be an odd value up to 255"
+#endif
+
+#if((FLT_CONFIG_DEFAULT_MEDIAN_LENGTH < 1) || (FLT_CONFIG_DEFAULT_MEDIAN_LENGTH > FLT_CONFIG_MEDIAN_MAX_LENGTH) || \
+    ((FLT_CONFIG_DEFAULT_MEDIAN_LENGTH & 1) == 0))
+#  error "[FLT ] Error: The setting FLT_CONFIG_DEFAULT_MEDIAN_LENGTH must be an odd value up to the maximal length"
+#endif
+
+#if(FLT_CONFIG_DEFAULT_EMA_SHIFT > FLT_EMA_MAX_SHIFT)
+#  error "[FLT ] Error: The setting FLT_CONFIG_DEFAULT_EMA_SHIFT is out of range"
+#endif
+
+#if(FLT_CONFIG_MAX_SUBSCRIBERS < 1)
+#  error "[FLT ] Error: The setting FLT_CONFIG_MAX_SUBSCRIBERS must be at least 1"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Mask of the valid stages
+ */
+#define FLT_STAGE_MASK_ALL                                  ((1 << FLT_eSTAGE_END) - 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macro used to know whether a stage is enabled in the current settings
+ */
+#define FLT_mIS_STAGE_ENABLED(_STAGE_)                      ((FLT_strSettings.u8StageMask & (1 << (_STAGE_))) != 0)
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Runtime settings of the filter
+ */
+static FLT_tstrSettings FLT_strSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Consumers of the filtered values
+ */
+static FLT_tpfvidSubscriber FLT_apfSubscribers[FLT_CONFIG_MAX_SUBSCRIBERS] = { NULL };
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Set when the state of the EMA and IIR stages is initialized (first sample after a reset)
+ */
+static bool FLT_bIsStarted                                  = false;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the median stage: the window in the arrival order (ring) and the same samples sorted
+ */
+static int16_t FLT_as16MedianWindow[FLT_CONFIG_MEDIAN_MAX_LENGTH];
+static int16_t FLT_as16MedianSorted[FLT_CONFIG_MEDIAN_MAX_LENGTH];
+static uint8_t FLT_u8MedianIndex                            = 0;
+static uint8_t FLT_u8MedianCount                            = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the EMA stage: the average scaled by 2^shift
+ */
+static int32_t FLT_s32EmaSum                                = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the IIR stage: the previous input and output, and the rounding error fed back in the next sample
+ *        (without it, the output would stay stuck a few LSB away from a constant input)
+ */
+static int16_t FLT_s16IirLastInput                          = 0;
+static int16_t FLT_s16IirLastOutput                         = 0;
+static int32_t FLT_s32IirError                              = 0;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to check the range of each setting
+ */
+static bool bAreSettingsValid(FLT_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Functions used to process a sample by a stage, their cost does not depend on the signal
+ */
+static int16_t s16MedianStage(const int16_t ks16Sample);
+static int16_t s16EmaStage(const int16_t ks16Sample);
+static int16_t s16IirStage(const int16_t ks16Sample);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bAreSettingsValid(FLT_tstrSettings const * const kpkstrSettings)
+{
+  bool bIsValid = ((kpkstrSettings->u8StageMask & ~FLT_STAGE_MASK_ALL) == 0);
+
+  // Odd median window, thus the median is always one of the samples:
+  bIsValid = bIsValid && (kpkstrSettings->u8MedianLength >= 1);
+  bIsValid = bIsValid && (kpkstrSettings->u8MedianLength <= FLT_CONFIG_MEDIAN_MAX_LENGTH);
+  bIsValid = bIsValid && ((kpkstrSettings->u8MedianLength & 1) != 0);
+  bIsValid = bIsValid && (kpkstrSettings->u8EmaShift <= FLT_EMA_MAX_SHIFT);
+
+  // IIR coefficients within [-1.0; 1.0], the feedback strictly inside for the stability:
+  bIsValid = bIsValid && (kpkstrSettings->s16IirB0 >= -FLT_IIR_COEFFICIENT_ONE);
+  bIsValid = bIsValid && (kpkstrSettings->s16IirB0 <=  FLT_IIR_COEFFICIENT_ONE);
+  bIsValid = bIsValid && (kpkstrSettings->s16IirB1 >= -FLT_IIR_COEFFICIENT_ONE);
+  bIsValid = bIsValid && (kpkstrSettings->s16IirB1 <=  FLT_IIR_COEFFICIENT_ONE);
+  bIsValid = bIsValid && (kpkstrSettings->s16IirA1 >  -FLT_IIR_COEFFICIENT_ONE);
+  bIsValid = bIsValid && (kpkstrSettings->s16IirA1 <   FLT_IIR_COEFFICIENT_ONE);
+
+  return bIsValid;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static int16_t s16MedianStage(const int16_t ks16Sample)
+{
+  uint8_t u8Position = 0;
+
+  // The oldest sample leaves the sorted window once it is full:
+  if(FLT_u8MedianCount == FLT_strSettings.u8MedianLength)
+  {
+    while(FLT_as16MedianSorted[u8Position] != FLT_as16MedianWindow[FLT_u8MedianIndex])
+    {
+      u8Position++;
+    }
+
+    FLT_u8MedianCount--;
+
+    for(; u8Position < FLT_u8MedianCount; u8Position++)
+    {
+      FLT_as16MedianSorted[u8Position] = FLT_as16MedianSorted[u8Position + 1];
+    }
+  }
+
+  FLT_as16MedianWindow[FLT_u8MedianIndex] = ks16Sample;
+  FLT_u8MedianIndex++;
+
+  if(FLT_u8MedianIndex >= FLT_strSettings.u8MedianLength)
+  {
+    FLT_u8MedianIndex = 0;
+  }
+
+  // Insertion of the new sample in the sorted window:
+  for(u8Position = FLT_u8MedianCount;
+      (u8Position > 0) && (FLT_as16MedianSorted[u8Position - 1] > ks16Sample);
+      u8Position--)
+  {
+    FLT_as16MedianSorted[u8Position] = FLT_as16MedianSorted[u8Position - 1];
+  }
+
+  FLT_as16MedianSorted[u8Position] = ks16Sample;
+  FLT_u8MedianCount++;
+
+  // While the window is being filled, the median of the received samples is given:
+  return FLT_as16MedianSorted[FLT_u8MedianCount / 2];
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static int16_t s16EmaStage(const int16_t ks16Sample)
+{
+  const uint8_t ku8Shift = FLT_strSettings.u8EmaShift;
+  int32_t       s32Round = (ku8Shift > 0) ? (1L << (ku8Shift - 1)) : 0;
+
+  // S = S - S / 2^k + x gives y = S / 2^k = y + (x - y) / 2^k without any multiplication (arithmetic shifts):
+  if(FLT_bIsStarted == false)
+  {
+    FLT_s32EmaSum = (int32_t)ks16Sample * (1L << ku8Shift);
+  }
+  else
+  {
+    FLT_s32EmaSum = FLT_s32EmaSum - (FLT_s32EmaSum >> ku8Shift) + ks16Sample;
+  }
+
+  return (int16_t)((FLT_s32EmaSum + s32Round) >> ku8Shift);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static int16_t s16IirStage(const int16_t ks16Sample)
+{
+  int32_t s32Accumulator = 0;
+  int32_t s32Output      = 0;
+
+  // The filter starts in its steady state for a constant input:
+  if(FLT_bIsStarted == false)
+  {
+    FLT_s16IirLastInput  = ks16Sample;
+    FLT_s16IirLastOutput = ks16Sample;
+    FLT_s32IirError      = 0;
+  }
+
+  // The coefficients are limited to [-1.0; 1.0], thus the sum of the three Q14 products cannot overflow 32 Bits:
+  s32Accumulator = ((int32_t)FLT_strSettings.s16IirB0 * ks16Sample)
+                 + ((int32_t)FLT_strSettings.s16IirB1 * FLT_s16IirLastInput)
+                 - ((int32_t)FLT_strSettings.s16IirA1 * FLT_s16IirLastOutput)
+                 + FLT_s32IirError;
+
+  s32Output       = (s32Accumulator + (FLT_IIR_COEFFICIENT_ONE / 2)) >> FLT_IIR_COEFFICIENT_BITS;
+  FLT_s32IirError = s32Accumulator - (s32Output * FLT_IIR_COEFFICIENT_ONE);
+
+  if((s32Output > INT16_MAX) || (s32Output < INT16_MIN))
+  {
+    s32Output       = (s32Output > INT16_MAX) ? INT16_MAX : INT16_MIN;
+    FLT_s32IirError = 0;
+  }
+
+  FLT_s16IirLastInput  = ks16Sample;
+  FLT_s16IirLastOutput = (int16_t)s32Output;
+
+  return FLT_s16IirLastOutput;
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void FLT_vidInitialize(void)
+{
+  FLT_strSettings.u8StageMask    = FLT_CONFIG_DEFAULT_STAGES;
+  FLT_strSettings.u8MedianLength = FLT_CONFIG_DEFAULT_MEDIAN_LENGTH;
+  FLT_strSettings.u8EmaShift     = FLT_CONFIG_DEFAULT_EMA_SHIFT;
+  FLT_strSettings.s16IirB0       = FLT_CONFIG_DEFAULT_IIR_B0;
+  FLT_strSettings.s16IirB1       = FLT_CONFIG_DEFAULT_IIR_B1;
+  FLT_strSettings.s16IirA1       = FLT_CONFIG_DEFAULT_IIR_A1;
+
+  CMN_assert(bAreSettingsValid(&FLT_strSettings) == true);
+
+  FLT_vidReset();
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool FLT_bSubscribe(const FLT_tpfvidSubscriber kpfSubscriber)
+{
+  bool    bStatus   = false;
+  bool    bIsKnown  = false;
+  uint8_t u8FreeIdx = FLT_CONFIG_MAX_SUBSCRIBERS;
+  uint8_t u8Idx     = 0;
+
+  if(kpfSubscriber != NULL)
+  {
+    for(u8Idx = 0; u8Idx < FLT_CONFIG_MAX_SUBSCRIBERS; u8Idx++)
+    {
+      if(FLT_apfSubscribers[u8Idx] == kpfSubscriber)
+      {
+        bIsKnown = true;
+      }
+      else if((FLT_apfSubscribers[u8Idx] == NULL) && (u8FreeIdx == FLT_CONFIG_MAX_SUBSCRIBERS))
+      {
+        u8FreeIdx = u8Idx;
+      }
+    }
+
+    if((bIsKnown == false) && (u8FreeIdx < FLT_CONFIG_MAX_SUBSCRIBERS))
+    {
+      FLT_apfSubscribers[u8FreeIdx] = kpfSubscriber;
+      bStatus                       = true;
+    }
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+int16_t FLT_s16PushSample(const int16_t ks16Sample)
+{
+  int16_t s16Value = ks16Sample;
+  uint8_t u8Idx    = 0;
+
+  if(FLT_mIS_STAGE_ENABLED(FLT_eSTAGE_MEDIAN))
+  {
+    s16Value = s16MedianStage(s16Value);
+  }
+
+  if(FLT_mIS_STAGE_ENABLED(FLT_eSTAGE_EMA))
+  {
+    s16Value = s16EmaStage(s16Value);
+  }
+
+  if(FLT_mIS_STAGE_ENABLED(FLT_eSTAGE_IIR))
+  {
+    s16Value = s16IirStage(s16Value);
+  }
+
+  FLT_bIsStarted = true;
+
+  for(u8Idx = 0; u8Idx < FLT_CONFIG_MAX_SUBSCRIBERS; u8Idx++)
+  {
+    if(FLT_apfSubscribers[u8Idx] != NULL)
+    {
+      FLT_apfSubscribers[u8Idx](s16Value);
+    }
+  }
+
+  return s16Value;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void FLT_vidReset(void)
+{
+  FLT_bIsStarted    = false;
+  FLT_u8MedianIndex = 0;
+  FLT_u8MedianCount = 0;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+FLT_tenuStatus FLT_enuSetSettings(FLT_tstrSettings const * const kpkstrSettings)
+{
+  FLT_tenuStatus enuStatus = FLT_eSTATUS_NO_OK;
+
+  if(kpkstrSettings == NULL)
+  {
+    enuStatus = FLT_eSTATUS_NULL_POINTER;
+  }
+  else if(bAreSettingsValid(kpkstrSettings) == false)
+  {
+    enuStatus = FLT_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    // The state of the stages does not match the new settings, the filter restarts on the next sample:
+    FLT_strSettings = *kpkstrSettings;
+    FLT_vidReset();
+
+    enuStatus = FLT_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+FLT_tenuStatus FLT_enuGetSettings(FLT_tstrSettings * const kpstrSettings)
+{
+  FLT_tenuStatus enuStatus = FLT_eSTATUS_NO_OK;
+
+  if(kpstrSettings == NULL)
+  {
+    enuStatus = FLT_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrSettings = FLT_strSettings;
+    enuStatus      = FLT_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t FLT_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= FLT_SETTINGS_RECORD_SIZE))
+  {
+    kpu8Buffer[0] = FLT_strSettings.u8StageMask;
+    kpu8Buffer[1] = FLT_strSettings.u8MedianLength;
+    kpu8Buffer[2] = FLT_strSettings.u8EmaShift;
+    kpu8Buffer[3] = (uint8_t)FLT_strSettings.s16IirB0;
+    kpu8Buffer[4] = (uint8_t)((uint16_t)FLT_strSettings.s16IirB0 >> 8);
+    kpu8Buffer[5] = (uint8_t)FLT_strSettings.s16IirB1;
+    kpu8Buffer[6] = (uint8_t)((uint16_t)FLT_strSettings.s16IirB1 >> 8);
+    kpu8Buffer[7] = (uint8_t)FLT_strSettings.s16IirA1;
+    kpu8Buffer[8] = (uint8_t)((uint16_t)FLT_strSettings.s16IirA1 >> 8);
+
+    u8Size = FLT_SETTINGS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+FLT_tenuStatus FLT_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize)
+{
+  FLT_tenuStatus   enuStatus = FLT_eSTATUS_NO_OK;
+  FLT_tstrSettings strSettings;
+
+  if(kpku8Buffer == NULL)
+  {
+    enuStatus = FLT_eSTATUS_NULL_POINTER;
+  }
+  else if(ku16BufferSize != FLT_SETTINGS_RECORD_SIZE)
+  {
+    enuStatus = FLT_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    strSettings.u8StageMask    = kpku8Buffer[0];
+    strSettings.u8MedianLength = kpku8Buffer[1];
+    strSettings.u8EmaShift     = kpku8Buffer[2];
+    strSettings.s16IirB0       = (int16_t)((uint16_t)kpku8Buffer[3] | ((uint16_t)kpku8Buffer[4] << 8));
+    strSettings.s16IirB1       = (int16_t)((uint16_t)kpku8Buffer[5] | ((uint16_t)kpku8Buffer[6] << 8));
+    strSettings.s16IirA1       = (int16_t)((uint16_t)kpku8Buffer[7] | ((uint16_t)kpku8Buffer[8] << 8));
+
+    enuStatus = FLT_enuSetSettings(&strSettings);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,204 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Filter.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Filter Tools core part
+ * @details   Module in charge of the digital filtering of a sampled signal and of the publication of the filtered
+ *            values to the subscribed consumers. The stages are chained in a fixed order, each of them can be enabled
+ *            at runtime:
+ *              - Median of the N last samples (spike rejection)
+ *              - Exponential moving average with alpha = 1 / 2^shift
+ *              - First-order IIR with Q14 coefficients
+ *            The filters are integer-only and the cost of a sample is bounded (@ref FLT_CONFIG_MEDIAN_MAX_LENGTH)
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef FILTER_H_
+#define FILTER_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Filter_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Number of fractional bits of the IIR coefficients (16384 = 1.0)
+ */
+#define FLT_IIR_COEFFICIENT_BITS                            14
+#define FLT_IIR_COEFFICIENT_ONE                             (1 << FLT_IIR_COEFFICIENT_BITS)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maximal shift of the EMA stage (alpha = 1 / 2^15)
+ */
+#define FLT_EMA_MAX_SHIFT                                   15
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the settings record used by @ref FLT_u8ExportSettings and @ref FLT_enuImportSettings (all fields are
+ *        little endian):
+ *          - [0]     Mask of the enabled stages (Bit n = stage n of @ref FLT_tenuStage)
+ *          - [1]     Window of the median stage
+ *          - [2]     Shift of the EMA stage
+ *          - [3..4]  b0 of the IIR stage (Q14, signed)
+ *          - [5..6]  b1 of the IIR stage (Q14, signed)
+ *          - [7..8]  a1 of the IIR stage (Q14, signed)
+ */
+#define FLT_SETTINGS_RECORD_SIZE                            9
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum FLT_tenuStatus
+{
+  FLT_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  FLT_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  FLT_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  FLT_eSTATUS_INVALID_SETTINGS,                                   //!< A setting is out of its range
+  FLT_eSTATUS_COUNT                                               //!< The total number of return code
+}FLT_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Enum used to list the stages of the filter, in their processing order
+ */
+typedef enum FLT_tenuStage
+{
+  /*-----[ DO NOT EDIT THIS ]----*/
+  FLT_eSTAGE_BEGIN = -1, /*------*/
+  /*-----------------------------*/
+
+  FLT_eSTAGE_MEDIAN,
+  FLT_eSTAGE_EMA,
+  FLT_eSTAGE_IIR,
+
+  /*-----[ DO NOT EDIT THIS ]----*/
+  FLT_eSTAGE_END /*--------------*/
+  /*-----------------------------*/
+}FLT_tenuStage;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to set the runtime settings of the filter
+ */
+typedef struct FLT_tstrSettings
+{
+  uint8_t                                                   u8StageMask;              //!< Enabled stages (Bit n = stage n)
+  uint8_t                                                   u8MedianLength;           //!< Odd window, up to FLT_CONFIG_MEDIAN_MAX_LENGTH
+  uint8_t                                                   u8EmaShift;               //!< alpha = 1 / 2^shift, up to FLT_EMA_MAX_SHIFT
+  int16_t                                                   s16IirB0;                 //!< Q14, between -1.0 and 1.0
+  int16_t                                                   s16IirB1;                 //!< Q14, between -1.0 and 1.0
+  int16_t                                                   s16IirA1;                 //!< Q14, strictly between -1.0 and 1.0 (stability)
+}FLT_tstrSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Callback type definition of a consumer of the filtered values
+ */
+typedef void (*FLT_tpfvidSubscriber)(const int16_t ks16Value);
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the filter with the default settings (see Filter_cfg.h)
+ */
+void FLT_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to register a consumer of the filtered values
+ * @param[in] kpfSubscriber: Pointer to the function called with each filtered value
+ * @return Return "true" if the function ran successfully, return "false" otherwise (NULL pointer, already registered
+ *         or no free slot, see @ref FLT_CONFIG_MAX_SUBSCRIBERS)
+ */
+bool FLT_bSubscribe(const FLT_tpfvidSubscriber kpfSubscriber);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to filter a new sample and to publish the result to the subscribers
+ * @remark The function is not reentrant, it shall be called from a single context
+ * @param[in] ks16Sample: The new sample
+ * @return The filtered value
+ */
+int16_t FLT_s16PushSample(const int16_t ks16Sample);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to restart the filter: the next sample initializes the state of all the stages
+ */
+void FLT_vidReset(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings of the filter, the filter is restarted
+ * @param[in] kpkstrSettings: The new settings (unchanged if one of them is out of its range)
+ * @return The status of the change
+ */
+FLT_tenuStatus FLT_enuSetSettings(FLT_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the runtime settings of the filter
+ * @param[out] kpstrSettings: The current settings
+ * @return The status of the reading
+ */
+FLT_tenuStatus FLT_enuGetSettings(FLT_tstrSettings * const kpstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the runtime settings (see @ref FLT_SETTINGS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t FLT_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings with a record (see @ref FLT_SETTINGS_RECORD_SIZE for the format)
+ * @param kpku8Buffer: Pointer to the record
+ * @param ku16BufferSize: Size of the record
+ * @return The status of the change, @ref FLT_eSTATUS_INVALID_SETTINGS if the size or a setting is wrong
+ */
+FLT_tenuStatus FLT_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // FILTER_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,55 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      History_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     History Tools conf part
+ * @details   Module in charge of the storage of the last samples and of their sliding-window statistics
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef HISTORY_CFG_H_
+#define HISTORY_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the number of stored samples (power of two up to 128), the oldest ones are overwritten
+ * @remark Each sample takes 6 bytes, plus 4 bytes for the min/max deques
+ */
+#define HIS_CONFIG_CAPACITY                                 64
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default number of samples of the statistics window (up to @ref HIS_CONFIG_CAPACITY), it can be
+ *        changed at runtime
+ */
+#define HIS_CONFIG_DEFAULT_WINDOW_LENGTH                    16
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* HISTORY_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,406 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      History.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     History Tools core part
+ * @details   Module in charge of the storage of the last samples and of their sliding-window statistics
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include <string.h>
+#include "TIMER.h"
+#include "History.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((HIS_CONFIG_CAPACITY < 1) || (HIS_CONFIG_CAPACITY > 128) || ((HIS_CONFIG_CAPACITY & (HIS_CONFIG_CAPACITY - 1)) != 0))
+#  error "[HIS ] Error: The setting HIS_CONFIG_CAPACITY must be a power of two up to 128"
+#endif
+
+#if((HIS_CONFIG_DEFAULT_WINDOW_LENGTH < 1) || (HIS_CONFIG_DEFAULT_WINDOW_LENGTH > HIS_CONFIG_CAPACITY))
+#  error "[HIS ] Error: The setting HIS_CONFIG_DEFAULT_WINDOW_LENGTH must be between 1 and HIS_CONFIG_CAPACITY"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#define HIS_INDEX_MASK                                      (HIS_CONFIG_CAPACITY - 1)
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Macro used to get the stored value of a sample given by its sequence number
+ */
+#define HIS_mVALUE(_SEQUENCE_)                              (HIS_astrSamples[(_SEQUENCE_) & HIS_INDEX_MASK].s16Value)
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Structure of a double-ended queue of sample sequence numbers, the values of the queued samples are monotonic
+ *        from the front (extremum of the window) to the back (latest sample)
+ */
+typedef struct HIS_tstrDeque
+{
+  uint16_t                                                  au16Sequences[HIS_CONFIG_CAPACITY];
+  uint8_t                                                   u8Front;
+  uint8_t                                                   u8Count;
+}HIS_tstrDeque;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief The stored samples, in a ring indexed by the sequence number of the samples
+ */
+static HIS_tstrSample HIS_astrSamples[HIS_CONFIG_CAPACITY];
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Sequence number of the next sample and number of stored samples
+ */
+static uint16_t HIS_u16NextSequence                         = 0;
+static uint8_t  HIS_u8StoredCount                           = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the window: its length, its samples count and the running sums of the values and of their squares
+ * @remark The sum of the squares needs 64 Bits (up to 128 squares of 30 Bits)
+ */
+static uint8_t  HIS_u8WindowLength                          = HIS_CONFIG_DEFAULT_WINDOW_LENGTH;
+static uint8_t  HIS_u8WindowCount                           = 0;
+static int32_t  HIS_s32WindowSum                            = 0;
+static uint64_t HIS_u64WindowSquareSum                      = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Monotonic deques of the window: increasing values for the minimum, decreasing values for the maximum
+ */
+static HIS_tstrDeque HIS_strMinDeque;
+static HIS_tstrDeque HIS_strMaxDeque;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to add a stored sample to the window: the sample which left the window leaves the front of the
+ *        deques, the samples which can no more be an extremum leave their back
+ * @details Each sample enters and leaves each deque once, thus the cost is constant on average
+ */
+static void vidAddToWindow(const uint16_t ku16Sequence);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to update a deque with a new sample
+ * @param kbIsMinDeque: "true" for the deque of the minimum, "false" for the deque of the maximum
+ */
+static void vidUpdateDeque(HIS_tstrDeque * const kpstrDeque, const uint16_t ku16Sequence, const bool kbIsMinDeque);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to compute the rounded square root of a 64 Bits value (bit by bit, 32 iterations)
+ */
+static uint32_t u32SquareRoot(const uint64_t ku64Value);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static void vidAddToWindow(const uint16_t ku16Sequence)
+{
+  const int16_t ks16Value = HIS_mVALUE(ku16Sequence);
+
+  HIS_s32WindowSum       += ks16Value;
+  HIS_u64WindowSquareSum += (uint32_t)((int32_t)ks16Value * ks16Value);
+
+  vidUpdateDeque(&HIS_strMinDeque, ku16Sequence, true);
+  vidUpdateDeque(&HIS_strMaxDeque, ku16Sequence, false);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidUpdateDeque(HIS_tstrDeque * const kpstrDeque, const uint16_t ku16Sequence, const bool kbIsMinDeque)
+{
+  const int16_t ks16Value = HIS_mVALUE(ku16Sequence);
+  int16_t       s16Back   = 0;
+  bool          bIsOver   = false;
+
+  // The front leaves the deque when it is no more in the window (at most one sample per new sample), before the push
+  // thus the deque never holds more than the window:
+  if((kpstrDeque->u8Count > 0) &&
+     ((uint16_t)(ku16Sequence - kpstrDeque->au16Sequences[kpstrDeque->u8Front]) >= HIS_u8WindowLength))
+  {
+    kpstrDeque->u8Front = (uint8_t)((kpstrDeque->u8Front + 1) & HIS_INDEX_MASK);
+    kpstrDeque->u8Count--;
+  }
+
+  while((kpstrDeque->u8Count > 0) && (bIsOver == false))
+  {
+    s16Back = HIS_mVALUE(kpstrDeque->au16Sequences[(kpstrDeque->u8Front + kpstrDeque->u8Count - 1) & HIS_INDEX_MASK]);
+
+    if((kbIsMinDeque == true) ? (s16Back >= ks16Value) : (s16Back <= ks16Value))
+    {
+      kpstrDeque->u8Count--;
+    }
+    else
+    {
+      bIsOver = true;
+    }
+  }
+
+  kpstrDeque->au16Sequences[(kpstrDeque->u8Front + kpstrDeque->u8Count) & HIS_INDEX_MASK] = ku16Sequence;
+  kpstrDeque->u8Count++;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static uint32_t u32SquareRoot(const uint64_t ku64Value)
+{
+  uint64_t u64Remainder = ku64Value;
+  uint64_t u64Root      = 0;
+  uint64_t u64Bit       = (1ULL << 62);
+
+  while(u64Bit > u64Remainder)
+  {
+    u64Bit >>= 2;
+  }
+
+  while(u64Bit != 0)
+  {
+    if(u64Remainder >= (u64Root + u64Bit))
+    {
+      u64Remainder -= (u64Root + u64Bit);
+      u64Root       = (u64Root >> 1) + u64Bit;
+    }
+    else
+    {
+      u64Root >>= 1;
+    }
+
+    u64Bit >>= 2;
+  }
+
+  // Rounded to the nearest: (r + 0.5)^2 = r^2 + r + 0.25
+  if(u64Remainder > u64Root)
+  {
+    u64Root++;
+  }
+
+  return (uint32_t)u64Root;
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void HIS_vidInitialize(void)
+{
+  HIS_u16NextSequence = 0;
+  HIS_u8StoredCount   = 0;
+
+  (void)HIS_bSetWindowLength(HIS_CONFIG_DEFAULT_WINDOW_LENGTH);
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void HIS_vidPushSample(const int16_t ks16Value)
+{
+  const uint16_t ku16Sequence = HIS_u16NextSequence;
+  int16_t        s16Oldest    = 0;
+
+  // The oldest sample of a full window leaves the running sums before its slot may be overwritten:
+  if(HIS_u8WindowCount == HIS_u8WindowLength)
+  {
+    s16Oldest               = HIS_mVALUE(ku16Sequence - HIS_u8WindowLength);
+    HIS_s32WindowSum       -= s16Oldest;
+    HIS_u64WindowSquareSum -= (uint32_t)((int32_t)s16Oldest * s16Oldest);
+  }
+  else
+  {
+    HIS_u8WindowCount++;
+  }
+
+  HIS_astrSamples[ku16Sequence & HIS_INDEX_MASK].u32TimestampUs = TIM1_u32GetTimestampUs();
+  HIS_astrSamples[ku16Sequence & HIS_INDEX_MASK].s16Value       = ks16Value;
+
+  vidAddToWindow(ku16Sequence);
+
+  HIS_u16NextSequence++;
+
+  if(HIS_u8StoredCount < HIS_CONFIG_CAPACITY)
+  {
+    HIS_u8StoredCount++;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool HIS_bSetWindowLength(const uint8_t ku8WindowLength)
+{
+  bool     bStatus     = false;
+  uint16_t u16Sequence = 0;
+
+  if((ku8WindowLength >= 1) && (ku8WindowLength <= HIS_CONFIG_CAPACITY))
+  {
+    HIS_u8WindowLength       = ku8WindowLength;
+    HIS_u8WindowCount        = (HIS_u8StoredCount < ku8WindowLength) ? HIS_u8StoredCount : ku8WindowLength;
+    HIS_s32WindowSum         = 0;
+    HIS_u64WindowSquareSum   = 0;
+    HIS_strMinDeque.u8Front  = 0;
+    HIS_strMinDeque.u8Count  = 0;
+    HIS_strMaxDeque.u8Front  = 0;
+    HIS_strMaxDeque.u8Count  = 0;
+
+    // The stored samples of the new window are replayed (only at the configuration, not at the reading):
+    for(u16Sequence = (uint16_t)(HIS_u16NextSequence - HIS_u8WindowCount);
+        u16Sequence != HIS_u16NextSequence;
+        u16Sequence++)
+    {
+      vidAddToWindow(u16Sequence);
+    }
+
+    bStatus = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+HIS_tenuStatus HIS_enuGetStatistics(HIS_tstrStatistics * const kpstrStatistics)
+{
+  HIS_tenuStatus enuStatus   = HIS_eSTATUS_NO_OK;
+  uint32_t       u32Root     = 0;
+  int32_t        s32Count    = 0;
+
+  if(kpstrStatistics == NULL)
+  {
+    enuStatus = HIS_eSTATUS_NULL_POINTER;
+  }
+  else if(HIS_u8WindowCount == 0)
+  {
+    enuStatus = HIS_eSTATUS_NO_SAMPLE;
+  }
+  else
+  {
+    s32Count = HIS_u8WindowCount;
+
+    kpstrStatistics->u8WindowLength       = HIS_u8WindowLength;
+    kpstrStatistics->u8SampleCount        = HIS_u8WindowCount;
+    kpstrStatistics->s16Min               = HIS_mVALUE(HIS_strMinDeque.au16Sequences[HIS_strMinDeque.u8Front]);
+    kpstrStatistics->s16Max               = HIS_mVALUE(HIS_strMaxDeque.au16Sequences[HIS_strMaxDeque.u8Front]);
+    kpstrStatistics->u32OldestTimestampUs =
+      HIS_astrSamples[(HIS_u16NextSequence - HIS_u8WindowCount) & HIS_INDEX_MASK].u32TimestampUs;
+    kpstrStatistics->u32LatestTimestampUs = HIS_astrSamples[(HIS_u16NextSequence - 1) & HIS_INDEX_MASK].u32TimestampUs;
+
+    // Mean rounded half away from zero:
+    kpstrStatistics->s16Mean = (int16_t)((HIS_s32WindowSum >= 0) ? ((HIS_s32WindowSum + (s32Count / 2)) / s32Count) :
+                                                                  ((HIS_s32WindowSum - (s32Count / 2)) / s32Count));
+
+    // Standard deviation = sqrt(n.sum(x^2) - sum(x)^2) / n, the root is taken before the division to keep the precision
+    // of small deviations:
+    u32Root = u32SquareRoot(((uint64_t)s32Count * HIS_u64WindowSquareSum) -
+                            (uint64_t)((int64_t)HIS_s32WindowSum * HIS_s32WindowSum));
+
+    kpstrStatistics->u16StdDev = (uint16_t)((u32Root + (uint32_t)(s32Count / 2)) / (uint32_t)s32Count);
+
+    enuStatus = HIS_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+HIS_tenuStatus HIS_enuGetSample(const uint8_t ku8Age, HIS_tstrSample * const kpstrSample)
+{
+  HIS_tenuStatus enuStatus = HIS_eSTATUS_NO_OK;
+
+  if(kpstrSample == NULL)
+  {
+    enuStatus = HIS_eSTATUS_NULL_POINTER;
+  }
+  else if(ku8Age >= HIS_u8StoredCount)
+  {
+    enuStatus = HIS_eSTATUS_NO_SAMPLE;
+  }
+  else
+  {
+    *kpstrSample = HIS_astrSamples[(HIS_u16NextSequence - 1 - ku8Age) & HIS_INDEX_MASK];
+    enuStatus    = HIS_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t HIS_u8ExportStatistics(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t            u8Size = 0;
+  HIS_tstrStatistics strStatistics;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= HIS_STATISTICS_RECORD_SIZE))
+  {
+    // An empty history gives a record without sample:
+    if(HIS_enuGetStatistics(&strStatistics) != HIS_eSTATUS_OK)
+    {
+      memset(&strStatistics, 0, sizeof(strStatistics));
+      strStatistics.u8WindowLength = HIS_u8WindowLength;
+    }
+
+    kpu8Buffer[0]  = strStatistics.u8WindowLength;
+    kpu8Buffer[1]  = strStatistics.u8SampleCount;
+    kpu8Buffer[2]  = (uint8_t)strStatistics.s16Min;
+    kpu8Buffer[3]  = (uint8_t)((uint16_t)strStatistics.s16Min >> 8);
+    kpu8Buffer[4]  = (uint8_t)strStatistics.s16Max;
+    kpu8Buffer[5]  = (uint8_t)((uint16_t)strStatistics.s16Max >> 8);
+    kpu8Buffer[6]  = (uint8_t)strStatistics.s16Mean;
+    kpu8Buffer[7]  = (uint8_t)((uint16_t)strStatistics.s16Mean >> 8);
+    kpu8Buffer[8]  = (uint8_t)strStatistics.u16StdDev;
+    kpu8Buffer[9]  = (uint8_t)(strStatistics.u16StdDev >> 8);
+    kpu8Buffer[10] = (uint8_t)strStatistics.u32OldestTimestampUs;
+    kpu8Buffer[11] = (uint8_t)(strStatistics.u32OldestTimestampUs >> 8);
+    kpu8Buffer[12] = (uint8_t)(strStatistics.u32OldestTimestampUs >> 16);
+    kpu8Buffer[13] = (uint8_t)(strStatistics.u32OldestTimestampUs >> 24);
+    kpu8Buffer[14] = (uint8_t)strStatistics.u32LatestTimestampUs;
+    kpu8Buffer[15] = (uint8_t)(strStatistics.u32LatestTimestampUs >> 8);
+    kpu8Buffer[16] = (uint8_t)(strStatistics.u32LatestTimestampUs >> 16);
+    kpu8Buffer[17] = (uint8_t)(strStatistics.u32LatestTimestampUs >> 24);
+
+    u8Size = HIS_STATISTICS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
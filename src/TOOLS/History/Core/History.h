@@ -0,0 +1,156 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      History.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     History Tools core part
+ * @details   Module in charge of the storage of the last samples (value and timestamp) and of their sliding-window
+ *            statistics. The statistics are maintained at each new sample (running sums and monotonic deques for the
+ *            min/max), thus their reading does not depend on the window length
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef HISTORY_H_
+#define HISTORY_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "History_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Size of the statistics record exported by @ref HIS_u8ExportStatistics (all fields are little endian):
+ *          - [0]       Window length (samples)
+ *          - [1]       Number of samples in the window
+ *          - [2..3]    Minimum (signed)
+ *          - [4..5]    Maximum (signed)
+ *          - [6..7]    Mean, rounded (signed)
+ *          - [8..9]    Standard deviation, rounded
+ *          - [10..13]  Timestamp of the oldest sample of the window in us (see TIM1_u32GetTimestampUs)
+ *          - [14..17]  Timestamp of the latest sample in us
+ */
+#define HIS_STATISTICS_RECORD_SIZE                          18
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum HIS_tenuStatus
+{
+  HIS_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  HIS_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  HIS_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  HIS_eSTATUS_NO_SAMPLE,                                          //!< The requested sample is not stored
+  HIS_eSTATUS_COUNT                                               //!< The total number of return code
+}HIS_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure of a stored sample
+ */
+typedef struct HIS_tstrSample
+{
+  uint32_t                                                  u32TimestampUs;           //!< Time of the sample (see TIM1_u32GetTimestampUs)
+  int16_t                                                   s16Value;                 //!< Value of the sample
+}HIS_tstrSample;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to report the statistics of the window
+ */
+typedef struct HIS_tstrStatistics
+{
+  uint8_t                                                   u8WindowLength;           //!< Configured window length (samples)
+  uint8_t                                                   u8SampleCount;            //!< Samples in the window (lower while it is being filled)
+  int16_t                                                   s16Min;                   //!< Minimum of the window
+  int16_t                                                   s16Max;                   //!< Maximum of the window
+  int16_t                                                   s16Mean;                  //!< Rounded mean of the window
+  uint16_t                                                  u16StdDev;                //!< Rounded (population) standard deviation of the window
+  uint32_t                                                  u32OldestTimestampUs;     //!< Time of the oldest sample of the window
+  uint32_t                                                  u32LatestTimestampUs;     //!< Time of the latest sample
+}HIS_tstrStatistics;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the history (empty, with the default window length)
+ */
+void HIS_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to store a new sample, timestamped with TIM1, and to update the statistics
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe)
+ * @param[in] ks16Value: The value of the sample
+ */
+void HIS_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the window of the statistics, they are computed again with the stored samples
+ * @param[in] ku8WindowLength: The number of samples of the window, from 1 to @ref HIS_CONFIG_CAPACITY
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool HIS_bSetWindowLength(const uint8_t ku8WindowLength);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the statistics of the window
+ * @param[out] kpstrStatistics: The statistics of the window
+ * @return The status of the reading, @ref HIS_eSTATUS_NO_SAMPLE if the history is empty
+ */
+HIS_tenuStatus HIS_enuGetStatistics(HIS_tstrStatistics * const kpstrStatistics);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to read a stored sample
+ * @param[in]     ku8Age: The age of the sample, 0 for the latest one
+ * @param[out] kpstrSample: The stored sample
+ * @return The status of the reading, @ref HIS_eSTATUS_NO_SAMPLE if the sample is not stored (or overwritten)
+ */
+HIS_tenuStatus HIS_enuGetSample(const uint8_t ku8Age, HIS_tstrSample * const kpstrSample);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the statistics of the window
+ * @details See @ref HIS_STATISTICS_RECORD_SIZE for the format of the record
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small), an empty history gives a record
+ *         without sample
+ */
+uint8_t HIS_u8ExportStatistics(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // HISTORY_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,77 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Report_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Report Tools conf part
+ * @details   Module in charge of the report-on-change (deadband) of the values sent to each output
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef REPORT_CFG_H_
+#define REPORT_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the default deadband in 0.01 degC: a value is reported when it differs from the last reported one by
+ *        at least this delta (0 to report each value)
+ */
+#define RPT_CONFIG_DEFAULT_DELTA                            10
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default maximal silence in s: a value is reported when the last report is older, whatever the
+ *        delta
+ */
+#define RPT_CONFIG_DEFAULT_MAX_SILENCE_S                    10
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enumeration used to declare each output of the values, each of them has its own last reported value and its
+ *        own counters
+ */
+typedef enum RPT_tenuChannel
+{
+  /*-----[DO NOT EDIT/USE THIS]-----*/
+  RPT_eCHANNEL_BEGIN = -1, /*-------*/
+  /*--------------------------------*/
+
+  RPT_eCHANNEL_SERP,
+  RPT_eCHANNEL_DISPLAY,
+
+  /*-------[DO NOT EDIT THIS]-------*/
+  RPT_eCHANNEL_END /*---------------*/
+  /*--------------------------------*/
+}RPT_tenuChannel;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* REPORT_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,293 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Report.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Report Tools core part
+ * @details   Module in charge of the report-on-change (deadband) of the values sent to each output
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "TIMER.h"
+#include "Report.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((RPT_CONFIG_DEFAULT_MAX_SILENCE_S < 1) || (RPT_CONFIG_DEFAULT_MAX_SILENCE_S > RPT_MAX_SILENCE_S))
+#  error "[RPT ] Error: The setting RPT_CONFIG_DEFAULT_MAX_SILENCE_S must be between 1 and RPT_MAX_SILENCE_S"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Conversion of the time units
+ */
+#define RPT_US_PER_S                                        1000000UL
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Structure used to store the state of an output
+ */
+typedef struct RPT_tstrChannel
+{
+  bool                                                      bIsReportForced;          //!< The next value is reported whatever its change
+  int16_t                                                   s16LastValue;             //!< The last reported value
+  uint32_t                                                  u32LastReportUs;          //!< The time of the last report (see TIM1_u32GetTimestampUs)
+  uint32_t                                                  u32ReportedCount;         //!< The number of reported values
+  uint32_t                                                  u32SuppressedCount;       //!< The number of suppressed values
+}RPT_tstrChannel;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Runtime settings of the reports
+ */
+static RPT_tstrSettings RPT_strSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of each output
+ */
+static RPT_tstrChannel RPT_astrChannels[RPT_eCHANNEL_END];
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to check the range of each setting
+ */
+static bool bAreSettingsValid(RPT_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to write a 32 bits counter in a record (little endian)
+ */
+static void vidWriteCounter(uint8_t * const kpu8Buffer, const uint32_t ku32Counter);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bAreSettingsValid(RPT_tstrSettings const * const kpkstrSettings)
+{
+  return ((kpkstrSettings->u16MaxSilenceS >= 1) && (kpkstrSettings->u16MaxSilenceS <= RPT_MAX_SILENCE_S));
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidWriteCounter(uint8_t * const kpu8Buffer, const uint32_t ku32Counter)
+{
+  kpu8Buffer[0] = (uint8_t)ku32Counter;
+  kpu8Buffer[1] = (uint8_t)(ku32Counter >> 8);
+  kpu8Buffer[2] = (uint8_t)(ku32Counter >> 16);
+  kpu8Buffer[3] = (uint8_t)(ku32Counter >> 24);
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void RPT_vidInitialize(void)
+{
+  RPT_tenuChannel enuChannel = RPT_eCHANNEL_BEGIN;
+
+  RPT_strSettings.u16Delta       = RPT_CONFIG_DEFAULT_DELTA;
+  RPT_strSettings.u16MaxSilenceS = RPT_CONFIG_DEFAULT_MAX_SILENCE_S;
+
+  for(enuChannel = (RPT_tenuChannel)(RPT_eCHANNEL_BEGIN + 1); enuChannel < RPT_eCHANNEL_END; enuChannel++)
+  {
+    RPT_astrChannels[enuChannel].bIsReportForced    = true;
+    RPT_astrChannels[enuChannel].u32ReportedCount   = 0;
+    RPT_astrChannels[enuChannel].u32SuppressedCount = 0;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool RPT_bIsReportNeeded(const RPT_tenuChannel kenuChannel, const int16_t ks16Value)
+{
+  const uint32_t  ku32NowUs    = TIM1_u32GetTimestampUs();
+  bool            bIsNeeded    = true;
+  int32_t         s32Change    = 0;
+  RPT_tstrChannel *pstrChannel = NULL;
+
+  if((RPT_eCHANNEL_BEGIN < kenuChannel) && (kenuChannel < RPT_eCHANNEL_END))
+  {
+    pstrChannel = &RPT_astrChannels[kenuChannel];
+    s32Change   = (int32_t)ks16Value - pstrChannel->s16LastValue;
+
+    // Inside the deadband and before the end of the silence, the value is suppressed:
+    if((pstrChannel->bIsReportForced == false) &&
+       (s32Change < (int32_t)RPT_strSettings.u16Delta) && (s32Change > -(int32_t)RPT_strSettings.u16Delta) &&
+       ((ku32NowUs - pstrChannel->u32LastReportUs) < ((uint32_t)RPT_strSettings.u16MaxSilenceS * RPT_US_PER_S)))
+    {
+      bIsNeeded = false;
+      pstrChannel->u32SuppressedCount++;
+    }
+    else
+    {
+      pstrChannel->bIsReportForced = false;
+      pstrChannel->s16LastValue    = ks16Value;
+      pstrChannel->u32LastReportUs = ku32NowUs;
+      pstrChannel->u32ReportedCount++;
+    }
+  }
+
+  return bIsNeeded;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void RPT_vidForceReport(const RPT_tenuChannel kenuChannel)
+{
+  if((RPT_eCHANNEL_BEGIN < kenuChannel) && (kenuChannel < RPT_eCHANNEL_END))
+  {
+    RPT_astrChannels[kenuChannel].bIsReportForced = true;
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+RPT_tenuStatus RPT_enuSetSettings(RPT_tstrSettings const * const kpkstrSettings)
+{
+  RPT_tenuStatus  enuStatus  = RPT_eSTATUS_NO_OK;
+  RPT_tenuChannel enuChannel = RPT_eCHANNEL_BEGIN;
+
+  if(kpkstrSettings == NULL)
+  {
+    enuStatus = RPT_eSTATUS_NULL_POINTER;
+  }
+  else if(bAreSettingsValid(kpkstrSettings) == false)
+  {
+    enuStatus = RPT_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    RPT_strSettings = *kpkstrSettings;
+
+    for(enuChannel = (RPT_tenuChannel)(RPT_eCHANNEL_BEGIN + 1); enuChannel < RPT_eCHANNEL_END; enuChannel++)
+    {
+      RPT_astrChannels[enuChannel].bIsReportForced = true;
+    }
+
+    enuStatus = RPT_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+RPT_tenuStatus RPT_enuGetSettings(RPT_tstrSettings * const kpstrSettings)
+{
+  RPT_tenuStatus enuStatus = RPT_eSTATUS_NO_OK;
+
+  if(kpstrSettings == NULL)
+  {
+    enuStatus = RPT_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrSettings = RPT_strSettings;
+    enuStatus      = RPT_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t RPT_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= RPT_SETTINGS_RECORD_SIZE))
+  {
+    kpu8Buffer[0] = (uint8_t)RPT_strSettings.u16Delta;
+    kpu8Buffer[1] = (uint8_t)(RPT_strSettings.u16Delta >> 8);
+    kpu8Buffer[2] = (uint8_t)RPT_strSettings.u16MaxSilenceS;
+    kpu8Buffer[3] = (uint8_t)(RPT_strSettings.u16MaxSilenceS >> 8);
+
+    u8Size = RPT_SETTINGS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+RPT_tenuStatus RPT_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize)
+{
+  RPT_tenuStatus   enuStatus = RPT_eSTATUS_NO_OK;
+  RPT_tstrSettings strSettings;
+
+  if(kpku8Buffer == NULL)
+  {
+    enuStatus = RPT_eSTATUS_NULL_POINTER;
+  }
+  else if(ku16BufferSize != RPT_SETTINGS_RECORD_SIZE)
+  {
+    enuStatus = RPT_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    strSettings.u16Delta       = (uint16_t)kpku8Buffer[0] | ((uint16_t)kpku8Buffer[1] << 8);
+    strSettings.u16MaxSilenceS = (uint16_t)kpku8Buffer[2] | ((uint16_t)kpku8Buffer[3] << 8);
+
+    enuStatus = RPT_enuSetSettings(&strSettings);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t RPT_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t         u8Size     = 0;
+  RPT_tenuChannel enuChannel = RPT_eCHANNEL_BEGIN;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= RPT_STATUS_RECORD_SIZE))
+  {
+    for(enuChannel = (RPT_tenuChannel)(RPT_eCHANNEL_BEGIN + 1); enuChannel < RPT_eCHANNEL_END; enuChannel++)
+    {
+      vidWriteCounter(&kpu8Buffer[u8Size], RPT_astrChannels[enuChannel].u32ReportedCount);
+      vidWriteCounter(&kpu8Buffer[u8Size + 4], RPT_astrChannels[enuChannel].u32SuppressedCount);
+
+      u8Size += RPT_STATUS_CHANNEL_SIZE;
+    }
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
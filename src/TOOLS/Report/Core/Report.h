@@ -0,0 +1,173 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Report.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Report Tools core part
+ * @details   Module in charge of the report-on-change (deadband) of the values sent to each output (see
+ *            @ref RPT_tenuChannel): a value is reported when it differs from the last reported one by at least the
+ *            delta, or when the maximal silence is over. The reported and suppressed values of each output are counted
+ *            to measure the saved bandwidth
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef REPORT_H_
+#define REPORT_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Report_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Maximal silence in s, the time of the last report is measured with TIM1 (wrap after about 71 min)
+ */
+#define RPT_MAX_SILENCE_S                                   3600
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the settings record used by @ref RPT_u8ExportSettings and @ref RPT_enuImportSettings (all fields are
+ *        little endian):
+ *          - [0..1]  Delta in 0.01 degC (0 to report each value)
+ *          - [2..3]  Maximal silence in s (from 1 up to @ref RPT_MAX_SILENCE_S)
+ */
+#define RPT_SETTINGS_RECORD_SIZE                            4
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the status record exported by @ref RPT_u8ExportStatus, for each output in the order of
+ *        @ref RPT_tenuChannel (all fields are little endian):
+ *          - [0..3]  Number of reported values
+ *          - [4..7]  Number of suppressed values
+ */
+#define RPT_STATUS_CHANNEL_SIZE                             8
+#define RPT_STATUS_RECORD_SIZE                              (RPT_eCHANNEL_END * RPT_STATUS_CHANNEL_SIZE)
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum RPT_tenuStatus
+{
+  RPT_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  RPT_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  RPT_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  RPT_eSTATUS_INVALID_SETTINGS,                                   //!< A setting is out of its range
+  RPT_eSTATUS_COUNT                                               //!< The total number of return code
+}RPT_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to set the runtime settings of the reports
+ */
+typedef struct RPT_tstrSettings
+{
+  uint16_t                                                  u16Delta;                 //!< Change (0.01 degC) reported at once
+  uint16_t                                                  u16MaxSilenceS;           //!< Time after which a value is reported anyway
+}RPT_tstrSettings;
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the reports with the default settings (see Report_cfg.h), the counters are
+ *        cleared and the next value of each output is reported
+ */
+void RPT_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to know whether a value shall be sent to an output
+ * @details A reported value becomes the last reported one of the output, a suppressed one is only counted
+ * @param[in] kenuChannel: The output of the value
+ * @param[in] ks16Value: The value
+ * @return Return "true" if the value shall be reported (always for an unknown output), return "false" otherwise
+ */
+bool RPT_bIsReportNeeded(const RPT_tenuChannel kenuChannel, const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to report the next value of an output whatever its change (output cleared or refreshed)
+ * @param[in] kenuChannel: The output
+ */
+void RPT_vidForceReport(const RPT_tenuChannel kenuChannel);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings of the reports
+ * @details The next value of each output is reported with the new settings
+ * @param[in] kpkstrSettings: The new settings (unchanged if one of them is out of its range)
+ * @return The status of the change
+ */
+RPT_tenuStatus RPT_enuSetSettings(RPT_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the runtime settings of the reports
+ * @param[out] kpstrSettings: The current settings
+ * @return The status of the reading
+ */
+RPT_tenuStatus RPT_enuGetSettings(RPT_tstrSettings * const kpstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the runtime settings (see @ref RPT_SETTINGS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t RPT_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings with a record (see @ref RPT_SETTINGS_RECORD_SIZE for the format)
+ * @param kpku8Buffer: Pointer to the record
+ * @param ku16BufferSize: Size of the record
+ * @return The status of the change, @ref RPT_eSTATUS_INVALID_SETTINGS if the size or a setting is wrong
+ */
+RPT_tenuStatus RPT_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the counters of each output (see @ref RPT_STATUS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t RPT_u8ExportStatus(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // REPORT_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
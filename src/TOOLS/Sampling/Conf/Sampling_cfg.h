@@ -0,0 +1,81 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Sampling_cfg.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Sampling Tools conf part
+ * @details   Module in charge of the adaptive sampling period, driven by the rate of change of the filtered value
+ *
+ * @remark    This file contains only the editable configuration parts
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef SAMPLING_CFG_H_
+#define SAMPLING_CFG_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Common.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Defines the default range of the sampling period in ms: the minimal one is used during the transients, the
+ *        period is doubled up to the maximal one while the signal is stable
+ * @remark The default settings can be evaluated on the host with tools/sampling_sim (samples saved and deviation of
+ *         the plotted curve, compared with a fixed period)
+ */
+#define SMP_CONFIG_DEFAULT_MIN_PERIOD_MS                    250
+#define SMP_CONFIG_DEFAULT_MAX_PERIOD_MS                    1000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default rate of change in 0.01 degC/min above which the signal is in a transient
+ */
+#define SMP_CONFIG_DEFAULT_RATE_THRESHOLD                   100
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default residual in 0.01 degC above which the signal is in a transient: the residual is the
+ *        distance between the raw value and the trend given by the latest rate of change, above the noise of the
+ *        sensor
+ */
+#define SMP_CONFIG_DEFAULT_RESIDUAL_THRESHOLD               20
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the default number of consecutive stable samples before the period is doubled
+ */
+#define SMP_CONFIG_DEFAULT_STABLE_SAMPLES                   4
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Defines the minimal span of the rate of change in ms: the rate is computed again once the span from the
+ *        previous computation reaches it, so that the quantization of the value does not give a large rate
+ */
+#define SMP_CONFIG_RATE_MIN_SPAN_MS                         4000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif /* SAMPLING_CFG_H_ */
+/*--------------------------------------------------------------------------------------------------------------------*/
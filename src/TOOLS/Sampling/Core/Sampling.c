@@ -0,0 +1,437 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Sampling.c
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Sampling Tools core part
+ * @details   Module in charge of the adaptive sampling period, driven by the rate of change of the filtered value
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "TIMER.h"
+#include "Sampling.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+#if((SMP_CONFIG_DEFAULT_MIN_PERIOD_MS < SMP_MIN_PERIOD_MS) || \
+    (SMP_CONFIG_DEFAULT_MAX_PERIOD_MS < SMP_CONFIG_DEFAULT_MIN_PERIOD_MS) || \
+    (SMP_CONFIG_DEFAULT_MAX_PERIOD_MS > SMP_MAX_PERIOD_MS))
+#  error "[SMP ] Error: The default range of the period is wrong"
+#endif
+
+#if((SMP_CONFIG_DEFAULT_STABLE_SAMPLES < 1) || (SMP_CONFIG_DEFAULT_STABLE_SAMPLES > UINT8_MAX))
+#  error "[SMP ] Error: The setting SMP_CONFIG_DEFAULT_STABLE_SAMPLES must be between 1 and 255"
+#endif
+
+#if((SMP_CONFIG_RATE_MIN_SPAN_MS < SMP_MIN_PERIOD_MS) || (SMP_CONFIG_RATE_MIN_SPAN_MS > UINT16_MAX))
+#  error "[SMP ] Error: The setting SMP_CONFIG_RATE_MIN_SPAN_MS is out of range"
+#endif
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Conversion of the time units
+ */
+#define SMP_US_PER_MS                                       1000UL
+#define SMP_MS_PER_CENTISECOND                              10UL
+#define SMP_MS_PER_MINUTE                                   60000L
+#define SMP_CENTISECONDS_PER_MINUTE                         6000L
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Maximal time since the start of the trend used to compute the residual in ms: the product with the rate
+ *        shall fit in 32 bits
+ */
+#define SMP_MAX_TREND_SPAN_MS                               UINT16_MAX
+
+
+/**********************************************************************************************************************/
+/* PRIVATE VARIABLES                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Runtime settings of the policy
+ */
+static SMP_tstrSettings SMP_strSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Consumer of the period changes
+ */
+static SMP_tpfvidPeriodCallback SMP_pfPeriodCallback        = NULL;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief State of the policy: the current period and the number of consecutive stable samples at this period
+ */
+static uint16_t SMP_u16PeriodMs                             = SMP_CONFIG_DEFAULT_MIN_PERIOD_MS;
+static uint8_t  SMP_u8StableCount                           = 0;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Trend of the signal: the sample which starts it (see TIM1_u32GetTimestampUs) and the latest rate of change
+ */
+static bool     SMP_bIsTrendStarted                         = false;
+static int16_t  SMP_s16TrendValue                           = 0;
+static uint32_t SMP_u32TrendStartUs                         = 0;
+static int16_t  SMP_s16Rate                                 = 0;
+static bool     SMP_bIsRateKnown                            = false;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Whether the residual of the latest raw value reached its threshold (cleared by each filtered value)
+ */
+static bool     SMP_bIsResidualHigh                         = false;
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTIONS PROTOTYPES                                                                                       */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to check the range of each setting
+ */
+static bool bAreSettingsValid(SMP_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the value given by the trend at a time (the trend is flat until the rate is known)
+ */
+static int32_t s32GetTrendValue(const uint32_t ku32NowUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to update the trend with a new filtered value
+ * @return Return "true" if the rate of change is over its threshold
+ */
+static bool bUpdateTrend(const int16_t ks16Value, const uint32_t ku32NowUs);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the period and to report it
+ */
+static void vidSetPeriod(const uint16_t ku16PeriodMs);
+
+
+/**********************************************************************************************************************/
+/* PRIVATE FUNCTION DEFINITIONS                                                                                       */
+/**********************************************************************************************************************/
+static bool bAreSettingsValid(SMP_tstrSettings const * const kpkstrSettings)
+{
+  bool bIsValid = true;
+
+  if((kpkstrSettings->u16MinPeriodMs < SMP_MIN_PERIOD_MS) ||
+     (kpkstrSettings->u16MaxPeriodMs < kpkstrSettings->u16MinPeriodMs) ||
+     (kpkstrSettings->u16MaxPeriodMs > SMP_MAX_PERIOD_MS))
+  {
+    bIsValid = false;
+  }
+  else if((kpkstrSettings->u16RateThreshold == 0) || (kpkstrSettings->u16ResidualThreshold == 0))
+  {
+    bIsValid = false;
+  }
+  else if(kpkstrSettings->u8StableSamples == 0)
+  {
+    bIsValid = false;
+  }
+
+  return bIsValid;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static int32_t s32GetTrendValue(const uint32_t ku32NowUs)
+{
+  uint32_t u32SpanMs = (ku32NowUs - SMP_u32TrendStartUs) / SMP_US_PER_MS;
+  int32_t  s32Value  = SMP_s16TrendValue;
+
+  if(SMP_bIsRateKnown == true)
+  {
+    if(u32SpanMs > SMP_MAX_TREND_SPAN_MS)
+    {
+      u32SpanMs = SMP_MAX_TREND_SPAN_MS;
+    }
+
+    s32Value += ((int32_t)SMP_s16Rate * (int32_t)u32SpanMs) / SMP_MS_PER_MINUTE;
+  }
+
+  return s32Value;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static bool bUpdateTrend(const int16_t ks16Value, const uint32_t ku32NowUs)
+{
+  uint32_t u32SpanMs = (ku32NowUs - SMP_u32TrendStartUs) / SMP_US_PER_MS;
+  int32_t  s32Rate   = 0;
+
+  if(SMP_bIsTrendStarted == false)
+  {
+    SMP_bIsTrendStarted = true;
+    SMP_s16TrendValue   = ks16Value;
+    SMP_u32TrendStartUs = ku32NowUs;
+  }
+  else if(u32SpanMs >= SMP_CONFIG_RATE_MIN_SPAN_MS)
+  {
+    // A new rate once its span is long enough, the value starts the next trend:
+    if(u32SpanMs > SMP_MAX_TREND_SPAN_MS)
+    {
+      u32SpanMs = SMP_MAX_TREND_SPAN_MS;
+    }
+
+    s32Rate = (((int32_t)ks16Value - SMP_s16TrendValue) * SMP_CENTISECONDS_PER_MINUTE) /
+              (int32_t)(u32SpanMs / SMP_MS_PER_CENTISECOND);
+
+    if(s32Rate > INT16_MAX)
+    {
+      s32Rate = INT16_MAX;
+    }
+    else if(s32Rate < -INT16_MAX)
+    {
+      s32Rate = -INT16_MAX;
+    }
+
+    SMP_s16Rate         = (int16_t)s32Rate;
+    SMP_bIsRateKnown    = true;
+    SMP_s16TrendValue   = ks16Value;
+    SMP_u32TrendStartUs = ku32NowUs;
+  }
+
+  return ((SMP_bIsRateKnown == true) &&
+          ((SMP_s16Rate >= (int32_t)SMP_strSettings.u16RateThreshold) ||
+           (SMP_s16Rate <= -(int32_t)SMP_strSettings.u16RateThreshold)));
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+static void vidSetPeriod(const uint16_t ku16PeriodMs)
+{
+  SMP_u8StableCount = 0;
+
+  if(ku16PeriodMs != SMP_u16PeriodMs)
+  {
+    SMP_u16PeriodMs = ku16PeriodMs;
+
+    if(SMP_pfPeriodCallback != NULL)
+    {
+      SMP_pfPeriodCallback(ku16PeriodMs);
+    }
+  }
+}
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION DEFINITIONS                                                                                        */
+/**********************************************************************************************************************/
+void SMP_vidInitialize(void)
+{
+  SMP_strSettings.u16MinPeriodMs       = SMP_CONFIG_DEFAULT_MIN_PERIOD_MS;
+  SMP_strSettings.u16MaxPeriodMs       = SMP_CONFIG_DEFAULT_MAX_PERIOD_MS;
+  SMP_strSettings.u16RateThreshold     = SMP_CONFIG_DEFAULT_RATE_THRESHOLD;
+  SMP_strSettings.u16ResidualThreshold = SMP_CONFIG_DEFAULT_RESIDUAL_THRESHOLD;
+  SMP_strSettings.u8StableSamples      = SMP_CONFIG_DEFAULT_STABLE_SAMPLES;
+
+  CMN_assert(bAreSettingsValid(&SMP_strSettings) == true);
+
+  SMP_u16PeriodMs     = SMP_CONFIG_DEFAULT_MIN_PERIOD_MS;
+  SMP_u8StableCount   = 0;
+  SMP_bIsTrendStarted = false;
+  SMP_bIsRateKnown    = false;
+  SMP_bIsResidualHigh = false;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+bool SMP_bRegisterPeriodCbk(const SMP_tpfvidPeriodCallback kpfCallback)
+{
+  bool bStatus = false;
+
+  if(kpfCallback != NULL)
+  {
+    SMP_pfPeriodCallback = kpfCallback;
+    bStatus              = true;
+  }
+
+  return bStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void SMP_vidPushRawSample(const int16_t ks16Value)
+{
+  int32_t s32Residual = 0;
+
+  if(SMP_bIsTrendStarted == true)
+  {
+    s32Residual         = (int32_t)ks16Value - s32GetTrendValue(TIM1_u32GetTimestampUs());
+    SMP_bIsResidualHigh = ((s32Residual >= (int32_t)SMP_strSettings.u16ResidualThreshold) ||
+                           (s32Residual <= -(int32_t)SMP_strSettings.u16ResidualThreshold));
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+void SMP_vidPushSample(const int16_t ks16Value)
+{
+  uint32_t u32PeriodMs  = 0;
+  bool     bIsTransient = SMP_bIsResidualHigh;
+
+  SMP_bIsResidualHigh = false;
+
+  if(bUpdateTrend(ks16Value, TIM1_u32GetTimestampUs()) == true)
+  {
+    bIsTransient = true;
+  }
+
+  if(bIsTransient == true)
+  {
+    // Fast attack: the transient is sampled at once with the minimal period
+    vidSetPeriod(SMP_strSettings.u16MinPeriodMs);
+  }
+  else
+  {
+    SMP_u8StableCount++;
+
+    if(SMP_u8StableCount >= SMP_strSettings.u8StableSamples)
+    {
+      // Slow decay: the period is doubled after each run of stable samples
+      u32PeriodMs = (uint32_t)SMP_u16PeriodMs * 2;
+
+      vidSetPeriod((u32PeriodMs < SMP_strSettings.u16MaxPeriodMs) ? (uint16_t)u32PeriodMs :
+                                                                   SMP_strSettings.u16MaxPeriodMs);
+    }
+  }
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint16_t SMP_u16GetPeriodMs(void)
+{
+  return SMP_u16PeriodMs;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+SMP_tenuStatus SMP_enuSetSettings(SMP_tstrSettings const * const kpkstrSettings)
+{
+  SMP_tenuStatus enuStatus = SMP_eSTATUS_NO_OK;
+
+  if(kpkstrSettings == NULL)
+  {
+    enuStatus = SMP_eSTATUS_NULL_POINTER;
+  }
+  else if(bAreSettingsValid(kpkstrSettings) == false)
+  {
+    enuStatus = SMP_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    SMP_strSettings = *kpkstrSettings;
+    vidSetPeriod(SMP_strSettings.u16MinPeriodMs);
+
+    enuStatus = SMP_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+SMP_tenuStatus SMP_enuGetSettings(SMP_tstrSettings * const kpstrSettings)
+{
+  SMP_tenuStatus enuStatus = SMP_eSTATUS_NO_OK;
+
+  if(kpstrSettings == NULL)
+  {
+    enuStatus = SMP_eSTATUS_NULL_POINTER;
+  }
+  else
+  {
+    *kpstrSettings = SMP_strSettings;
+    enuStatus      = SMP_eSTATUS_OK;
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+uint8_t SMP_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize)
+{
+  uint8_t u8Size = 0;
+
+  if((kpu8Buffer != NULL) && (ku8BufferSize >= SMP_SETTINGS_RECORD_SIZE))
+  {
+    kpu8Buffer[0] = (uint8_t)SMP_strSettings.u16MinPeriodMs;
+    kpu8Buffer[1] = (uint8_t)(SMP_strSettings.u16MinPeriodMs >> 8);
+    kpu8Buffer[2] = (uint8_t)SMP_strSettings.u16MaxPeriodMs;
+    kpu8Buffer[3] = (uint8_t)(SMP_strSettings.u16MaxPeriodMs >> 8);
+    kpu8Buffer[4] = (uint8_t)SMP_strSettings.u16RateThreshold;
+    kpu8Buffer[5] = (uint8_t)(SMP_strSettings.u16RateThreshold >> 8);
+    kpu8Buffer[6] = (uint8_t)SMP_strSettings.u16ResidualThreshold;
+    kpu8Buffer[7] = (uint8_t)(SMP_strSettings.u16ResidualThreshold >> 8);
+    kpu8Buffer[8] = SMP_strSettings.u8StableSamples;
+
+    u8Size = SMP_SETTINGS_RECORD_SIZE;
+  }
+
+  return u8Size;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+SMP_tenuStatus SMP_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize)
+{
+  SMP_tenuStatus   enuStatus = SMP_eSTATUS_NO_OK;
+  SMP_tstrSettings strSettings;
+
+  if(kpku8Buffer == NULL)
+  {
+    enuStatus = SMP_eSTATUS_NULL_POINTER;
+  }
+  else if(ku16BufferSize != SMP_SETTINGS_RECORD_SIZE)
+  {
+    enuStatus = SMP_eSTATUS_INVALID_SETTINGS;
+  }
+  else
+  {
+    strSettings.u16MinPeriodMs       = (uint16_t)kpku8Buffer[0] | ((uint16_t)kpku8Buffer[1] << 8);
+    strSettings.u16MaxPeriodMs       = (uint16_t)kpku8Buffer[2] | ((uint16_t)kpku8Buffer[3] << 8);
+    strSettings.u16RateThreshold     = (uint16_t)kpku8Buffer[4] | ((uint16_t)kpku8Buffer[5] << 8);
+    strSettings.u16ResidualThreshold = (uint16_t)kpku8Buffer[6] | ((uint16_t)kpku8Buffer[7] << 8);
+    strSettings.u8StableSamples      = kpku8Buffer[8];
+
+    enuStatus = SMP_enuSetSettings(&strSettings);
+  }
+
+  return enuStatus;
+}
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,186 @@
+/**
+ ***********************************************************************************************************************
+ * Company: Esme Sudria
+ * Project: Projet Esme
+ *
+ ***********************************************************************************************************************
+ * @file      Sampling.h
+ *
+ * @author    Jean DEBAINS
+ * @date      14/06/2023
+ *
+ * @version   0.0.0
+ *
+ * @brief     Sampling Tools core part
+ * @details   Module in charge of the adaptive sampling period, evaluated on each sample:
+ *              - The rate of change of the filtered values in 0.01 degC/min is computed once its span reaches
+ *                @ref SMP_CONFIG_RATE_MIN_SPAN_MS, the residual is the distance between each raw value and the trend
+ *                given by this rate (the raw value shows a step before the filter)
+ *              - The signal is in a transient when the rate or the residual reaches its threshold: the period falls at
+ *                once to the minimal one
+ *              - The period is doubled, up to the maximal one, after a number of consecutive stable samples
+ *            Each change of the period is reported to the registered callback. The cost of a sample is constant
+ *
+ * @remark    Coding Language: C
+ *
+ * @copyright Copyright (c) 2024 This software is used for education proposal
+ *
+ ***********************************************************************************************************************
+ */
+#ifndef SAMPLING_H_
+#define SAMPLING_H_
+
+
+/**********************************************************************************************************************/
+/* INCLUDE FILES                                                                                                      */
+/**********************************************************************************************************************/
+#include "Sampling_cfg.h"
+
+
+/**********************************************************************************************************************/
+/* CONSTANTS, MACROS                                                                                                  */
+/**********************************************************************************************************************/
+/**
+ * @brief Range of the sampling periods in ms (the conversions of a scan shall fit in the minimal one)
+ */
+#define SMP_MIN_PERIOD_MS                                   10
+#define SMP_MAX_PERIOD_MS                                   60000
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Size of the settings record used by @ref SMP_u8ExportSettings and @ref SMP_enuImportSettings (all fields are
+ *        little endian):
+ *          - [0..1]  Minimal period in ms (from @ref SMP_MIN_PERIOD_MS)
+ *          - [2..3]  Maximal period in ms (from the minimal one up to @ref SMP_MAX_PERIOD_MS)
+ *          - [4..5]  Rate of change threshold, in 0.01 degC/min (not 0)
+ *          - [6..7]  Residual threshold, in 0.01 degC (not 0)
+ *          - [8]     Number of stable samples before the period is doubled (not 0)
+ */
+#define SMP_SETTINGS_RECORD_SIZE                            9
+
+
+/**********************************************************************************************************************/
+/* TYPES                                                                                                              */
+/**********************************************************************************************************************/
+/**
+ * @brief Enum to set the list all error codes
+ */
+typedef enum SMP_tenuStatus
+{
+  SMP_eSTATUS_OK                                            = 0,  //!< Everything is OK
+  SMP_eSTATUS_NO_OK,                                              //!< Generic/default error code
+  SMP_eSTATUS_NULL_POINTER,                                       //!< The passed pointer is NULL
+  SMP_eSTATUS_INVALID_SETTINGS,                                   //!< A setting is out of its range
+  SMP_eSTATUS_COUNT                                               //!< The total number of return code
+}SMP_tenuStatus;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Structure used to set the runtime settings of the sampling policy
+ */
+typedef struct SMP_tstrSettings
+{
+  uint16_t                                                  u16MinPeriodMs;           //!< Period of the transients
+  uint16_t                                                  u16MaxPeriodMs;           //!< Period of a stable signal
+  uint16_t                                                  u16RateThreshold;         //!< Rate (0.01 degC/min) of a transient
+  uint16_t                                                  u16ResidualThreshold;     //!< Distance to the trend (0.01 degC) of a transient
+  uint8_t                                                   u8StableSamples;          //!< Stable samples before the period is doubled
+}SMP_tstrSettings;
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Callback type definition of the consumer of the period changes
+ * @param[in] ku16PeriodMs: The new sampling period in ms
+ */
+typedef void (*SMP_tpfvidPeriodCallback)(const uint16_t ku16PeriodMs);
+
+
+/**********************************************************************************************************************/
+/* PUBLIC FUNCTION PROTOTYPES                                                                                         */
+/**********************************************************************************************************************/
+/**
+ * @brief Function used to initialize the policy with the default settings (see Sampling_cfg.h), the period is the
+ *        minimal one
+ */
+void SMP_vidInitialize(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to register the consumer of the period changes
+ * @param[in] kpfCallback: Pointer to the function called at each change
+ * @return Return "true" if the function ran successfully, return "false" otherwise
+ */
+bool SMP_bRegisterPeriodCbk(const SMP_tpfvidPeriodCallback kpfCallback);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to compute the residual of a raw value, before it is pushed to the filter
+ * @param[in] ks16Value: The raw value of the sample
+ */
+void SMP_vidPushRawSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to evaluate the period with the filtered value of the sample
+ * @remark The signature allows to subscribe directly the function to the filter (see FLT_bSubscribe)
+ * @param[in] ks16Value: The filtered value of the sample
+ */
+void SMP_vidPushSample(const int16_t ks16Value);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the current sampling period
+ * @return The period in ms
+ */
+uint16_t SMP_u16GetPeriodMs(void);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings of the policy
+ * @details The period restarts from the minimal one (reported to the callback if it changes)
+ * @param[in] kpkstrSettings: The new settings (unchanged if one of them is out of its range)
+ * @return The status of the change
+ */
+SMP_tenuStatus SMP_enuSetSettings(SMP_tstrSettings const * const kpkstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to get the runtime settings of the policy
+ * @param[out] kpstrSettings: The current settings
+ * @return The status of the reading
+ */
+SMP_tenuStatus SMP_enuGetSettings(SMP_tstrSettings * const kpstrSettings);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to export the runtime settings (see @ref SMP_SETTINGS_RECORD_SIZE for the format)
+ * @param kpu8Buffer: Pointer to the buffer used to store the record
+ * @param ku8BufferSize: Size of the buffer
+ * @return The number of bytes written in the buffer (0 if the buffer is too small)
+ */
+uint8_t SMP_u8ExportSettings(uint8_t * const kpu8Buffer, const uint8_t ku8BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+/**
+ * @brief Function used to change the runtime settings with a record (see @ref SMP_SETTINGS_RECORD_SIZE for the format)
+ * @param kpku8Buffer: Pointer to the record
+ * @param ku16BufferSize: Size of the record
+ * @return The status of the change, @ref SMP_eSTATUS_INVALID_SETTINGS if the size or a setting is wrong
+ */
+SMP_tenuStatus SMP_enuImportSettings(uint8_t const * const kpku8Buffer, const uint16_t ku16BufferSize);
+
+
+/*--------------------------------------------------------------------------------------------------------------------*/
+#endif // SAMPLING_H_
+/*--------------------------------------------------------------------------------------------------------------------*/
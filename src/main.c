@@ -39,6 +39,7 @@
 #include "EUSART.h"
 #include "I2CM.h"
 #include "GPIO.h"
+#include "NVM.h"
 
 // Add the required includes for the hardware modules here...
 
@@ -48,6 +49,9 @@
 #include "LCD.h"
 #include "MCP9700.h"
 #include "SERP.h"
+#include "NVLog.h"
+#include "Telemetry.h"
+#include "Download.h"
 
 // Add the required includes for the driver modules here...
 
@@ -114,8 +118,10 @@ void main(void)
   EUSART_vidInitialize();
   ADC_vidInitialize();
   TIM0_vidInitialize();
+  TIM1_vidInitialize();
   I2CM_vidInitalize();
   GPIO_init();
+  NVM_vidInitialize();
 
   // Add your initialization function here for the hardware modules...
 
@@ -123,7 +129,11 @@ void main(void)
   /* DRIVER INITIALIZATIONS        */
   /*********************************/
   LCD_vidInitialize();
+  MCP9700_init();
   SERP_vidInitialize();
+  NVL_vidInitialize();
+  TLM_vidInitialize();
+  DWL_vidInitialize();
 
   // Add your initialization function here for the driver modules...
 
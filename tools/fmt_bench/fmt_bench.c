@@ -0,0 +1,184 @@
+/*
+ * Host benchmark of the formatter of TOOLS/Common (Common_fmt.c) against vsnprintf, the formatting path of
+ * CMN_systemPrintf.
+ *
+ * Each formatter is called on the same table of values (temperatures in 0.01 degC, Q8 values, full 32 Bits range)
+ * and the mean time per call is printed, in ns and in TSC cycles on x86. The integer texts of both are compared
+ * before the measure (the Q format, whose ties differ from printf, is checked by tools/host_tests/test_common_fmt.c).
+ * The host figures only give the ratio between both approaches: on the PIC18 the XC8 printf also parses the format
+ * string at run time, with 32 Bits divisions done in software.
+ *
+ * Build and run (from the root of the repository):
+ *     gcc -std=c99 -O2 -Itools/host_tests -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf -Isrc/TOOLS/Common/Port \
+ *         tools/fmt_bench/fmt_bench.c src/TOOLS/Common/Core/Common_fmt.c -o fmt_bench && ./fmt_bench [ITERATIONS]
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Common_fmt.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES()              __rdtsc()
+#else
+#define BENCH_CYCLES()              0ULL
+#endif
+
+#define BENCH_VALUES                256
+#define BENCH_DEFAULT_ITERATIONS    2000
+
+typedef enum
+{
+  BENCH_eSIGNED = 0,
+  BENCH_eDECIMAL,
+  BENCH_eFIXED_POINT,
+  BENCH_eCOUNT
+} tenuBench;
+
+static const char* const kapkcBenchNames[BENCH_eCOUNT] =
+{
+  [BENCH_eSIGNED]      = "signed (%ld)",
+  [BENCH_eDECIMAL]     = "decimal 0.01 (%ld.%02ld)",
+  [BENCH_eFIXED_POINT] = "Q8, 2 decimals (%.2f)",
+};
+
+static int32_t as32Values[BENCH_VALUES];
+
+/* Sink of the lengths of the formatted texts, so that the calls are not removed by the optimizer */
+static volatile unsigned uSink = 0;
+
+
+static int iVsnprintf(char * const kps8Buffer, const size_t ksSize, char const * const kpkcFormat, ...)
+{
+  va_list vaArguments;
+  int     iLength;
+
+  va_start(vaArguments, kpkcFormat);
+  iLength = vsnprintf(kps8Buffer, ksSize, kpkcFormat, vaArguments);
+  va_end(vaArguments);
+
+  return iLength;
+}
+
+
+static void vidFormatCommon(const tenuBench kenuBench, char * const kps8Buffer, const int32_t ks32Value)
+{
+  switch(kenuBench)
+  {
+    case BENCH_eSIGNED:
+      uSink += CMN_u8FormatSigned(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, ks32Value);
+      break;
+    case BENCH_eDECIMAL:
+      uSink += CMN_u8FormatDecimal(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, ks32Value, 2);
+      break;
+    default:
+      uSink += CMN_u8FormatFixedPoint(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, ks32Value, 8, 2);
+      break;
+  }
+}
+
+
+static void vidFormatPrintf(const tenuBench kenuBench, char * const kps8Buffer, const int32_t ks32Value)
+{
+  const long klMagnitude = labs((long)ks32Value);
+
+  switch(kenuBench)
+  {
+    case BENCH_eSIGNED:
+      uSink += (unsigned)iVsnprintf(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, "%ld", (long)ks32Value);
+      break;
+    case BENCH_eDECIMAL:
+      uSink += (unsigned)iVsnprintf(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, "%s%ld.%02ld",
+                                    (ks32Value < 0) ? "-" : "", klMagnitude / 100, klMagnitude % 100);
+      break;
+    default:
+      uSink += (unsigned)iVsnprintf(kps8Buffer, CMN_FMT_FIXED_POINT_BUFFER_SIZE, "%.2f", ks32Value / 256.0);
+      break;
+  }
+}
+
+
+static double dNowNs(void)
+{
+  struct timespec strTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &strTime);
+
+  return ((double)strTime.tv_sec * 1e9) + (double)strTime.tv_nsec;
+}
+
+
+/* Mean time of one call in ns and in cycles */
+static void vidMeasure(void (*pfvidFormat)(const tenuBench, char * const, const int32_t), const tenuBench kenuBench,
+                       const unsigned kuIterations, double * const kpdNs, double * const kpdCycles)
+{
+  char                     as8Text[CMN_FMT_FIXED_POINT_BUFFER_SIZE];
+  const double             kdStartNs       = dNowNs();
+  const unsigned long long kullStartCycles = BENCH_CYCLES();
+  unsigned                 uIteration;
+  unsigned                 uIdx;
+
+  for(uIteration = 0; uIteration < kuIterations; uIteration++)
+  {
+    for(uIdx = 0; uIdx < BENCH_VALUES; uIdx++)
+    {
+      pfvidFormat(kenuBench, as8Text, as32Values[uIdx]);
+    }
+  }
+
+  *kpdCycles = (double)(BENCH_CYCLES() - kullStartCycles) / ((double)kuIterations * BENCH_VALUES);
+  *kpdNs     = (dNowNs() - kdStartNs) / ((double)kuIterations * BENCH_VALUES);
+}
+
+
+int main(int argc, char* argv[])
+{
+  const unsigned kuIterations = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_ITERATIONS;
+  char           as8Common[CMN_FMT_FIXED_POINT_BUFFER_SIZE];
+  char           as8Printf[CMN_FMT_FIXED_POINT_BUFFER_SIZE];
+  uint32_t       u32State    = 1;
+  unsigned       uMismatches = 0;
+  double         dCommonNs, dCommonCycles, dPrintfNs, dPrintfCycles;
+  unsigned       uIdx;
+  tenuBench      enuBench;
+
+  /* A quarter of sensor temperatures (-40.00..125.00 degC), the others of every magnitude, both signs */
+  for(uIdx = 0; uIdx < BENCH_VALUES; uIdx++)
+  {
+    u32State         = (u32State * 1103515245u) + 12345u;
+    as32Values[uIdx] = ((uIdx % 4) == 0) ? (int32_t)((u32State >> 8) % 16501) - 4000 :
+                                            (int32_t)(u32State ^ (u32State << 7)) >> ((u32State >> 27) & 0x1F);
+  }
+
+  printf("%-26s %12s %12s %12s %12s %8s\n", "format", "Common ns", "printf ns", "Common cyc", "printf cyc", "ratio");
+
+  for(enuBench = BENCH_eSIGNED; enuBench < BENCH_eCOUNT; enuBench++)
+  {
+    for(uIdx = 0; uIdx < BENCH_VALUES; uIdx++)
+    {
+      vidFormatCommon(enuBench, as8Common, as32Values[uIdx]);
+      vidFormatPrintf(enuBench, as8Printf, as32Values[uIdx]);
+
+      /* Ties and negative zeros of the Q format are not compared (see tools/host_tests/test_common_fmt.c) */
+      if((strcmp(as8Common, as8Printf) != 0) && (enuBench != BENCH_eFIXED_POINT))
+      {
+        printf("mismatch %s: %s / %s\n", kapkcBenchNames[enuBench], as8Common, as8Printf);
+        uMismatches++;
+      }
+    }
+
+    vidMeasure(vidFormatCommon, enuBench, kuIterations, &dCommonNs, &dCommonCycles);
+    vidMeasure(vidFormatPrintf, enuBench, kuIterations, &dPrintfNs, &dPrintfCycles);
+
+    printf("%-26s %12.1f %12.1f %12.0f %12.0f %8.2f\n", kapkcBenchNames[enuBench], dCommonNs, dPrintfNs,
+           dCommonCycles, dPrintfCycles, dPrintfNs / dCommonNs);
+  }
+
+  printf("(%u calls per measure)\n", kuIterations * BENCH_VALUES);
+
+  return (uMismatches != 0) ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Minimal support of the host tests of tools/host_tests: the checks are counted, each failure is printed with its
+ * location and the test returns the number of failures (0 = passed) from main().
+ */
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+static unsigned HT_uChecks   = 0;
+static unsigned HT_uFailures = 0;
+
+#define HT_CHECK(_COND_, ...)                                                                                          \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    HT_uChecks++;                                                                                                      \
+    if(!(_COND_))                                                                                                      \
+    {                                                                                                                  \
+      HT_uFailures++;                                                                                                  \
+      printf("FAIL %s:%d: %s: ", __FILE__, __LINE__, #_COND_);                                                         \
+      printf(__VA_ARGS__);                                                                                             \
+      printf("\n");                                                                                                    \
+    }                                                                                                                  \
+  }while(0)
+
+#define HT_RESULT(_NAME_)                                                                                              \
+  (printf("%s: %u checks, %u failures\n", (_NAME_), HT_uChecks, HT_uFailures), (int)(HT_uFailures != 0))
+
+/* Stand-in of the assert handler of TOOLS/Common: an assert raised by the code under test is a failure */
+void CMN_vidManageAssert(const bool kbCondition, const uint16_t ku16Line, char const * const kpkcFile,
+                         char const * const kpkcFunction)
+{
+  (void)kpkcFunction;
+
+  HT_uChecks++;
+
+  if(!kbCondition)
+  {
+    HT_uFailures++;
+    printf("FAIL assert %s:%u\n", kpkcFile, ku16Line);
+  }
+}
+
+#endif /* HOST_TEST_H_ */
@@ -0,0 +1,21 @@
+#!/bin/sh
+# Builds and runs the host tests of tools/host_tests (from any directory), stops at the first failing test.
+# Each test lists the modules of src/ it compiles; the build command of a test is also given in its header.
+set -e
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+OUT=${OUT:-$(mktemp -d)}
+INCLUDES="-I$ROOT/tools/host_tests $(find "$ROOT/src" -type d | sed 's/^/-I/')"
+
+run()
+{
+  name=$1
+  shift
+  gcc -std=c99 -Wall -Wextra -Wno-unused-parameter -Wno-ignored-qualifiers $INCLUDES "$ROOT/tools/host_tests/$name.c" "$@" -lm -o "$OUT/$name"
+  "$OUT/$name"
+}
+
+run test_filter "$ROOT/src/TOOLS/Filter/Core/Filter.c"
+run test_i2cm "$ROOT/src/HARDWARE/I2CM/Core/I2CM.c"
+run test_mcp9700 "$ROOT/src/DRIVERS/MCP9700/Core/MCP9700.c" "$ROOT/src/DRIVERS/MCP9700/Conf/MCP9700_cfg.c"
+run test_common_fmt "$ROOT/src/TOOLS/Common/Core/Common_fmt.c"
@@ -0,0 +1,219 @@
+/*
+ * Host test of the formatter of TOOLS/Common (Common_fmt.c) against the snprintf of the host C library.
+ *
+ * The values are the limits of the 32 Bits types (INT32_MIN included), the powers of ten and their neighbours, and a
+ * deterministic pseudo-random sweep:
+ *   - CMN_u8FormatUnsigned / CMN_u8FormatSigned: same text as "%lu" / "%ld",
+ *   - CMN_u8FormatDecimal: same text as "%ld.%0*lu" built from the quotient and the remainder by 10^decimals,
+ *   - CMN_u8FormatFixedPoint (Q0 to Q16, 0 to 4 decimals): same text as "%.*f" of the exact value, except on the two
+ *     documented differences: a tie is rounded away from zero (not to even) and a value rounded to zero has no sign,
+ *   - the texts fit in CMN_FMT_BUFFER_SIZE (CMN_FMT_FIXED_POINT_BUFFER_SIZE for the Q format), a buffer too small or
+ *     parameters out of range give 0 and an empty text.
+ *
+ * Build and run (from the root of the repository):
+ *     gcc -std=c99 -Wall -Itools/host_tests -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf \
+ *         -Isrc/TOOLS/Common/Port tools/host_tests/test_common_fmt.c src/TOOLS/Common/Core/Common_fmt.c \
+ *         -o test_common_fmt && ./test_common_fmt
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "Common_fmt.h"
+
+#define FMT_TEST_RANDOM_VALUES      20000
+
+static uint32_t u32State = 1;
+
+
+/* Deterministic 32 Bits values: the upper halves of two steps of a linear congruential generator */
+static uint32_t u32Random(void)
+{
+  uint32_t u32High;
+
+  u32State = (u32State * 1103515245u) + 12345u;
+  u32High  = u32State >> 16;
+  u32State = (u32State * 1103515245u) + 12345u;
+
+  return (u32High << 16) | (u32State >> 16);
+}
+
+
+/* Values of interest: limits, powers of ten and their neighbours, both signs */
+static uint32_t u32EdgeValue(const unsigned kuIdx)
+{
+  static const uint32_t kau32Values[] =
+  {
+    0, 1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 99999, 100000, 999999, 1000000, 9999999, 10000000, 99999999,
+    100000000, 999999999, 1000000000, 2147483647u, 2147483648u, 4294967295u
+  };
+
+  return kau32Values[kuIdx % (sizeof(kau32Values) / sizeof(kau32Values[0]))];
+}
+
+#define FMT_TEST_EDGE_VALUES        23
+
+
+static void vidCheckInteger(const uint32_t ku32Value)
+{
+  const int32_t ks32Value = (int32_t)ku32Value;
+  char          as8Text[CMN_FMT_BUFFER_SIZE];
+  char          as8Reference[32];
+  uint8_t       u8Length;
+
+  u8Length = CMN_u8FormatUnsigned(as8Text, sizeof(as8Text), ku32Value);
+  snprintf(as8Reference, sizeof(as8Reference), "%lu", (unsigned long)ku32Value);
+  HT_CHECK((strcmp(as8Text, as8Reference) == 0) && (u8Length == strlen(as8Reference)), "unsigned %s (%u): %s",
+           as8Reference, u8Length, as8Text);
+
+  u8Length = CMN_u8FormatSigned(as8Text, sizeof(as8Text), ks32Value);
+  snprintf(as8Reference, sizeof(as8Reference), "%ld", (long)ks32Value);
+  HT_CHECK((strcmp(as8Text, as8Reference) == 0) && (u8Length == strlen(as8Reference)), "signed %s (%u): %s",
+           as8Reference, u8Length, as8Text);
+
+  /* One character less than needed: refused */
+  u8Length = CMN_u8FormatSigned(as8Text, (uint8_t)strlen(as8Reference), ks32Value);
+  HT_CHECK((u8Length == 0) && (as8Text[0] == '\0'), "signed %s in %u characters: %s", as8Reference,
+           (unsigned)strlen(as8Reference), as8Text);
+}
+
+
+static void vidCheckDecimal(const int32_t ks32Value, const uint8_t ku8Decimals)
+{
+  const int64_t ks64Magnitude = llabs((long long)ks32Value);
+  int64_t       s64Scale      = 1;
+  char          as8Text[CMN_FMT_BUFFER_SIZE];
+  char          as8Reference[32];
+  uint8_t       u8Length;
+  uint8_t       u8Idx;
+
+  for(u8Idx = 0; u8Idx < ku8Decimals; u8Idx++)
+  {
+    s64Scale *= 10;
+  }
+
+  if(ku8Decimals == 0)
+  {
+    snprintf(as8Reference, sizeof(as8Reference), "%ld", (long)ks32Value);
+  }
+  else
+  {
+    snprintf(as8Reference, sizeof(as8Reference), "%s%lld.%0*lld", (ks32Value < 0) ? "-" : "",
+             (long long)(ks64Magnitude / s64Scale), (int)(ku8Decimals % CMN_FMT_MAX_DIGITS),
+             (long long)(ks64Magnitude % s64Scale));
+  }
+
+  u8Length = CMN_u8FormatDecimal(as8Text, sizeof(as8Text), ks32Value, ku8Decimals);
+  HT_CHECK((strcmp(as8Text, as8Reference) == 0) && (u8Length == strlen(as8Reference)), "decimal %ld/10^%u: %s, got %s",
+           (long)ks32Value, ku8Decimals, as8Reference, as8Text);
+}
+
+
+static void vidCheckFixedPoint(const int32_t ks32Value, const uint8_t ku8FractionalBits, const uint8_t ku8Decimals)
+{
+  const uint64_t ku64Magnitude = (uint64_t)llabs((long long)ks32Value);
+  const uint64_t ku64Fraction  = ku64Magnitude & ((1ULL << ku8FractionalBits) - 1);
+  uint64_t       u64Scale      = 1;
+  bool           bTie          = false;
+  char           as8Text[CMN_FMT_FIXED_POINT_BUFFER_SIZE];
+  char           as8Reference[48];
+  double         dValue;
+  uint8_t        u8Length;
+  uint8_t        u8Idx;
+
+  for(u8Idx = 0; u8Idx < ku8Decimals; u8Idx++)
+  {
+    u64Scale *= 10;
+  }
+
+  /* A tie is exactly half a unit of the last decimal: moved by a quarter of unit away from zero before the rounding */
+  if(ku8FractionalBits > 0)
+  {
+    bTie = (((ku64Fraction * u64Scale) & ((1ULL << ku8FractionalBits) - 1)) == (1ULL << (ku8FractionalBits - 1)));
+  }
+
+  dValue = (double)ks32Value / (double)(1ULL << ku8FractionalBits);
+
+  if(bTie)
+  {
+    dValue += ((ks32Value < 0) ? -0.25 : 0.25) / (double)u64Scale;
+  }
+
+  snprintf(as8Reference, sizeof(as8Reference), "%.*f", (int)ku8Decimals, dValue);
+
+  /* No negative zero */
+  if((as8Reference[0] == '-') && (strspn(&as8Reference[1], "0.") == strlen(&as8Reference[1])))
+  {
+    memmove(as8Reference, &as8Reference[1], strlen(as8Reference));
+  }
+
+  u8Length = CMN_u8FormatFixedPoint(as8Text, sizeof(as8Text), ks32Value, ku8FractionalBits, ku8Decimals);
+  HT_CHECK((strcmp(as8Text, as8Reference) == 0) && (u8Length == strlen(as8Reference)),
+           "fixed point %ld Q%u, %u decimals%s: %s, got %s", (long)ks32Value, ku8FractionalBits, ku8Decimals,
+           bTie ? " (tie)" : "", as8Reference, as8Text);
+}
+
+
+int main(void)
+{
+  char     as8Text[CMN_FMT_BUFFER_SIZE];
+  uint32_t u32Value;
+  unsigned uIdx;
+  uint8_t  u8Decimals;
+  uint8_t  u8Bits;
+
+  for(uIdx = 0; uIdx < (2 * FMT_TEST_EDGE_VALUES) + FMT_TEST_RANDOM_VALUES; uIdx++)
+  {
+    if(uIdx < (2 * FMT_TEST_EDGE_VALUES))
+    {
+      /* Each edge value, then its opposite (INT32_MIN is reached from 2147483648) */
+      u32Value = u32EdgeValue(uIdx / 2);
+      u32Value = ((uIdx % 2) == 0) ? u32Value : (uint32_t)(0u - u32Value);
+    }
+    else
+    {
+      /* Random magnitudes of every size */
+      u32Value = u32Random() >> (u32Random() % 32);
+      u32Value = ((u32Random() % 2) == 0) ? u32Value : (uint32_t)(0u - u32Value);
+    }
+
+    vidCheckInteger(u32Value);
+
+    for(u8Decimals = 0; u8Decimals < CMN_FMT_MAX_DIGITS; u8Decimals++)
+    {
+      vidCheckDecimal((int32_t)u32Value, u8Decimals);
+    }
+
+    for(u8Bits = 0; u8Bits <= CMN_FMT_MAX_FRACTIONAL_BITS; u8Bits++)
+    {
+      for(u8Decimals = 0; u8Decimals <= CMN_FMT_MAX_FIXED_POINT_DECIMALS; u8Decimals++)
+      {
+        vidCheckFixedPoint((int32_t)u32Value, u8Bits, u8Decimals);
+      }
+    }
+  }
+
+  /* Ties of the Q format and carries into the integer part */
+  vidCheckFixedPoint(1, 1, 0);          /* 0.5     -> "1" */
+  vidCheckFixedPoint(-5, 1, 0);         /* -2.5    -> "-3" */
+  vidCheckFixedPoint(0x0028, 4, 1);     /* 2.5     -> "2.5" */
+  vidCheckFixedPoint(0x0002, 3, 1);     /* 0.25    -> "0.3" */
+  vidCheckFixedPoint(-0x0002, 3, 1);    /* -0.25   -> "-0.3" */
+  vidCheckFixedPoint(0x0FFFF, 16, 4);   /* 0.99998 -> "1.0000" */
+  vidCheckFixedPoint(-1, 16, 4);        /* -0.00002 -> "0.0000" */
+  vidCheckFixedPoint(INT32_MIN, 16, 4);
+  vidCheckFixedPoint(INT32_MAX, 16, 4);
+
+  /* Out of range */
+  strcpy(as8Text, "x");
+  HT_CHECK((CMN_u8FormatFixedPoint(as8Text, sizeof(as8Text), 1, CMN_FMT_MAX_FRACTIONAL_BITS + 1, 0) == 0) &&
+           (as8Text[0] == '\0'), "fractional bits out of range accepted");
+  strcpy(as8Text, "x");
+  HT_CHECK((CMN_u8FormatFixedPoint(as8Text, sizeof(as8Text), 1, 8, CMN_FMT_MAX_FIXED_POINT_DECIMALS + 1) == 0) &&
+           (as8Text[0] == '\0'), "decimals out of range accepted");
+  strcpy(as8Text, "x");
+  HT_CHECK((CMN_u8FormatDecimal(as8Text, sizeof(as8Text), 1, CMN_FMT_MAX_DIGITS) == 0) && (as8Text[0] == '\0'),
+           "decimals out of range accepted");
+  HT_CHECK(CMN_u8FormatSigned(NULL, 0, 1) == 0, "NULL buffer accepted");
+
+  return HT_RESULT("test_common_fmt");
+}
@@ -0,0 +1,192 @@
+/*
+ * Host test of TOOLS/Filter against a double-precision reference.
+ *
+ * Each stage is enabled alone and fed with noisy ramps, steps and isolated spikes:
+ *   - median: exact, also while the window is being filled (median of the received samples),
+ *   - EMA (alpha = 1/2^k): within FLT_TEST_EMA_BOUND LSB of y = y + (x - y) / 2^k,
+ *   - IIR (Q14 coefficients): within FLT_TEST_IIR_BOUND LSB of y = b0.x + b1.x[-1] - a1.y[-1],
+ *   - the default chain (median then EMA) removes an isolated spike completely.
+ * Both references start in the steady state of the first sample, like the module.
+ *
+ * Build and run (from the root of the repository):
+ *     gcc -std=c99 -Wall -Itools/host_tests -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf \
+ *         -Isrc/TOOLS/Common/Port -Isrc/TOOLS/Filter/Core -Isrc/TOOLS/Filter/Conf tools/host_tests/test_filter.c \
+ *         src/TOOLS/Filter/Core/Filter.c -lm -o test_filter && ./test_filter
+ */
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "Filter.h"
+
+#define FLT_TEST_SAMPLES            5000
+#define FLT_TEST_EMA_BOUND          1.2
+#define FLT_TEST_IIR_BOUND          0.9
+
+static int16_t as16Input[FLT_TEST_SAMPLES];
+
+
+/* Deterministic input: ramps and steps in 0.01 degC, uniform noise and a spike every 97 samples */
+static void vidBuildInput(void)
+{
+  uint32_t u32State = 1;
+  int      iIdx     = 0;
+  double   dValue   = 0;
+
+  for(iIdx = 0; iIdx < FLT_TEST_SAMPLES; iIdx++)
+  {
+    u32State = (u32State * 1103515245u) + 12345u;
+    dValue   = 2200 + ((iIdx % 1000) < 500 ? (iIdx % 1000) : 1000 - (iIdx % 1000)) + (((iIdx / 1250) % 2) * 1500);
+    dValue  += (double)((u32State >> 16) % 41) - 20;
+
+    if((iIdx % 97) == 50)
+    {
+      dValue += ((iIdx / 97) % 2) ? 3000 : -3000;
+    }
+
+    as16Input[iIdx] = (int16_t)dValue;
+  }
+}
+
+
+static void vidSetStage(const FLT_tenuStage kenuStage, const uint8_t ku8MedianLength, const uint8_t ku8EmaShift,
+                        const int16_t ks16B0, const int16_t ks16B1, const int16_t ks16A1)
+{
+  FLT_tstrSettings strSettings;
+
+  strSettings.u8StageMask    = (uint8_t)(1 << kenuStage);
+  strSettings.u8MedianLength = ku8MedianLength;
+  strSettings.u8EmaShift     = ku8EmaShift;
+  strSettings.s16IirB0       = ks16B0;
+  strSettings.s16IirB1       = ks16B1;
+  strSettings.s16IirA1       = ks16A1;
+
+  HT_CHECK(FLT_enuSetSettings(&strSettings) == FLT_eSTATUS_OK, "stage %d", kenuStage);
+}
+
+
+static int iCompareInt16(const void *pkvLeft, const void *pkvRight)
+{
+  return *(const int16_t *)pkvLeft - *(const int16_t *)pkvRight;
+}
+
+
+static void vidTestMedian(const uint8_t ku8Length)
+{
+  int16_t as16Window[FLT_CONFIG_MEDIAN_MAX_LENGTH];
+  int     iIdx    = 0;
+  int     iCount  = 0;
+  int16_t s16Out  = 0;
+  int     iErrors = 0;
+
+  vidSetStage(FLT_eSTAGE_MEDIAN, ku8Length, 0, 0, 0, 0);
+
+  for(iIdx = 0; iIdx < FLT_TEST_SAMPLES; iIdx++)
+  {
+    s16Out = FLT_s16PushSample(as16Input[iIdx]);
+    iCount = (iIdx + 1 < ku8Length) ? (iIdx + 1) : ku8Length;
+    memcpy(as16Window, &as16Input[iIdx + 1 - iCount], iCount * sizeof(int16_t));
+    qsort(as16Window, iCount, sizeof(int16_t), iCompareInt16);
+
+    if(s16Out != as16Window[iCount / 2])
+    {
+      iErrors++;
+    }
+  }
+
+  HT_CHECK(iErrors == 0, "median %u: %d samples differ from the reference", ku8Length, iErrors);
+}
+
+
+static void vidTestEma(const uint8_t ku8Shift)
+{
+  const double kdAlpha = 1.0 / (double)(1L << ku8Shift);
+  double       dRef    = as16Input[0];
+  double       dMax    = 0;
+  int          iIdx    = 0;
+
+  vidSetStage(FLT_eSTAGE_EMA, 1, ku8Shift, 0, 0, 0);
+
+  for(iIdx = 0; iIdx < FLT_TEST_SAMPLES; iIdx++)
+  {
+    dRef = (iIdx == 0) ? as16Input[0] : (dRef + ((as16Input[iIdx] - dRef) * kdAlpha));
+    dMax = fmax(dMax, fabs(FLT_s16PushSample(as16Input[iIdx]) - dRef));
+  }
+
+  HT_CHECK(dMax <= FLT_TEST_EMA_BOUND, "EMA shift %u: max error %.2f LSB", ku8Shift, dMax);
+}
+
+
+static void vidTestIir(const int16_t ks16B0, const int16_t ks16B1, const int16_t ks16A1)
+{
+  const double kdB0   = ks16B0 / (double)FLT_IIR_COEFFICIENT_ONE;
+  const double kdB1   = ks16B1 / (double)FLT_IIR_COEFFICIENT_ONE;
+  const double kdA1   = ks16A1 / (double)FLT_IIR_COEFFICIENT_ONE;
+  double       dIn    = as16Input[0];
+  double       dRef   = as16Input[0];
+  double       dMax   = 0;
+  int          iIdx   = 0;
+
+  vidSetStage(FLT_eSTAGE_IIR, 1, 0, ks16B0, ks16B1, ks16A1);
+
+  // Steady state of the first sample for a unity DC gain (b0 + b1 = 1 + a1), as the module assumes:
+  for(iIdx = 0; iIdx < FLT_TEST_SAMPLES; iIdx++)
+  {
+    if(iIdx > 0)
+    {
+      dRef = (kdB0 * as16Input[iIdx]) + (kdB1 * dIn) - (kdA1 * dRef);
+    }
+
+    dIn  = as16Input[iIdx];
+    dMax = fmax(dMax, fabs(FLT_s16PushSample(as16Input[iIdx]) - dRef));
+  }
+
+  HT_CHECK(dMax <= FLT_TEST_IIR_BOUND, "IIR %d %d %d: max error %.2f LSB", ks16B0, ks16B1, ks16A1, dMax);
+}
+
+
+static void vidTestSpikeRejection(void)
+{
+  int     iIdx   = 0;
+  int16_t s16Out = 0;
+  bool    bSame  = true;
+
+  FLT_vidInitialize();
+
+  for(iIdx = 0; iIdx < 200; iIdx++)
+  {
+    // Isolated spikes of +-30 degC on a constant input, further apart than the median window:
+    s16Out = FLT_s16PushSample(((iIdx % 10) == 5) ? (((iIdx / 10) % 2) ? 5200 : -800) : 2200);
+    bSame  = bSame && (s16Out == 2200);
+  }
+
+  HT_CHECK(bSame, "default chain: an isolated spike reached the output (last %d)", s16Out);
+}
+
+
+int main(void)
+{
+  uint8_t u8Param = 0;
+
+  vidBuildInput();
+  FLT_vidInitialize();
+
+  for(u8Param = 1; u8Param <= FLT_CONFIG_MEDIAN_MAX_LENGTH; u8Param += 2)
+  {
+    vidTestMedian(u8Param);
+  }
+
+  for(u8Param = 0; u8Param <= 8; u8Param++)
+  {
+    vidTestEma(u8Param);
+  }
+
+  vidTestIir(FLT_CONFIG_DEFAULT_IIR_B0, FLT_CONFIG_DEFAULT_IIR_B1, FLT_CONFIG_DEFAULT_IIR_A1);
+  vidTestIir(4096, 4096, -8192);
+  vidTestIir(1024, 0, -15360);
+  vidTestIir(16384, 0, 0);
+
+  vidTestSpikeRejection();
+
+  return HT_RESULT("test_filter");
+}
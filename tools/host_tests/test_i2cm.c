@@ -0,0 +1,365 @@
+/*
+ * Host failure-injection test of HARDWARE/I2CM: timeouts of the bus phases and bus recovery.
+ *
+ * The MSSP1 is simulated on each access of PIR3bits: a pending phase (SEN, RSEN, PEN, RCEN, ACKEN or a byte written
+ * in SSP1BUF) completes at once and sets SSP1IF, except the phase selected by the scenario which never completes.
+ * The delays of the module advance a simulated clock, the bus lines follow the TRIS/LAT bits of RB1/RB2 while the
+ * pins are given to the latches and the slave may hold SDA (or SCL) low. For each hung phase the test checks:
+ *   - the status of the phase and the stall: exactly the computed timeout in polls of 1 us,
+ *   - the recovery: SCL pulses until SDA is released (9 at most), then a STOP (SDA rising while SCL is high),
+ *   - the re-init of the MSSP1 (PPS back to SCL1/SDA1, enabled in I2C master mode),
+ *   - the timeout, recovery and recovery failure counters.
+ *
+ * Build and run (from the root of the repository):
+ *     gcc -std=c99 -Wall -Itools/host_tests -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf \
+ *         -Isrc/TOOLS/Common/Port -Isrc/HARDWARE/I2CM/Core -Isrc/HARDWARE/I2CM/Conf -Isrc/HARDWARE/CLOCK/Core \
+ *         -Isrc/HARDWARE/CLOCK/Conf -Isrc/HARDWARE/TIMER tools/host_tests/test_i2cm.c \
+ *         src/HARDWARE/I2CM/Core/I2CM.c -o test_i2cm && ./test_i2cm
+ */
+#include <string.h>
+#include "host_test.h"
+#include "I2CM.h"
+#include "TIMER.h"
+
+#define I2C_TEST_SLAVE_ADDRESS      0x48
+#define I2C_TEST_SCL_PERIODS        9         /* One byte and its acknowledge */
+#define I2C_TEST_MARGIN_FACTOR      4         /* Clock stretching tolerated by the module */
+#define I2C_TEST_HALF_PERIOD_US     5         /* Half period of the recovery pulses */
+#define I2C_TEST_MAX_PULSES         9
+#define I2C_TEST_PPS_LATCH          0x00
+#define I2C_TEST_PPS_SCL1           0x0F
+#define I2C_TEST_PPS_SDA1           0x10
+#define I2C_TEST_CLKPPS_RB1         0x09
+#define I2C_TEST_NO_BYTE            0x100     /* SSP1BUF value meaning "no byte written" */
+#define I2C_TEST_HOLD_FOREVER       0xFF
+
+typedef enum
+{
+  SIM_PHASE_NONE = 0,
+  SIM_PHASE_START,
+  SIM_PHASE_RESTART,
+  SIM_PHASE_ADDRESS,
+  SIM_PHASE_DATA,
+  SIM_PHASE_RX,
+  SIM_PHASE_ACK,
+  SIM_PHASE_STOP,
+  SIM_PHASE_COUNT
+} tenuSimPhase;
+
+typedef struct
+{
+  const char*     pkcName;
+  bool            bRead;            /* Read of 2 bytes after 1 byte written, write of 2 bytes otherwise */
+  tenuSimPhase    enuHangPhase;
+  uint8_t         u8HangIndex;      /* Occurrence of the phase that hangs (0 = first) */
+  bool            bNackAddress;
+  uint8_t         u8SdaHoldClocks;  /* SCL clocks before the slave releases SDA, I2C_TEST_HOLD_FOREVER: never */
+  bool            bSclStuck;
+  I2CM_tenuStatus enuExpected;
+} tstrScenario;
+
+/* Registers */
+volatile HT_tuniSsp1con1     HT_uniSsp1con1;
+volatile HT_tuniSsp1con2     HT_uniSsp1con2;
+volatile HT_tstrSsp1statbits SSP1STATbits;
+volatile HT_tstrRbxI2cbits   RB1I2Cbits;
+volatile HT_tstrRbxI2cbits   RB2I2Cbits;
+volatile uint16_t            SSP1BUF;
+volatile uint8_t             SSP1ADD;
+volatile uint8_t             SSP1CLKPPS;
+volatile uint8_t             SSP1DATPPS;
+volatile uint8_t             RB1PPS;
+volatile uint8_t             RB2PPS;
+volatile HT_tstrAnselbbits   ANSELBbits;
+volatile HT_tstrWpubbits     WPUBbits;
+volatile HT_tstrLatbbits     LATBbits;
+volatile HT_tstrTrisbbits    TRISBbits;
+
+static volatile HT_tstrPir3bits  strPir3bits;
+static volatile HT_tstrPortbbits strPortbbits;
+
+/* Simulation */
+static tstrScenario const* pkstrScenario = NULL;
+static uint8_t             au8PhaseCount[SIM_PHASE_COUNT];
+static bool                bAddressExpected = false;
+static bool                bRxByteLoaded    = false;
+static uint32_t            u32TimeUs        = 0;
+static uint32_t            u32PollUs        = 0;
+static uint32_t            u32RecoveryUs    = 0;
+static uint8_t             u8SclPulses      = 0;
+static uint8_t             u8PulsesAtStop   = 0;
+static bool                bSdaHeld         = false;
+static bool                bStopSeen        = false;
+static bool                bScl             = true;
+static bool                bSda             = true;
+
+
+/* Levels of the lines while the pins are driven by the latches (open-drain emulated with the TRIS bits) */
+static void vidSampleBus(void)
+{
+  const bool kbScl = !pkstrScenario->bSclStuck && (TRISBbits.TRISB1 || LATBbits.LATB1);
+  bool       bNewSda;
+
+  /* The slave releases SDA on the falling edge of SCL which ends its last clock */
+  if(bSdaHeld && !kbScl && (pkstrScenario->u8SdaHoldClocks != I2C_TEST_HOLD_FOREVER) &&
+     (u8SclPulses >= pkstrScenario->u8SdaHoldClocks))
+  {
+    bSdaHeld = false;
+  }
+
+  bNewSda = !bSdaHeld && (TRISBbits.TRISB2 || LATBbits.LATB2);
+
+  if(!bScl && kbScl)
+  {
+    u8SclPulses++;
+  }
+
+  if(kbScl && bScl && !bSda && bNewSda)
+  {
+    bStopSeen      = true;
+    u8PulsesAtStop = u8SclPulses;
+  }
+
+  bScl = kbScl;
+  bSda = bNewSda;
+}
+
+
+void HT_vidDelayUs(const uint32_t ku32DelayUs)
+{
+  u32TimeUs += ku32DelayUs;
+
+  if(RB1PPS == I2C_TEST_PPS_LATCH)
+  {
+    u32RecoveryUs += ku32DelayUs;
+
+    vidSampleBus();
+  }
+  else
+  {
+    u32PollUs += ku32DelayUs;
+  }
+}
+
+
+volatile HT_tstrPortbbits* HT_pstrPortbbits(void)
+{
+  vidSampleBus();
+
+  strPortbbits.RB1 = bScl;
+  strPortbbits.RB2 = bSda;
+
+  return &strPortbbits;
+}
+
+
+/* MSSP1: completes the pending phase unless it is the one which hangs */
+volatile HT_tstrPir3bits* HT_pstrPir3bits(void)
+{
+  tenuSimPhase enuPhase = SIM_PHASE_NONE;
+
+  if(!SSP1CON1bits.SSPEN)
+  {
+    /* Disabled: the MSSP1 is reset */
+    SSP1BUF       = I2C_TEST_NO_BYTE;
+    bRxByteLoaded = false;
+  }
+  else if(SSP1CON2bits.SEN)   { enuPhase = SIM_PHASE_START; }
+  else if(SSP1CON2bits.RSEN)  { enuPhase = SIM_PHASE_RESTART; }
+  else if(SSP1CON2bits.PEN)   { enuPhase = SIM_PHASE_STOP; }
+  else if(SSP1CON2bits.RCEN)  { enuPhase = SIM_PHASE_RX; }
+  else if(SSP1CON2bits.ACKEN) { enuPhase = SIM_PHASE_ACK; }
+  else if(!bRxByteLoaded && (SSP1BUF != I2C_TEST_NO_BYTE))
+  {
+    enuPhase = bAddressExpected ? SIM_PHASE_ADDRESS : SIM_PHASE_DATA;
+  }
+
+  if((enuPhase != SIM_PHASE_NONE) &&
+     ((enuPhase != pkstrScenario->enuHangPhase) || (au8PhaseCount[enuPhase] != pkstrScenario->u8HangIndex)))
+  {
+    switch(enuPhase)
+    {
+      case SIM_PHASE_START:   SSP1CON2bits.SEN  = 0; bAddressExpected = true; break;
+      case SIM_PHASE_RESTART: SSP1CON2bits.RSEN = 0; bAddressExpected = true; break;
+      case SIM_PHASE_STOP:    SSP1CON2bits.PEN  = 0; break;
+      case SIM_PHASE_RX:
+        SSP1CON2bits.RCEN = 0;
+        SSP1BUF           = (uint16_t)(0xA0 + au8PhaseCount[enuPhase]);
+        bRxByteLoaded     = true;
+        break;
+      case SIM_PHASE_ACK:     SSP1CON2bits.ACKEN = 0; SSP1BUF = I2C_TEST_NO_BYTE; bRxByteLoaded = false; break;
+      default:
+        SSP1CON2bits.ACKSTAT = (enuPhase == SIM_PHASE_ADDRESS) && pkstrScenario->bNackAddress;
+        SSP1BUF              = I2C_TEST_NO_BYTE;
+        bAddressExpected     = false;
+        break;
+    }
+
+    au8PhaseCount[enuPhase]++;
+    strPir3bits.SSP1IF = 1;
+  }
+
+  return &strPir3bits;
+}
+
+
+uint32_t TIM1_u32GetTimestampUs(void)
+{
+  return u32TimeUs;
+}
+
+
+/* Expected stall of a hung phase: (I2C_TEST_SCL_PERIODS * I2C_TEST_MARGIN_FACTOR) SCL periods, plus the last poll */
+static uint32_t u32ExpectedTimeoutUs(void)
+{
+  uint32_t u32SpeedHz = 0;
+
+  (void)I2CM_enuGetBusSpeed(I2CM_I2C_ID0, &u32SpeedHz);
+
+  return ((I2C_TEST_SCL_PERIODS * I2C_TEST_MARGIN_FACTOR * 1000000UL) / u32SpeedHz) + 1;
+}
+
+
+static void vidRunScenario(tstrScenario const* const kpkstrScenario)
+{
+  static const uint8_t kau8TxBuffer[2] = { 0x12, 0x34 };
+  uint8_t              au8RxBuffer[2]  = { 0 };
+  I2CM_tstrStatistics  strBefore;
+  I2CM_tstrStatistics  strAfter;
+  I2CM_tenuStatus      enuStatus;
+  const bool           kbHang          = (kpkstrScenario->enuHangPhase != SIM_PHASE_NONE);
+  const bool           kbStuck         = (kpkstrScenario->enuExpected == I2CM_eSTATUS_BUS_STUCK);
+  const uint32_t       ku32TimeoutUs   = u32ExpectedTimeoutUs();
+  uint8_t              u8Pulses        = 0;
+  uint8_t              u8Edges         = 0;
+
+  pkstrScenario    = kpkstrScenario;
+  memset(au8PhaseCount, 0, sizeof(au8PhaseCount));
+  bAddressExpected = false;
+  bRxByteLoaded    = false;
+  u32PollUs        = 0;
+  u32RecoveryUs    = 0;
+  u8SclPulses      = 0;
+  u8PulsesAtStop   = 0;
+  bStopSeen        = false;
+  bSdaHeld         = (kpkstrScenario->u8SdaHoldClocks != 0);
+  bScl             = !kpkstrScenario->bSclStuck;
+  bSda             = !bSdaHeld;
+  SSP1CLKPPS       = 0;  /* Written back only by the configuration of the MSSP1 */
+
+  (void)I2CM_enuGetStatistics(I2CM_I2C_ID0, &strBefore);
+
+  if(kpkstrScenario->bRead)
+  {
+    enuStatus = I2CM_enuReadBuffer(I2CM_I2C_ID0, I2C_TEST_SLAVE_ADDRESS, kau8TxBuffer, 1, au8RxBuffer, 2);
+  }
+  else
+  {
+    enuStatus = I2CM_enuWriteBuffer(I2CM_I2C_ID0, I2C_TEST_SLAVE_ADDRESS, kau8TxBuffer, 2);
+  }
+
+  (void)I2CM_enuGetStatistics(I2CM_I2C_ID0, &strAfter);
+
+  HT_CHECK(enuStatus == kpkstrScenario->enuExpected, "%s: status %d, expected %d", kpkstrScenario->pkcName,
+           enuStatus, kpkstrScenario->enuExpected);
+
+  /* Stall bounded by the computed timeout of the phase */
+  HT_CHECK(u32PollUs == (kbHang ? ku32TimeoutUs : 0), "%s: polled %u us, timeout %u us", kpkstrScenario->pkcName,
+           (unsigned)u32PollUs, (unsigned)ku32TimeoutUs);
+  HT_CHECK((uint16_t)(strAfter.u16TimeoutCount - strBefore.u16TimeoutCount) == (kbHang ? 1 : 0),
+           "%s: timeout count %u -> %u", kpkstrScenario->pkcName, strBefore.u16TimeoutCount, strAfter.u16TimeoutCount);
+  HT_CHECK((uint16_t)(strAfter.u16RecoveryCount - strBefore.u16RecoveryCount) == (kbHang ? 1 : 0),
+           "%s: recovery count %u -> %u", kpkstrScenario->pkcName, strBefore.u16RecoveryCount,
+           strAfter.u16RecoveryCount);
+  HT_CHECK((uint16_t)(strAfter.u16RecoveryFailureCount - strBefore.u16RecoveryFailureCount) == (kbStuck ? 1 : 0),
+           "%s: recovery failure count %u -> %u", kpkstrScenario->pkcName, strBefore.u16RecoveryFailureCount,
+           strAfter.u16RecoveryFailureCount);
+
+  if(kbHang)
+  {
+    /* Recovery: clocks until SDA is released (the slave gets one more clock before the driver sees it), then a STOP */
+    if(kpkstrScenario->bSclStuck || (kpkstrScenario->u8SdaHoldClocks == 0))
+    {
+      u8Pulses = 0;
+    }
+    else if(kpkstrScenario->u8SdaHoldClocks >= I2C_TEST_MAX_PULSES)
+    {
+      u8Pulses = I2C_TEST_MAX_PULSES;
+    }
+    else
+    {
+      u8Pulses = (uint8_t)(kpkstrScenario->u8SdaHoldClocks + 1);
+    }
+
+    /* The STOP releases SCL once more before SDA */
+    u8Edges = kpkstrScenario->bSclStuck ? 0 : (uint8_t)(u8Pulses + 1);
+
+    HT_CHECK(u8SclPulses == u8Edges, "%s: %u SCL rising edges, expected %u", kpkstrScenario->pkcName, u8SclPulses,
+             u8Edges);
+    HT_CHECK(bStopSeen == !kbStuck, "%s: STOP %s", kpkstrScenario->pkcName, bStopSeen ? "seen" : "not seen");
+    HT_CHECK(!bStopSeen || (u8PulsesAtStop == u8Edges), "%s: STOP after %u rising edges", kpkstrScenario->pkcName,
+             u8PulsesAtStop);
+    HT_CHECK(u32RecoveryUs == ((2UL * u8Pulses) + 4) * I2C_TEST_HALF_PERIOD_US, "%s: recovery lasted %u us",
+             kpkstrScenario->pkcName, (unsigned)u32RecoveryUs);
+
+    /* Re-init of the MSSP1 */
+    HT_CHECK((SSP1CLKPPS == I2C_TEST_CLKPPS_RB1) && (RB1PPS == I2C_TEST_PPS_SCL1) && (RB2PPS == I2C_TEST_PPS_SDA1),
+             "%s: PPS not restored", kpkstrScenario->pkcName);
+    HT_CHECK(SSP1CON1bits.SSPM3 && SSP1CON1bits.SSPEN && (SSP1CON2 == 0), "%s: MSSP1 not re-initialized",
+             kpkstrScenario->pkcName);
+  }
+  else
+  {
+    HT_CHECK((au8PhaseCount[SIM_PHASE_STOP] == 1) && (u32RecoveryUs == 0), "%s: STOP by the MSSP1 expected",
+             kpkstrScenario->pkcName);
+    HT_CHECK(!kpkstrScenario->bRead || (enuStatus != I2CM_eSTATUS_OK) ||
+             ((au8RxBuffer[0] == 0xA0) && (au8RxBuffer[1] == 0xA1)), "%s: received %02X %02X",
+             kpkstrScenario->pkcName, au8RxBuffer[0], au8RxBuffer[1]);
+  }
+}
+
+
+int main(void)
+{
+  static const tstrScenario kastrScenarios[] =
+  {
+    /* Name                 Read   Hung phase         Idx  NACK   SDA   SCL    Expected status */
+    { "write",              false, SIM_PHASE_NONE,    0,   false, 0,    false, I2CM_eSTATUS_OK              },
+    { "write NACK",         false, SIM_PHASE_NONE,    0,   true,  0,    false, I2CM_eSTATUS_NO_ACKED        },
+    { "write START",        false, SIM_PHASE_START,   0,   false, 0,    false, I2CM_eSTATUS_START_TIMEOUT   },
+    { "write address",      false, SIM_PHASE_ADDRESS, 0,   false, 0,    false, I2CM_eSTATUS_ADDRESS_TIMEOUT },
+    { "write data",         false, SIM_PHASE_DATA,    1,   false, 0,    false, I2CM_eSTATUS_DATA_TIMEOUT    },
+    { "write STOP",         false, SIM_PHASE_STOP,    0,   false, 0,    false, I2CM_eSTATUS_STOP_TIMEOUT    },
+    { "read",               true,  SIM_PHASE_NONE,    0,   false, 0,    false, I2CM_eSTATUS_OK              },
+    { "read START",         true,  SIM_PHASE_START,   0,   false, 0,    false, I2CM_eSTATUS_START_TIMEOUT   },
+    { "read repeated START",true,  SIM_PHASE_RESTART, 0,   false, 0,    false, I2CM_eSTATUS_START_TIMEOUT   },
+    { "read address",       true,  SIM_PHASE_ADDRESS, 1,   false, 0,    false, I2CM_eSTATUS_ADDRESS_TIMEOUT },
+    { "read data",          true,  SIM_PHASE_RX,      1,   false, 0,    false, I2CM_eSTATUS_DATA_TIMEOUT    },
+    { "read ACK",           true,  SIM_PHASE_ACK,     0,   false, 0,    false, I2CM_eSTATUS_DATA_TIMEOUT    },
+    { "read STOP",          true,  SIM_PHASE_STOP,    0,   false, 0,    false, I2CM_eSTATUS_STOP_TIMEOUT    },
+    { "SDA held 3 clocks",  false, SIM_PHASE_DATA,    0,   false, 3,    false, I2CM_eSTATUS_DATA_TIMEOUT    },
+    { "SDA held 8 clocks",  true,  SIM_PHASE_RX,      0,   false, 8,    false, I2CM_eSTATUS_DATA_TIMEOUT    },
+    { "SDA stuck",          false, SIM_PHASE_DATA,    0,   false, I2C_TEST_HOLD_FOREVER, false, I2CM_eSTATUS_BUS_STUCK },
+    { "SCL stuck",          false, SIM_PHASE_START,   0,   false, 0,    true,  I2CM_eSTATUS_BUS_STUCK       },
+    { "write after stuck",  false, SIM_PHASE_NONE,    0,   false, 0,    false, I2CM_eSTATUS_OK              },
+  };
+  static const tstrScenario kstrStandardMode =
+    { "100 kHz data",       false, SIM_PHASE_DATA,    0,   false, 2,    false, I2CM_eSTATUS_DATA_TIMEOUT    };
+  size_t sIdx = 0;
+
+  SSP1BUF = I2C_TEST_NO_BYTE;
+
+  I2CM_vidInitalize();
+
+  for(sIdx = 0; sIdx < (sizeof(kastrScenarios) / sizeof(kastrScenarios[0])); sIdx++)
+  {
+    vidRunScenario(&kastrScenarios[sIdx]);
+  }
+
+  /* The timeout follows the bus speed */
+  HT_CHECK(I2CM_enuSetBusSpeed(I2CM_I2C_ID0, 100000UL) == I2CM_eSTATUS_OK, "bus speed not set");
+  HT_CHECK(u32ExpectedTimeoutUs() == 361, "timeout at 100 kHz: %u us", (unsigned)u32ExpectedTimeoutUs());
+  vidRunScenario(&kstrStandardMode);
+
+  return HT_RESULT("test_i2cm");
+}
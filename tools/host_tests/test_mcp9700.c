@@ -0,0 +1,146 @@
+/*
+ * Host test of the conversion of DRIVERS/MCP9700 against the transfer function of the datasheet.
+ *
+ * The sensors of MCP9700_cfg.c are initialized (slope and intercept computed by MCP9700_init) and every code of the
+ * ADC is converted through MCP9700_getTemperature, with the ADC stubbed. The reference is computed in double:
+ *     Vout = code * ADC_CONFIG_NOMINAL_VDD_MV / ADC_FULL_SCALE,  T = (Vout - 500 mV) / (10 mV/degC)
+ * The conversion is within half a 0.01 degC of the reference over -40..125 degC, clamped to -40 degC and 125 degC
+ * out of the range, monotonic, and a code out of the full scale is refused.
+ *
+ * Build and run (from the root of the repository):
+ *     gcc -std=c99 -Wall -Itools/host_tests -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf \
+ *         -Isrc/TOOLS/Common/Port -Isrc/HARDWARE/ADC/Core -Isrc/HARDWARE/ADC/Conf -Isrc/HARDWARE/TIMER \
+ *         -Isrc/DRIVERS/MCP9700/Core -Isrc/DRIVERS/MCP9700/Conf tools/host_tests/test_mcp9700.c \
+ *         src/DRIVERS/MCP9700/Core/MCP9700.c src/DRIVERS/MCP9700/Conf/MCP9700_cfg.c -lm -o test_mcp9700 && \
+ *         ./test_mcp9700
+ */
+#include <math.h>
+#include "host_test.h"
+#include "MCP9700.h"
+#include "TIMER.h"
+
+#define MCP_TEST_OFFSET_MV          500.0
+#define MCP_TEST_GAIN_MV_PER_DEG_C  10.0
+#define MCP_TEST_MIN_CENTI          (-4000)
+#define MCP_TEST_MAX_CENTI          12500
+#define MCP_TEST_BOUND_CENTI        0.5
+
+volatile HT_tstrIntconbits INTCONbits;
+
+static uint16_t u16AdcCode = 0;
+
+
+/* ADC stubs: every channel of the scan table exists and returns the code under test */
+ADC_tstrChannelConfig const * const ADC_kpkstrGetChannelConfig(const ADC_tenuChannelId kenuChannelId)
+{
+  static const ADC_tstrChannelConfig kstrConfig = { 0 };
+
+  return &kstrConfig;
+}
+
+
+ADC_tenuStatus ADC_enuGetChannelValue(const ADC_tenuChannelId kenuChannelId, uint16_t * const kpu16Value)
+{
+  *kpu16Value = u16AdcCode;
+
+  return ADC_eSTATUS_OK;
+}
+
+
+ADC_tenuStatus ADC_enuGetScanStatistics(ADC_tstrScanStatistics * const kpstrStatistics)
+{
+  return ADC_eSTATUS_OK;
+}
+
+
+ADC_tenuStatus ADC_enuStartScan(const uint32_t ku32TimeoutMs)
+{
+  return ADC_eSTATUS_OK;
+}
+
+
+bool ADC_bSetChangeDelta(const uint16_t ku16Delta)
+{
+  return true;
+}
+
+
+uint32_t TIM1_u32GetTimestampUs(void)
+{
+  return 0;
+}
+
+
+void CMN_vidLogText(char const * const kpks8Text)
+{
+  (void)kpks8Text;
+}
+
+
+/* Datasheet transfer function in 0.01 degC, clamped to the range of the sensor */
+static double dReferenceCenti(const uint16_t ku16Code)
+{
+  const double kdVoutMv = ((double)ku16Code * ADC_CONFIG_NOMINAL_VDD_MV) / ADC_FULL_SCALE;
+  const double kdCenti  = ((kdVoutMv - MCP_TEST_OFFSET_MV) / MCP_TEST_GAIN_MV_PER_DEG_C) * MCP9700_TEMPERATURE_SCALE;
+
+  return fmin(fmax(kdCenti, MCP_TEST_MIN_CENTI), MCP_TEST_MAX_CENTI);
+}
+
+
+static void vidCheckSensor(const MCP9700_tenuSensorId kenuSensorId)
+{
+  int16_t  s16Temperature = 0;
+  int16_t  s16Previous    = MCP_TEST_MIN_CENTI;
+  double   dMaxError      = 0;
+  uint32_t u32Code        = 0;
+  uint32_t u32ClampedLow  = 0;
+  uint32_t u32ClampedHigh = 0;
+
+  for(u32Code = 0; u32Code < ADC_FULL_SCALE; u32Code++)
+  {
+    u16AdcCode = (uint16_t)u32Code;
+
+    HT_CHECK(MCP9700_getTemperature(kenuSensorId, &s16Temperature) == MCP9700_OK, "sensor %d: code %u refused",
+             kenuSensorId, (unsigned)u32Code);
+    HT_CHECK(fabs(s16Temperature - dReferenceCenti(u16AdcCode)) <= MCP_TEST_BOUND_CENTI,
+             "sensor %d: code %u -> %d, reference %.3f", kenuSensorId, (unsigned)u32Code, s16Temperature,
+             dReferenceCenti(u16AdcCode));
+    HT_CHECK(s16Temperature >= s16Previous, "sensor %d: code %u -> %d after %d", kenuSensorId, (unsigned)u32Code,
+             s16Temperature, s16Previous);
+
+    dMaxError      = fmax(dMaxError, fabs(s16Temperature - dReferenceCenti(u16AdcCode)));
+    s16Previous    = s16Temperature;
+    u32ClampedLow  += (s16Temperature == MCP_TEST_MIN_CENTI) ? 1 : 0;
+    u32ClampedHigh += (s16Temperature == MCP_TEST_MAX_CENTI) ? 1 : 0;
+  }
+
+  /* Both ends of the range are reached and held by the codes beyond them (100 mV and 1750 mV) */
+  HT_CHECK((u32ClampedLow > 1) && (u32ClampedHigh > 1), "sensor %d: %u codes at -40 degC, %u codes at 125 degC",
+           kenuSensorId, (unsigned)u32ClampedLow, (unsigned)u32ClampedHigh);
+
+  u16AdcCode = (uint16_t)ADC_FULL_SCALE;
+  HT_CHECK(MCP9700_getTemperature(kenuSensorId, &s16Temperature) == MCP9700_NOK, "sensor %d: full scale accepted",
+           kenuSensorId);
+
+  printf("sensor %d: max error %.3f (0.01 degC)\n", kenuSensorId, dMaxError);
+}
+
+
+int main(void)
+{
+  MCP9700_tenuSensorId enuSensorId;
+
+  HT_CHECK(MCP9700_init() == MCP9700_OK, "init failed");
+
+  for(enuSensorId = MCP9700_eSENSOR_ID_BEGIN + 1; enuSensorId < MCP9700_eSENSOR_ID_END; enuSensorId++)
+  {
+    HT_CHECK((MCP9700_kpkstrGetSensorConfig(enuSensorId)->u16OffsetMv == MCP_TEST_OFFSET_MV) &&
+             (MCP9700_kpkstrGetSensorConfig(enuSensorId)->u16GainUvPerDegC == (MCP_TEST_GAIN_MV_PER_DEG_C * 1000)) &&
+             (MCP9700_kpkstrGetSensorConfig(enuSensorId)->s16Calibration == 0),
+             "sensor %d: not configured as a MCP9700", enuSensorId);
+
+    vidCheckSensor(enuSensorId);
+  }
+
+  return HT_RESULT("test_mcp9700");
+}
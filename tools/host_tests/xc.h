@@ -0,0 +1,100 @@
+/*
+ * Host stand-in of the XC8 <xc.h> for the modules of src/ compiled by the host tests.
+ * Only the registers used by the modules under test are declared: the plain ones are variables defined by the test,
+ * the ones a test simulates (status flags, input ports) are read through an accessor defined by the test, so that the
+ * simulation runs on each access of the module. The delays advance the simulated time of the test.
+ */
+#ifndef XC_H_
+#define XC_H_
+
+#include <stdint.h>
+
+#define __debug_break()                                     ((void)0)
+#define __delay_us(_US_)                                    HT_vidDelayUs(_US_)
+
+void HT_vidDelayUs(const uint32_t ku32DelayUs);
+
+
+/* Interrupts --------------------------------------------------------------------------------------------------------*/
+typedef struct { unsigned INT0EDG : 1; unsigned INT1EDG : 1; unsigned INT2EDG : 1; unsigned : 2; unsigned IPEN : 1;
+                 unsigned PEIE : 1; unsigned GIE : 1; } HT_tstrIntconbits;
+
+extern volatile HT_tstrIntconbits INTCONbits;
+
+
+/* MSSP1 (I2CM) ------------------------------------------------------------------------------------------------------*/
+typedef union
+{
+  uint8_t u8;
+  struct
+  {
+    unsigned SSPM0 : 1;
+    unsigned SSPM1 : 1;
+    unsigned SSPM2 : 1;
+    unsigned SSPM3 : 1;
+    unsigned CKP   : 1;
+    unsigned SSPEN : 1;
+    unsigned SSPOV : 1;
+    unsigned WCOL  : 1;
+  } bits;
+} HT_tuniSsp1con1;
+
+typedef union
+{
+  uint8_t u8;
+  struct
+  {
+    unsigned SEN     : 1;
+    unsigned RSEN    : 1;
+    unsigned PEN     : 1;
+    unsigned RCEN    : 1;
+    unsigned ACKEN   : 1;
+    unsigned ACKDT   : 1;
+    unsigned ACKSTAT : 1;
+    unsigned GCEN    : 1;
+  } bits;
+} HT_tuniSsp1con2;
+
+typedef struct { unsigned BF : 1; unsigned UA : 1; unsigned R_W : 1; unsigned S : 1; unsigned P : 1;
+                 unsigned D_A : 1; unsigned CKE : 1; unsigned SMP : 1; } HT_tstrSsp1statbits;
+typedef struct { unsigned : 7; unsigned SSP1IF : 1; } HT_tstrPir3bits;
+typedef struct { unsigned TH : 2; unsigned : 2; unsigned PU : 2; unsigned SLEW : 1; unsigned : 1; } HT_tstrRbxI2cbits;
+
+extern volatile HT_tuniSsp1con1     HT_uniSsp1con1;
+extern volatile HT_tuniSsp1con2     HT_uniSsp1con2;
+extern volatile HT_tstrSsp1statbits SSP1STATbits;
+extern volatile HT_tstrRbxI2cbits   RB1I2Cbits;
+extern volatile HT_tstrRbxI2cbits   RB2I2Cbits;
+extern volatile uint16_t            SSP1BUF;      /* Wider than the register: a byte written is told from "no byte" */
+extern volatile uint8_t             SSP1ADD;
+extern volatile uint8_t             SSP1CLKPPS;
+extern volatile uint8_t             SSP1DATPPS;
+extern volatile uint8_t             RB1PPS;
+extern volatile uint8_t             RB2PPS;
+
+volatile HT_tstrPir3bits* HT_pstrPir3bits(void);
+
+#define SSP1CON1                                            (HT_uniSsp1con1.u8)
+#define SSP1CON1bits                                        (HT_uniSsp1con1.bits)
+#define SSP1CON2                                            (HT_uniSsp1con2.u8)
+#define SSP1CON2bits                                        (HT_uniSsp1con2.bits)
+#define PIR3bits                                            (*HT_pstrPir3bits())
+
+
+/* PORTB -------------------------------------------------------------------------------------------------------------*/
+typedef struct { unsigned ANSELB0 : 1; unsigned ANSELB1 : 1; unsigned ANSELB2 : 1; unsigned : 5; } HT_tstrAnselbbits;
+typedef struct { unsigned WPUB0 : 1; unsigned WPUB1 : 1; unsigned WPUB2 : 1; unsigned : 5; } HT_tstrWpubbits;
+typedef struct { unsigned LATB0 : 1; unsigned LATB1 : 1; unsigned LATB2 : 1; unsigned : 5; } HT_tstrLatbbits;
+typedef struct { unsigned TRISB0 : 1; unsigned TRISB1 : 1; unsigned TRISB2 : 1; unsigned : 5; } HT_tstrTrisbbits;
+typedef struct { unsigned RB0 : 1; unsigned RB1 : 1; unsigned RB2 : 1; unsigned : 5; } HT_tstrPortbbits;
+
+extern volatile HT_tstrAnselbbits ANSELBbits;
+extern volatile HT_tstrWpubbits   WPUBbits;
+extern volatile HT_tstrLatbbits   LATBbits;
+extern volatile HT_tstrTrisbbits  TRISBbits;
+
+volatile HT_tstrPortbbits* HT_pstrPortbbits(void);
+
+#define PORTBbits                                           (*HT_pstrPortbbits())
+
+#endif /* XC_H_ */
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Host reader of the I2C bus activity trace exported by the firmware over SERP.
+
+Sends the SERP_MSG_ID_I2C_TRACE_REQUEST message, then decodes the SERP_MSG_ID_I2C_TRACE and
+SERP_MSG_ID_I2C_BUS_USAGE answers (see I2CM_TRACE_RECORD_SIZE and I2CM_BUS_USAGE_RECORD_SIZE in I2CM.h).
+
+Usage:
+    i2c_trace.py --port /dev/ttyUSB0 [--baudrate 115200]
+    i2c_trace.py --capture dump.bin
+"""
+
+import argparse
+import struct
+import sys
+
+SERP_START_BYTE = 0x6F
+SERP_STOP_BYTE = 0x65
+SERP_ESCAPE_BYTE = 0x64
+
+SERP_MSG_ID_I2C_TRACE_REQUEST = 21
+SERP_MSG_ID_I2C_TRACE = 22
+SERP_MSG_ID_I2C_BUS_USAGE = 23
+
+TRACE_RECORD = struct.Struct("<IHHBBB")
+BUS_USAGE_RECORD = struct.Struct("<BHHI")
+
+DIRECTIONS = {0: "W", 1: "R"}
+# Order of I2CM_tenuStatus
+STATUSES = dict(enumerate([
+    "OK",
+    "NO_OK",
+    "INVALID_I2C_ID",
+    "INVALID_SLAVE_ADDRESS",
+    "NULL_POINTER",
+    "EMPTY_BUFFER",
+    "NO_ACKED",
+    "START_TIMEOUT",
+    "ADDRESS_TIMEOUT",
+    "DATA_TIMEOUT",
+    "STOP_TIMEOUT",
+    "BUS_STUCK",
+    "INVALID_BUS_SPEED",
+]))
+
+
+def encode_frame(msg_id, data=b""):
+    """Builds a SERP frame, only the data bytes are escaped."""
+    frame = bytearray([SERP_START_BYTE, msg_id, len(data) & 0xFF, (len(data) >> 8) & 0xFF])
+    for byte in data:
+        if byte in (SERP_START_BYTE, SERP_STOP_BYTE, SERP_ESCAPE_BYTE):
+            frame.append(SERP_ESCAPE_BYTE)
+        frame.append(byte)
+    frame.append(SERP_STOP_BYTE)
+    return bytes(frame)
+
+
+def decode_frames(stream):
+    """Yields (msg_id, data) for each valid SERP frame read from an iterator of bytes."""
+    stream = iter(stream)
+    for byte in stream:
+        if byte != SERP_START_BYTE:
+            continue
+        try:
+            msg_id = next(stream)
+            length = next(stream) | (next(stream) << 8)
+            data = bytearray()
+            while len(data) < length:
+                byte = next(stream)
+                if byte == SERP_ESCAPE_BYTE:
+                    byte = next(stream)
+                data.append(byte)
+            if next(stream) != SERP_STOP_BYTE:
+                continue
+        except StopIteration:
+            return
+        yield msg_id, bytes(data)
+
+
+def print_trace(data):
+    count = data[0] if data else 0
+    for offset in range(1, 1 + count * TRACE_RECORD.size, TRACE_RECORD.size):
+        timestamp, duration, length, address, direction, status = TRACE_RECORD.unpack_from(data, offset)
+        print("{:>12} us  0x{:02X} {}  {:>4} B  {:>6} us  {}".format(
+            timestamp, address, DIRECTIONS.get(direction, "?"), length, duration, STATUSES.get(status, status)))
+    return count
+
+
+def print_bus_usage(data):
+    records = [BUS_USAGE_RECORD.unpack_from(data, offset)
+               for offset in range(0, len(data) - BUS_USAGE_RECORD.size + 1, BUS_USAGE_RECORD.size)]
+    total_us = sum(record[3] for record in records)
+    print("Bus usage per slave address:")
+    for address, transactions, errors, busy_us in sorted(records, key=lambda record: -record[3]):
+        share = (100.0 * busy_us / total_us) if total_us else 0.0
+        print("  0x{:02X}: {:>6} transactions, {:>5} errors, {:>10} us busy ({:5.1f} %)".format(
+            address, transactions, errors, busy_us, share))
+
+
+def serial_bytes(port):
+    while True:
+        chunk = port.read(64)
+        if not chunk:
+            return
+        yield from chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port connected to the EUSART2 of the board")
+    source.add_argument("--capture", help="raw capture of the serial stream")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=2.0, help="seconds without data before stopping")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+
+        port = serial.Serial(args.port, args.baudrate, timeout=args.timeout)
+        port.write(encode_frame(SERP_MSG_ID_I2C_TRACE_REQUEST))
+        stream = serial_bytes(port)
+    else:
+        with open(args.capture, "rb") as capture:
+            stream = capture.read()
+
+    for msg_id, data in decode_frames(stream):
+        if msg_id == SERP_MSG_ID_I2C_TRACE:
+            print_trace(data)
+        elif msg_id == SERP_MSG_ID_I2C_BUS_USAGE:
+            print_bus_usage(data)
+            if args.port:
+                break
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
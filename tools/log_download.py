@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+Host reader of the persistent sample log of the firmware over SERP.
+
+Sends a SERP_MSG_ID_LOG_READ request for a range of sample indexes, then receives the SERP_MSG_ID_LOG_DATA
+chunks and acknowledges them with SERP_MSG_ID_LOG_ACK, several chunks being in flight (see DWL_REQUEST_SIZE,
+DWL_RANGE_RECORD_SIZE and the chunk format in Download.h). A lost chunk or a silence restarts the download from
+the first missing index. The samples are written as CSV (index, value in 0.01 degree) and the throughput is
+reported on stderr.
+
+Usage:
+    log_download.py --port /dev/ttyUSB0 [--baudrate 115200] [--first 0 --count 1000 | --last 1000]
+                    [--window 8] [--delta] [--output log.csv]
+    log_download.py --capture dump.bin [--delta]
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+SERP_START_BYTE = 0x6F
+SERP_STOP_BYTE = 0x65
+SERP_ESCAPE_BYTE = 0x64
+
+SERP_MSG_ID_LOG_READ = 30
+SERP_MSG_ID_LOG_DATA = 31
+SERP_MSG_ID_LOG_ACK = 32
+
+REQUEST = struct.Struct("<IIBB")
+RANGE_RECORD = struct.Struct("<IIIIBB")
+CHUNK_HEADER = struct.Struct("<IBB")
+
+# Order of DWL_tenuEncoding
+ENCODING_RAW = 0
+ENCODING_DELTA = 1
+DELTA_ESCAPE = 0x80
+
+# Bits per byte on the line: start, 8 data bits, stop
+UART_BITS_PER_BYTE = 10
+
+
+def encode_frame(msg_id, data=b""):
+    """Builds a SERP frame, only the data bytes are escaped."""
+    frame = bytearray([SERP_START_BYTE, msg_id, len(data) & 0xFF, (len(data) >> 8) & 0xFF])
+    for byte in data:
+        if byte in (SERP_START_BYTE, SERP_STOP_BYTE, SERP_ESCAPE_BYTE):
+            frame.append(SERP_ESCAPE_BYTE)
+        frame.append(byte)
+    frame.append(SERP_STOP_BYTE)
+    return bytes(frame)
+
+
+def decode_frames(stream):
+    """Yields (msg_id, data) for each valid SERP frame read from an iterator of bytes."""
+    stream = iter(stream)
+    for byte in stream:
+        if byte != SERP_START_BYTE:
+            continue
+        try:
+            msg_id = next(stream)
+            length = next(stream) | (next(stream) << 8)
+            data = bytearray()
+            while len(data) < length:
+                byte = next(stream)
+                if byte == SERP_ESCAPE_BYTE:
+                    byte = next(stream)
+                data.append(byte)
+            if next(stream) != SERP_STOP_BYTE:
+                continue
+        except StopIteration:
+            return
+        yield msg_id, bytes(data)
+
+
+def decode_samples(payload, count, encoding):
+    """Decodes the samples of a chunk (see DWL_tenuEncoding)."""
+    if encoding == ENCODING_RAW:
+        return list(struct.unpack_from("<{}h".format(count), payload))
+    values = []
+    offset = 0
+    while len(values) < count:
+        if not values:
+            values.append(struct.unpack_from("<h", payload, offset)[0])
+            offset += 2
+        elif payload[offset] == DELTA_ESCAPE:
+            values.append(struct.unpack_from("<h", payload, offset + 1)[0])
+            offset += 3
+        else:
+            values.append(values[-1] + struct.unpack_from("<b", payload, offset)[0])
+            offset += 1
+    return values
+
+
+class ByteCounter:
+    """Iterator over the bytes read from the serial port, stops after a read timeout."""
+
+    def __init__(self, port):
+        self.port = port
+        self.count = 0
+
+    def __iter__(self):
+        while True:
+            chunk = self.port.read(max(1, self.port.in_waiting))
+            if not chunk:
+                return
+            self.count += len(chunk)
+            yield from chunk
+
+
+def read_range(port, first, count, window, encoding):
+    """Sends a request, returns the range record (oldest, next, first, count, first chunk, window) or None."""
+    port.write(encode_frame(SERP_MSG_ID_LOG_READ, REQUEST.pack(first, count, window, encoding)))
+    for msg_id, data in decode_frames(ByteCounter(port)):
+        if msg_id == SERP_MSG_ID_LOG_READ and len(data) == RANGE_RECORD.size:
+            return RANGE_RECORD.unpack(data)
+    return None
+
+
+def download(port, first, count, window, encoding, retries):
+    """Downloads the samples of [first, first + count), returns ({index: value}, bytes read)."""
+    samples = {}
+    end = first + count
+    next_index = first
+    received = 0
+    failures = 0
+
+    while failures <= retries:
+        stream = ByteCounter(port)
+        port.write(encode_frame(SERP_MSG_ID_LOG_READ,
+                                REQUEST.pack(next_index, max(0, end - next_index), window, encoding)))
+        expected = None
+        progress = False
+        for msg_id, data in decode_frames(stream):
+            if msg_id == SERP_MSG_ID_LOG_READ and len(data) == RANGE_RECORD.size:
+                _, _, served_first, served_count, expected, _ = RANGE_RECORD.unpack(data)
+                next_index = served_first
+                end = served_first + served_count
+                if served_count == 0:
+                    return samples, received + stream.count
+            elif msg_id == SERP_MSG_ID_LOG_DATA and expected is not None and len(data) >= CHUNK_HEADER.size:
+                index, chunk, chunk_count = CHUNK_HEADER.unpack_from(data)
+                if chunk != expected:
+                    # Lost chunk: resume from the first missing index
+                    break
+                expected = (expected + 1) & 0xFF
+                port.write(encode_frame(SERP_MSG_ID_LOG_ACK, bytes([expected])))
+                for offset, value in enumerate(decode_samples(data[CHUNK_HEADER.size:], chunk_count, encoding)):
+                    samples[index + offset] = value
+                # The indexes skipped before the chunk are not stored
+                next_index = index + chunk_count
+                progress = True
+                if chunk_count == 0:
+                    return samples, received + stream.count
+        received += stream.count
+        failures = 0 if progress else failures + 1
+        port.reset_input_buffer()
+
+    raise RuntimeError("no answer from the board after {} retries".format(retries))
+
+
+def print_capture(stream, encoding):
+    for msg_id, data in decode_frames(stream):
+        if msg_id == SERP_MSG_ID_LOG_READ and len(data) == RANGE_RECORD.size:
+            oldest, next_index, first, count, chunk, window = RANGE_RECORD.unpack(data)
+            print("# log [{}, {}), download [{}, {}) from chunk {}, window {}".format(
+                oldest, next_index, first, first + count, chunk, window))
+        elif msg_id == SERP_MSG_ID_LOG_DATA and len(data) >= CHUNK_HEADER.size:
+            index, chunk, count = CHUNK_HEADER.unpack_from(data)
+            print("# chunk {}".format(chunk))
+            for offset, value in enumerate(decode_samples(data[CHUNK_HEADER.size:], count, encoding)):
+                print("{},{}".format(index + offset, value))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="serial port connected to the EUSART2 of the board")
+    source.add_argument("--capture", help="raw capture of the serial stream sent by the board (chunks are printed)")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=0.5, help="seconds without data before resuming")
+    parser.add_argument("--retries", type=int, default=5, help="resumes without progress before giving up")
+    parser.add_argument("--first", type=int, default=0, help="index of the first sample (default: the oldest)")
+    parser.add_argument("--count", type=int, default=0xFFFFFFFF, help="number of samples (default: up to the end)")
+    parser.add_argument("--last", type=int, help="download the last N samples of the log")
+    parser.add_argument("--window", type=int, default=0, help="chunks in flight (default: the maximum of the board)")
+    parser.add_argument("--delta", action="store_true", help="delta-compressed chunks (also for --capture)")
+    parser.add_argument("--output", help="CSV file (default: stdout)")
+    args = parser.parse_args()
+
+    encoding = ENCODING_DELTA if args.delta else ENCODING_RAW
+
+    if args.capture:
+        with open(args.capture, "rb") as capture:
+            print_capture(capture.read(), encoding)
+        return 0
+
+    import serial  # pyserial
+
+    port = serial.Serial(args.port, args.baudrate, timeout=args.timeout)
+    first, count = args.first, args.count
+
+    if args.last is not None:
+        log_range = read_range(port, 0, 0, 0, encoding)
+        if log_range is None:
+            print("Error: no answer from the board", file=sys.stderr)
+            return 1
+        first, count = max(log_range[0], log_range[1] - args.last), args.last
+
+    start = time.monotonic()
+    samples, received = download(port, first, min(count, 0xFFFFFFFF - first), args.window, encoding, args.retries)
+    elapsed = max(time.monotonic() - start, 1e-6)
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    output.write("index,value\n")
+    for index in sorted(samples):
+        output.write("{},{}\n".format(index, samples[index]))
+    if args.output:
+        output.close()
+
+    line_rate = args.baudrate / UART_BITS_PER_BYTE
+    print("{} samples in {:.2f} s: {:.0f} samples/s, {:.0f} B/s ({:.0f} % of the line rate), {:.2f} B/sample".format(
+        len(samples), elapsed, len(samples) / elapsed, received / elapsed, 100.0 * received / elapsed / line_rate,
+        received / max(len(samples), 1)), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
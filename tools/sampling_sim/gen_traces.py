@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""
+Generator of the synthetic temperature traces used by sampling_sim.c.
+
+Each trace is the true signal (no ADC step, no noise: the simulator adds them) over 1 h, one point per second, as
+CSV (time in ms, value in 0.01 degree). The simulator interpolates linearly between the points.
+
+    steady_drift.csv      room temperature drifting by 0.5 degC/h
+    finger_heat_cool.csv  finger on the sensor every 10 min: 22 -> 30 degC (tau 20 s) for 120 s, cooling (tau 60 s)
+    pot_ramps.csv         potentiometer turned every 5 min: 3 s ramps of +-10 degC
+
+Usage:
+    gen_traces.py [--output traces]
+"""
+
+import argparse
+import math
+import os
+import sys
+
+DURATION_S = 3600
+
+
+def steady_drift(t):
+    return 2200 + 50 * t / 3600.0
+
+
+def finger_heat_cool(t):
+    phase = math.fmod(t, 600.0)
+    value = 2200.0
+    if 100 <= phase < 220:
+        value += 800 * (1 - math.exp(-(phase - 100) / 20.0))
+    elif phase >= 220:
+        top = 800 * (1 - math.exp(-120 / 20.0))
+        value += top * math.exp(-(phase - 220) / 60.0)
+    return value
+
+
+def pot_ramps(t):
+    phase = math.fmod(t, 300.0)
+    turn = int(t / 300.0)
+    start, end = (3200, 2200) if turn % 2 else (2200, 3200)
+    if phase < 150:
+        return start
+    if phase < 153:
+        return start + (end - start) * (phase - 150) / 3.0
+    return end
+
+
+TRACES = {
+    "steady_drift": steady_drift,
+    "finger_heat_cool": finger_heat_cool,
+    "pot_ramps": pot_ramps,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--output", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "traces"))
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    for name, signal in TRACES.items():
+        with open(os.path.join(args.output, name + ".csv"), "w") as output:
+            output.write("time_ms,value\n")
+            for second in range(DURATION_S + 1):
+                output.write("{},{:.2f}\n".format(second * 1000, signal(float(second))))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
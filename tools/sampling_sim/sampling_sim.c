@@ -0,0 +1,319 @@
+/*
+ * Host simulation of the adaptive sampling policy (src/TOOLS/Sampling) on temperature traces.
+ *
+ * The real Filter and Sampling modules are compiled for the host. Each trace (CSV: time in ms, value in 0.01 degree,
+ * linear interpolation between the points) is sampled twice on a 10 ms timebase:
+ *   - at the fixed period of 250 ms (the period before the adaptive policy),
+ *   - at the period chosen by the policy (SMP period callback), as the MCP9700 scheduler does.
+ * Each sample is quantized to the ADC step (0.04 degC) with a gaussian noise of 1.5 step (deterministic generator),
+ * pushed to SMP_vidPushRawSample and to the filter, whose output feeds SMP_vidPushSample. The host plot is the linear
+ * interpolation of the filtered values between two samples.
+ *
+ * Printed for each trace: the samples and the serial bytes of both runs, the deviation of the adaptive plot from the
+ * fixed one, and the worst deviation of both plots from the true signal (0.01 degC).
+ *
+ * Build (from the root of the repository):
+ *     gcc -std=c99 -O2 -Itools/sampling_sim -Isrc/TOOLS/Common/Core -Isrc/TOOLS/Common/Conf \
+ *         -Isrc/TOOLS/Common/Port -Isrc/HARDWARE/TIMER -Isrc/TOOLS/Filter/Core -Isrc/TOOLS/Filter/Conf \
+ *         -Isrc/TOOLS/Sampling/Core -Isrc/TOOLS/Sampling/Conf tools/sampling_sim/sampling_sim.c \
+ *         src/TOOLS/Sampling/Core/Sampling.c src/TOOLS/Filter/Core/Filter.c -lm -o sampling_sim
+ *
+ * Usage:
+ *     sampling_sim [--settings MIN_MS MAX_MS RATE RESIDUAL STABLE] trace.csv [trace.csv ...]
+ *     sampling_sim tools/sampling_sim/traces/steady_drift.csv tools/sampling_sim/traces/pot_ramps.csv
+ *
+ * The traces of tools/sampling_sim/traces are synthetic (see gen_traces.py). A log downloaded with log_download.py
+ * can be replayed once its index column is converted to a time in ms (index times the logging period).
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TIMER.h"
+#include "Filter.h"
+#include "Sampling.h"
+
+#define SIM_STEP_MS                 10
+#define SIM_FIXED_PERIOD_MS         250
+#define SIM_ADC_STEP                4     /* 0.04 degC per ADC code (10 mV/degC, 13 oversampled bits over 3.3 V) */
+#define SIM_NOISE_STEPS             1.5
+#define SIM_BYTES_PER_SAMPLE        26    /* SENSOR_SAMPLE 8 + TEMPERATURE 7 + TELEMETRY_SAMPLE 11, framing included */
+#define SIM_PI                      3.14159265358979323846
+
+typedef struct
+{
+  double *pdTimeMs;
+  double *pdValue;
+  long    lPoints;
+}tstrTrace;
+
+static uint32_t u32NowUs       = 0;
+static int16_t  s16Filtered    = 0;
+static uint16_t u16PeriodMs    = SIM_FIXED_PERIOD_MS;
+static uint32_t u32NoiseState  = 12345;
+
+
+uint32_t TIM1_u32GetTimestampUs(void)
+{
+  return u32NowUs;
+}
+
+
+void CMN_vidManageAssert(const bool kbCondition, const uint16_t ku16Line, char const * const kpkcFile,
+                         char const * const kpkcFunction)
+{
+  (void)kpkcFunction;
+
+  if(!kbCondition)
+  {
+    fprintf(stderr, "ASSERT %s:%u\n", kpkcFile, ku16Line);
+  }
+}
+
+
+static void vidOnFiltered(const int16_t ks16Value)
+{
+  s16Filtered = ks16Value;
+}
+
+
+static void vidOnPeriod(const uint16_t ku16PeriodMs)
+{
+  u16PeriodMs = ku16PeriodMs;
+}
+
+
+/* Deterministic LCG and Box-Muller, so the runs can be reproduced */
+static double dGauss(void)
+{
+  double dU1 = 0;
+  double dU2 = 0;
+
+  u32NoiseState = (u32NoiseState * 1103515245u) + 12345u;
+  dU1 = (((u32NoiseState >> 8) & 0xFFFFFF) / 16777216.0) + 1e-9;
+  u32NoiseState = (u32NoiseState * 1103515245u) + 12345u;
+  dU2 = ((u32NoiseState >> 8) & 0xFFFFFF) / 16777216.0;
+
+  return sqrt(-2 * log(dU1)) * cos(2 * SIM_PI * dU2);
+}
+
+
+static double dGetTruth(const tstrTrace *pkstrTrace, const double kdTimeMs)
+{
+  static long lIndex = 0;
+
+  if((lIndex >= pkstrTrace->lPoints) || (pkstrTrace->pdTimeMs[lIndex] > kdTimeMs))
+  {
+    lIndex = 0;
+  }
+
+  while(((lIndex + 1) < pkstrTrace->lPoints) && (pkstrTrace->pdTimeMs[lIndex + 1] <= kdTimeMs))
+  {
+    lIndex++;
+  }
+
+  if((lIndex + 1) >= pkstrTrace->lPoints)
+  {
+    return pkstrTrace->pdValue[pkstrTrace->lPoints - 1];
+  }
+
+  return pkstrTrace->pdValue[lIndex] + ((pkstrTrace->pdValue[lIndex + 1] - pkstrTrace->pdValue[lIndex]) *
+                                        (kdTimeMs - pkstrTrace->pdTimeMs[lIndex]) /
+                                        (pkstrTrace->pdTimeMs[lIndex + 1] - pkstrTrace->pdTimeMs[lIndex]));
+}
+
+
+static int16_t s16Measure(const tstrTrace *pkstrTrace, const double kdTimeMs)
+{
+  const double kdValue = dGetTruth(pkstrTrace, kdTimeMs) + (SIM_NOISE_STEPS * SIM_ADC_STEP * dGauss());
+
+  return (int16_t)(SIM_ADC_STEP * lround(kdValue / SIM_ADC_STEP));
+}
+
+
+static bool bLoadTrace(const char *pkcPath, tstrTrace *pstrTrace)
+{
+  FILE  *pFile      = fopen(pkcPath, "r");
+  long   lCapacity  = 4096;
+  char   acLine[128];
+  double dTimeMs    = 0;
+  double dValue     = 0;
+
+  if(pFile == NULL)
+  {
+    return false;
+  }
+
+  pstrTrace->lPoints  = 0;
+  pstrTrace->pdTimeMs = malloc(lCapacity * sizeof(double));
+  pstrTrace->pdValue  = malloc(lCapacity * sizeof(double));
+
+  while(fgets(acLine, sizeof(acLine), pFile) != NULL)
+  {
+    if(sscanf(acLine, "%lf,%lf", &dTimeMs, &dValue) == 2)
+    {
+      if(pstrTrace->lPoints == lCapacity)
+      {
+        lCapacity *= 2;
+        pstrTrace->pdTimeMs = realloc(pstrTrace->pdTimeMs, lCapacity * sizeof(double));
+        pstrTrace->pdValue  = realloc(pstrTrace->pdValue, lCapacity * sizeof(double));
+      }
+
+      pstrTrace->pdTimeMs[pstrTrace->lPoints] = dTimeMs;
+      pstrTrace->pdValue[pstrTrace->lPoints]  = dValue;
+      pstrTrace->lPoints++;
+    }
+  }
+
+  fclose(pFile);
+
+  return (pstrTrace->lPoints >= 2);
+}
+
+
+/* Runs a trace, fills the plotted curve (one point per step) and returns the number of samples */
+static long lRun(const tstrTrace *pkstrTrace, const bool kbAdaptive, SMP_tstrSettings const *pkstrSettings,
+                 double *pdPlot, const long klSteps)
+{
+  uint32_t u32LastDeadlineUs = 0;
+  uint32_t u32PeriodUs       = 0;
+  long     lSamples          = 0;
+  long     lLastStep         = -1;
+  double   dLastValue        = 0;
+  long     lStep             = 0;
+  long     lFill             = 0;
+
+  FLT_vidInitialize();
+  SMP_vidInitialize();
+  (void)SMP_enuSetSettings(pkstrSettings);
+  u16PeriodMs = SIM_FIXED_PERIOD_MS;
+
+  for(lStep = 0; lStep < klSteps; lStep++)
+  {
+    u32NowUs    = (uint32_t)(lStep * SIM_STEP_MS * 1000);
+    u32PeriodUs = (kbAdaptive ? u16PeriodMs : SIM_FIXED_PERIOD_MS) * 1000u;
+
+    if((lSamples == 0) || ((u32NowUs - u32LastDeadlineUs) >= u32PeriodUs))
+    {
+      // Same deadline policy as the MCP9700 scheduler: no drift, resynchronized after a late sample
+      if((lSamples != 0) && ((u32NowUs - u32LastDeadlineUs) < (2 * u32PeriodUs)))
+      {
+        u32LastDeadlineUs += u32PeriodUs;
+      }
+      else
+      {
+        u32LastDeadlineUs = u32NowUs;
+      }
+
+      {
+        const int16_t ks16Raw = s16Measure(pkstrTrace, (double)lStep * SIM_STEP_MS);
+
+        SMP_vidPushRawSample(ks16Raw);
+        (void)FLT_s16PushSample(ks16Raw);
+      }
+
+      lSamples++;
+
+      for(lFill = lLastStep + 1; lFill <= lStep; lFill++)
+      {
+        pdPlot[lFill] = (lLastStep < 0) ? s16Filtered :
+                        (dLastValue + ((s16Filtered - dLastValue) * (double)(lFill - lLastStep) / (lStep - lLastStep)));
+      }
+
+      dLastValue = s16Filtered;
+      lLastStep  = lStep;
+    }
+  }
+
+  for(lFill = lLastStep + 1; lFill < klSteps; lFill++)
+  {
+    pdPlot[lFill] = dLastValue;
+  }
+
+  return lSamples;
+}
+
+
+int main(int argc, char **argv)
+{
+  SMP_tstrSettings strSettings;
+  tstrTrace        strTrace;
+  int              iArg      = 1;
+  int              iResult   = 0;
+
+  SMP_vidInitialize();
+  (void)SMP_enuGetSettings(&strSettings);
+  (void)FLT_bSubscribe(vidOnFiltered);
+  (void)FLT_bSubscribe(SMP_vidPushSample);
+  (void)SMP_bRegisterPeriodCbk(vidOnPeriod);
+
+  if((argc >= 7) && (strcmp(argv[1], "--settings") == 0))
+  {
+    strSettings.u16MinPeriodMs       = (uint16_t)atoi(argv[2]);
+    strSettings.u16MaxPeriodMs       = (uint16_t)atoi(argv[3]);
+    strSettings.u16RateThreshold     = (uint16_t)atoi(argv[4]);
+    strSettings.u16ResidualThreshold = (uint16_t)atoi(argv[5]);
+    strSettings.u8StableSamples      = (uint8_t)atoi(argv[6]);
+    iArg = 7;
+  }
+
+  if(iArg >= argc)
+  {
+    fprintf(stderr, "Usage: %s [--settings MIN_MS MAX_MS RATE RESIDUAL STABLE] trace.csv [trace.csv ...]\n", argv[0]);
+    return 2;
+  }
+
+  printf("settings: %u-%u ms, rate %u, residual %u, %u stable samples\n", strSettings.u16MinPeriodMs,
+         strSettings.u16MaxPeriodMs, strSettings.u16RateThreshold, strSettings.u16ResidualThreshold,
+         strSettings.u8StableSamples);
+
+  for(; iArg < argc; iArg++)
+  {
+    if(!bLoadTrace(argv[iArg], &strTrace))
+    {
+      fprintf(stderr, "Error: unable to read the trace %s\n", argv[iArg]);
+      iResult = 1;
+      continue;
+    }
+
+    {
+      const long klSteps    = (long)(strTrace.pdTimeMs[strTrace.lPoints - 1] / SIM_STEP_MS) + 1;
+      double    *pdFixed    = malloc(klSteps * sizeof(double));
+      double    *pdAdaptive = malloc(klSteps * sizeof(double));
+      long       lFixed     = 0;
+      long       lAdaptive  = 0;
+      double     dMaxDelta  = 0;
+      double     dSumSquare = 0;
+      double     dMaxFixed  = 0;
+      double     dMaxAdapt  = 0;
+      double     dTruth     = 0;
+      long       lStep      = 0;
+
+      u32NoiseState = 12345;
+      lFixed        = lRun(&strTrace, false, &strSettings, pdFixed, klSteps);
+      u32NoiseState = 12345;
+      lAdaptive     = lRun(&strTrace, true, &strSettings, pdAdaptive, klSteps);
+
+      for(lStep = 0; lStep < klSteps; lStep++)
+      {
+        dTruth      = dGetTruth(&strTrace, (double)lStep * SIM_STEP_MS);
+        dMaxDelta   = fmax(dMaxDelta, fabs(pdAdaptive[lStep] - pdFixed[lStep]));
+        dSumSquare += (pdAdaptive[lStep] - pdFixed[lStep]) * (pdAdaptive[lStep] - pdFixed[lStep]);
+        dMaxFixed   = fmax(dMaxFixed, fabs(pdFixed[lStep] - dTruth));
+        dMaxAdapt   = fmax(dMaxAdapt, fabs(pdAdaptive[lStep] - dTruth));
+      }
+
+      printf("%s\n  samples %ld -> %ld (%+.0f%%), bytes %ld -> %ld\n"
+             "  |adaptive - fixed| max %.0f rms %.1f, |plot - truth| max fixed %.0f adaptive %.0f (0.01 degC)\n",
+             argv[iArg], lFixed, lAdaptive, (100.0 * lAdaptive / lFixed) - 100.0, lFixed * SIM_BYTES_PER_SAMPLE,
+             lAdaptive * SIM_BYTES_PER_SAMPLE, dMaxDelta, sqrt(dSumSquare / klSteps), dMaxFixed, dMaxAdapt);
+
+      free(pdFixed);
+      free(pdAdaptive);
+      free(strTrace.pdTimeMs);
+      free(strTrace.pdValue);
+    }
+  }
+
+  return iResult;
+}
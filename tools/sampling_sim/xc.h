@@ -0,0 +1,7 @@
+/* Host stand-in of the XC8 <xc.h>, for the modules of src/ compiled by sampling_sim.c */
+#ifndef XC_H_
+#define XC_H_
+
+#define __debug_break()                                     ((void)0)
+
+#endif /* XC_H_ */